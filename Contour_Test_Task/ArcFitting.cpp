@@ -0,0 +1,328 @@
+/**
+ * @file ArcFitting.cpp
+ * @brief Implements curvature-interval arc fitting.
+ */
+#include "ArcFitting.h"
+#include "LineSegment2D.h"
+#include "ArcSegment2D.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+	/**
+	 * @brief Start point and unit start tangent of the primitive being fitted.
+	 */
+	struct Frame {
+		double sx, sy;
+		double tx, ty;
+	};
+
+	/**
+	 * @brief Points covered by one primitive and the curvature chosen for it.
+	 */
+	struct Fit {
+		std::size_t last;		// index of the last covered point
+		double kappa;			// signed curvature, positive turning left
+		bool exactEnd;			// the primitive passes exactly through points[last]
+		std::size_t reach;		// last point any curvature could cover from this start
+	};
+
+	// Data turning faster than this at the end of a primitive is kept as a corner
+	const double cornerAngle = M_PI / 6;
+
+	/**
+	 * @brief Curvatures of the circles through the start, tangent there, that pass within
+	 * tolerance of a point at offset (dx, dy).
+	 *
+	 * A circle of curvature k through S with tangent T passes through Q when
+	 * k = 2 cross(T, Q - S) / |Q - S|^2. The circles touching the disc of radius tol around
+	 * Q bound the interval, and solving |Q - C| = R +- tol gives its ends exactly.
+	 */
+	void curvatureBounds(const Frame& f, double dx, double dy, double tolerance, double& lo, double& hi) {
+		const double h = f.tx * dy - f.ty * dx;
+		const double denominator = dx * dx + dy * dy - tolerance * tolerance;
+		lo = 2 * (h - tolerance) / denominator;
+		hi = 2 * (h + tolerance) / denominator;
+	}
+
+	double squaredDistance(const MyPoint& a, const MyPoint& b) {
+		const double dx = a.getX() - b.getX();
+		const double dy = a.getY() - b.getY();
+		return dx * dx + dy * dy;
+	}
+
+	/**
+	 * @brief Finds the nearest points before and after points[j] lying farther than the tolerance.
+	 */
+	void neighbours(const std::vector<MyPoint>& points, std::size_t first, std::size_t j, double tolerance,
+		std::size_t& before, std::size_t& after) {
+
+		const double toleranceSq = tolerance * tolerance;
+		before = j;
+		while (before > first && squaredDistance(points[before], points[j]) <= toleranceSq) {
+			--before;
+		}
+		after = j;
+		while (after + 1 < points.size() && squaredDistance(points[after], points[j]) <= toleranceSq) {
+			++after;
+		}
+	}
+
+	/**
+	 * @brief Curvature whose end tangent at points[last] follows the data there.
+	 *
+	 * The data direction is the chord between the neighbours of points[last]. An arc of
+	 * chord length c turns by 2 asin(k c / 2), which is solved for k. Following the data
+	 * keeps tangent errors from building up from one primitive to the next.
+	 */
+	double tangentCurvature(const std::vector<MyPoint>& points, std::size_t first, std::size_t last, const Frame& f, double tolerance) {
+		std::size_t before, after;
+		neighbours(points, first, last, tolerance, before, after);
+		double dx = points[after].getX() - points[before].getX();
+		double dy = points[after].getY() - points[before].getY();
+		if (before == after) {
+			dx = f.tx;
+			dy = f.ty;
+		}
+		const double turn = std::atan2(f.tx * dy - f.ty * dx, f.tx * dx + f.ty * dy);
+		const double cx = points[last].getX() - f.sx;
+		const double cy = points[last].getY() - f.sy;
+		return 2 * std::sin(0.5 * turn) / std::sqrt(cx * cx + cy * cy);
+	}
+
+	/**
+	 * @brief Tells whether the data turns sharply at points[j].
+	 */
+	bool isCorner(const std::vector<MyPoint>& points, std::size_t first, std::size_t j, double tolerance) {
+		std::size_t before, after;
+		neighbours(points, first, j, tolerance, before, after);
+		if (before == j || after == j) {
+			return false;
+		}
+		const double inX = points[j].getX() - points[before].getX();
+		const double inY = points[j].getY() - points[before].getY();
+		const double outX = points[after].getX() - points[j].getX();
+		const double outY = points[after].getY() - points[j].getY();
+		return std::abs(std::atan2(inX * outY - inY * outX, inX * outX + inY * outY)) > cornerAngle;
+	}
+
+	Fit grow(const std::vector<MyPoint>& points, std::size_t first, const Frame& f, double tolerance) {
+		const double toleranceSq = tolerance * tolerance;
+		double lo = -std::numeric_limits<double>::infinity();
+		double hi = std::numeric_limits<double>::infinity();
+		double previousSq = 0;
+		// Longest feasible primitive, and longest one that also ends along the data
+		Fit longest = { first, 0.0, false, first };
+		Fit matched = { first, 0.0, false, first };
+		for (std::size_t j = first + 1; j < points.size(); ++j) {
+			const double dx = points[j].getX() - f.sx;
+			const double dy = points[j].getY() - f.sy;
+			const double lengthSq = dx * dx + dy * dy;
+			if (lengthSq <= toleranceSq) {
+				// Every circle through the start passes within tolerance
+				longest.last = j;
+				continue;
+			}
+			if (dx * f.tx + dy * f.ty <= 0 || lengthSq <= previousSq) {
+				break;
+			}
+			double pointLo, pointHi;
+			curvatureBounds(f, dx, dy, tolerance, pointLo, pointHi);
+			if (std::max(lo, pointLo) > std::min(hi, pointHi)) {
+				break;
+			}
+			lo = std::max(lo, pointLo);
+			hi = std::min(hi, pointHi);
+			previousSq = lengthSq;
+			longest.last = j;
+
+			if (j + 1 == points.size()) {
+				// The final point is hit exactly when the curvature through it stays feasible
+				const double exact = 2 * (f.tx * dy - f.ty * dx) / lengthSq;
+				if (exact >= lo && exact <= hi) {
+					return Fit{ j, exact, true, j };
+				}
+				break;
+			}
+			const double kappa = tangentCurvature(points, first, j, f, tolerance);
+			if (kappa >= lo && kappa <= hi) {
+				matched.last = j;
+				matched.kappa = lo <= 0 && hi >= 0 ? 0.0 : kappa;
+			}
+		}
+		matched.reach = longest.last;
+		if (matched.last > first && !isCorner(points, first, longest.last, tolerance)) {
+			return matched;
+		}
+		longest.reach = longest.last;
+		if (lo <= 0 && hi >= 0) {
+			longest.kappa = 0;
+		}
+		else if (longest.last > first) {
+			longest.kappa = std::min(hi, std::max(lo, tangentCurvature(points, first, longest.last, f, tolerance)));
+		}
+		if (longest.last + 1 == points.size()) {
+			if (previousSq == 0) {
+				// Only points within tolerance of the start remain
+				longest.exactEnd = true;
+			}
+			else if (longest.last > first + 1) {
+				// Stop one point short; the next primitive reaches the end alone
+				--longest.last;
+			}
+		}
+		return longest;
+	}
+
+	/**
+	 * @brief Estimates a start tangent from the circle through the start and the next two
+	 * points lying farther than the tolerance.
+	 */
+	void estimateTangent(const std::vector<MyPoint>& points, std::size_t first, double tolerance, Frame& f) {
+		const double toleranceSq = tolerance * tolerance;
+		auto farFrom = [&](std::size_t from, double x, double y) {
+			std::size_t j = from;
+			while (j + 1 < points.size()) {
+				++j;
+				const double dx = points[j].getX() - x;
+				const double dy = points[j].getY() - y;
+				if (dx * dx + dy * dy > toleranceSq) {
+					return j;
+				}
+			}
+			return points.size();
+		};
+		std::size_t a = farFrom(first, f.sx, f.sy);
+		if (a == points.size()) {
+			a = points.size() - 1;
+		}
+		const double ax = points[a].getX() - f.sx;
+		const double ay = points[a].getY() - f.sy;
+		double tx = ax;
+		double ty = ay;
+		const std::size_t b = farFrom(a, points[a].getX(), points[a].getY());
+		if (b != points.size()) {
+			const double bx = points[b].getX() - f.sx;
+			const double by = points[b].getY() - f.sy;
+			const double cross = ax * by - ay * bx;
+			const double aSq = ax * ax + ay * ay;
+			const double bSq = bx * bx + by * by;
+			if (std::abs(cross) > 1e-12 * aSq * bSq && aSq > 0) {
+				// Circumcenter relative to the start; the tangent is perpendicular to it
+				const double cx = (by * aSq - ay * bSq) / (2 * cross);
+				const double cy = (ax * bSq - bx * aSq) / (2 * cross);
+				tx = cross > 0 ? -cy : cy;
+				ty = cross > 0 ? cx : -cx;
+				if (tx * ax + ty * ay <= 0) {
+					tx = ax;
+					ty = ay;
+				}
+			}
+		}
+		const double length = std::sqrt(tx * tx + ty * ty);
+		if (length > 0) {
+			f.tx = tx / length;
+			f.ty = ty / length;
+		}
+		else {
+			f.tx = 1;
+			f.ty = 0;
+		}
+	}
+
+	/**
+	 * @brief Appends the primitive described by a fit and moves the frame to its end.
+	 */
+	void emit(Contour2D& result, Frame& f, const Fit& fit, const MyPoint& target) {
+		const MyPoint start(f.sx, f.sy);
+		if (fit.kappa == 0) {
+			MyPoint end = target;
+			if (!fit.exactEnd) {
+				const double along = (target.getX() - f.sx) * f.tx + (target.getY() - f.sy) * f.ty;
+				end = MyPoint(f.sx + along * f.tx, f.sy + along * f.ty);
+			}
+			const double length = start.distanceTo_2D(end);
+			if (length > Contour2D::defaultEpsilon) {
+				result.addSegment(std::make_unique<LineSegment2D>(start, end));
+				f.tx = (end.getX() - f.sx) / length;
+				f.ty = (end.getY() - f.sy) / length;
+				f.sx = end.getX();
+				f.sy = end.getY();
+			}
+			return;
+		}
+		const double r = 1 / std::abs(fit.kappa);
+		const double cx = f.sx - f.ty / fit.kappa;
+		const double cy = f.sy + f.tx / fit.kappa;
+		MyPoint end = target;
+		if (!fit.exactEnd) {
+			const double dx = target.getX() - cx;
+			const double dy = target.getY() - cy;
+			const double length = std::sqrt(dx * dx + dy * dy);
+			end = MyPoint(cx + r * dx / length, cy + r * dy / length);
+		}
+		if (start.distanceTo_2D(end) <= Contour2D::defaultEpsilon) {
+			return;
+		}
+		const bool counterClockwise = fit.kappa > 0;
+		const double startAngle = std::atan2(f.sy - cy, f.sx - cx);
+		const double endAngle = std::atan2(end.getY() - cy, end.getX() - cx);
+		// Sweeps stay below half a turn, so the center is on the inner side of the chord
+		result.addSegment(std::make_unique<ArcSegment2D>(start, end, MyPoint(cx, cy), r, startAngle, endAngle,
+			counterClockwise, counterClockwise));
+		const double ux = (end.getX() - cx) / r;
+		const double uy = (end.getY() - cy) / r;
+		f.sx = end.getX();
+		f.sy = end.getY();
+		f.tx = counterClockwise ? -uy : uy;
+		f.ty = counterClockwise ? ux : -ux;
+	}
+
+}
+
+Contour2D fitArcs(const std::vector<MyPoint>& points, double tolerance, bool closed) {
+	if (!(tolerance > 0)) {
+		throw std::invalid_argument("Tolerance must be positive in fitArcs()");
+	}
+	Contour2D result;
+	if (points.size() < 2) {
+		return result;
+	}
+	// A closed input is fitted as an open one that returns to its start
+	std::vector<MyPoint> closedCopy;
+	if (closed) {
+		closedCopy.reserve(points.size() + 1);
+		closedCopy.assign(points.begin(), points.end());
+		closedCopy.push_back(points.front());
+	}
+	const std::vector<MyPoint>& path = closed ? closedCopy : points;
+
+	Frame frame = { path[0].getX(), path[0].getY(), 1.0, 0.0 };
+	estimateTangent(path, 0, tolerance, frame);
+	std::size_t current = 0;
+	while (current + 1 < path.size()) {
+		Fit fit = grow(path, current, frame, tolerance);
+		if (current > 0 && current + 2 < path.size() && (fit.reach == current || isCorner(path, 0, current, tolerance))) {
+			// The incoming tangent does not fit a sharp turn of the data: try a corner instead
+			Frame fresh = frame;
+			estimateTangent(path, current, tolerance, fresh);
+			const Fit corner = grow(path, current, fresh, tolerance);
+			if (corner.reach > fit.reach) {
+				frame = fresh;
+				fit = corner;
+			}
+		}
+		if (fit.last == current) {
+			// Not even the next point fits, e.g. a reversal: join it with a straight line
+			fit.last = current + 1;
+			fit.kappa = 0;
+			fit.exactEnd = true;
+		}
+		emit(result, frame, fit, path[fit.last]);
+		current = fit.last;
+	}
+	return result;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file ArcFitting.h
+ * @brief Compression of dense point sequences into tangent-continuous line/arc contours.
+ */
+#pragma once
+#include <vector>
+#include "Contour2D.h"
+
+/**
+* @brief Fits lines and arcs to a dense polyline within a distance tolerance.
+*
+* The points are consumed in one forward pass. Each primitive starts where the previous
+* one ended, with the previous end tangent, so the circles it may follow form a
+* one-parameter family of curvatures. A point restricts the curvature to the interval of
+* circles passing within tolerance of it, so the feasible curvatures are an interval
+* intersection updated in O(1) per point. A primitive ends at the last point where a
+* feasible curvature also leaves it heading along the data; this keeps tangent errors from
+* piling up, so the next primitive has room to follow. Lines are emitted wherever zero
+* curvature is feasible, and arcs stay below half a turn.
+*
+* Where the data turns by more than 30 degrees between neighbouring points, the fitter
+* restarts with a tangent estimated from the next points and leaves a corner. Only points
+* past the chosen end of a primitive are scanned again, so the fit is linear in practice.
+*
+* Every input point lies within tolerance of the result, measured in the XY plane; Z is
+* ignored. The result starts exactly at the first point and ends exactly at the last one,
+* or, for a closed input, back at the first one; the closing joint is the only one whose
+* tangents may differ on a smooth input.
+*
+* @param points Dense polyline vertices, as accepted by polylineContourFromPoints().
+* @param tolerance Largest allowed distance of an input point from the result.
+* @param closed True if the last point connects back to the first.
+* @return Contour of LineSegment2D and ArcSegment2D; empty for fewer than two points.
+* @throws std::invalid_argument If tolerance is not positive.
+*/
+Contour2D fitArcs(const std::vector<MyPoint>& points, double tolerance, bool closed = false);
@@ -18,6 +18,10 @@
   * Stores geometric data such as center, radius, orientation, and start/end angles.
   * Can be created from endpoints or directly via polar form. Supports movement,
   * recalculation, and conversion from polar to Cartesian coordinates.
+  * A new arc runs counter-clockwise around its center from the start angle to the end
+  * angle; reverse() makes it run clockwise from its old end back to its old start.
+  * Its overrides are final so that calls through an ArcSegment2D reference are devirtualized;
+  * the class itself stays open only for SegmentArena's ArenaSegment wrapper.
   */
 class ArcSegment2D : public Segment2D {
 private:
@@ -26,6 +30,7 @@ private:
 	double endAngle;
 	double length_;
 	bool clockwise;
+	bool counterClockwise = true;
 	MyPoint center;
 	MyPoint pointA;
 	MyPoint pointB;
@@ -36,9 +41,13 @@ public:
 	* @brief Creates a copy of this arc segment.
 	* @return A unique_ptr to the cloned ArcSegment2D.
 	*/
-	std::unique_ptr<Segment2D> clone() const override {
+	std::unique_ptr<Segment2D> clone() const final {
 		return std::make_unique<ArcSegment2D>(*this);
 	}
+	/**
+	* @brief Returns SegmentKind::Arc.
+	*/
+	SegmentKind getKind() const final { return SegmentKind::Arc; }
 
 	/**
 	* @brief Constructs an arc from two endpoints and a radius.
@@ -57,6 +66,10 @@ public:
 	/**
 	* @brief Constructs an arc from center, radius, and angle parameters.
 	*
+	* The arc runs counter-clockwise from startAng to endAng. isClockwise() is set to the
+	* value the endpoint constructor would need to rebuild the same center, i.e. true when
+	* the sweep is less than half a circle.
+	*
 	* @param c Center of the arc.
 	* @param r Radius.
 	* @param startAng Start angle in radians.
@@ -70,10 +83,35 @@ public:
 		length();
 		double angleSweep = endAngle - startAngle;
 		if (angleSweep < 0) { angleSweep += 2 * M_PI; }
-		clockwise = angleSweep > M_PI;
+		// The center lies left of the chord exactly when the counter-clockwise sweep is the
+		// minor arc; calculateFromEndpoints() relies on this flag after move()
+		clockwise = angleSweep < M_PI;
 
 	}
 
+	/**
+	* @brief Constructs an arc from a fully resolved state without recomputing it.
+	*
+	* Used to restore arcs exactly from flattened storage; the caller is responsible
+	* for passing a consistent set of values.
+	*
+	* @param start Starting point of the arc.
+	* @param end Ending point of the arc.
+	* @param c Center of the arc.
+	* @param r Radius.
+	* @param startAng Start angle in radians.
+	* @param endAng End angle in radians.
+	* @param clockwise_ Direction flag as stored by the original arc.
+	* @param counterClockwise_ Traversal direction as stored by the original arc.
+	*/
+	ArcSegment2D(const MyPoint& start, const MyPoint& end, const MyPoint& c, double r, double startAng, double endAng, bool clockwise_,
+		bool counterClockwise_ = true)
+		: radius(r), startAngle(startAng), endAngle(endAng), clockwise(clockwise_), counterClockwise(counterClockwise_),
+		center(c), pointA(start), pointB(end)
+	{
+		length();
+	}
+
 	/**
 	 * @brief Recalculates center and angles based on endpoints and radius.
 	 *
@@ -116,15 +154,57 @@ public:
 		length();
 	}
 
-	const MyPoint& getPointA() const override { return pointA; }
-	const MyPoint& getPointB() const override { return pointB; }
+	const MyPoint& getPointA() const final { return pointA; }
+	const MyPoint& getPointB() const final { return pointB; }
+
+	/**
+	* @brief Returns the center of the arc.
+	* @return Const reference to the center point.
+	*/
+	const MyPoint& getCenter() const { return center; }
+	/**
+	* @brief Returns the radius of the arc.
+	* @return Radius.
+	*/
+	double getRadius() const { return radius; }
+	/**
+	* @brief Returns the start angle of the arc.
+	* @return Angle of point A around the center, in radians.
+	*/
+	double getStartAngle() const { return startAngle; }
+	/**
+	* @brief Returns the end angle of the arc.
+	* @return Angle of point B around the center, in radians.
+	*/
+	double getEndAngle() const { return endAngle; }
 
 	/**
 	* @brief Returns whether the arc is clockwise.
+	*
+	* This is the flag given to the endpoint constructor, which selects the side of the
+	* chord the center lies on; see isCounterClockwise() for the direction of travel.
+	*
 	* @return True if clockwise, false if counter-clockwise.
 	*/
 	bool isClockwise() const { return clockwise; }
 	/**
+	* @brief Returns the direction in which the arc is traversed from point A to point B.
+	* @return True if counter-clockwise around the center, false after reverse().
+	*/
+	bool isCounterClockwise() const { return counterClockwise; }
+	/**
+	* @brief Reverses the arc so that it runs from point B to point A over the same points.
+	*
+	* Swaps the endpoints and angles and flips the traversal direction. The center-side
+	* flag is flipped too, so move() keeps the same center.
+	*/
+	void reverse() final {
+		std::swap(pointA, pointB);
+		std::swap(startAngle, endAngle);
+		clockwise = !clockwise;
+		counterClockwise = !counterClockwise;
+	}
+	/**
 	* @brief Converts polar coordinates to Cartesian coordinates.
 	* @param c Arc center.
 	* @param r Radius.
@@ -142,7 +222,7 @@ public:
 	* @param dx Offset in X.
 	* @param dy Offset in Y.
 	*/
-	void move(double dx, double dy) override {
+	void move(double dx, double dy) final {
 
 		pointA.setX(pointA.getX() + dx);
 		pointA.setY(pointA.getY() + dy);
@@ -153,13 +233,8 @@ public:
 	/**
 	* @brief Calculates the arc length based on radius and angle span.
 	*/
-	void length() override {
-
-		double arc_ = endAngle - startAngle;
-		if (arc_ < 0) {
-			arc_ += 2 * M_PI;
-		}
-		length_ = radius * arc_;
+	void length() final {
+		length_ = radius * getSweepAngle();
 	}
 	/**
 	 * @brief Checks whether the arc has a non-zero length above a threshold.
@@ -167,5 +242,163 @@ public:
 	 * @return True if arc length exceeds epsilon.
 	 */
 	bool isNonZeroLength(double epsilon) const { return (length_ > epsilon); }
+	/**
+	* @brief Returns the angle swept from the start angle to the end angle.
+	* @return Unsigned sweep in [0, 2*PI), measured in the direction of travel.
+	*/
+	double getSweepAngle() const {
+		double sweep = counterClockwise ? endAngle - startAngle : startAngle - endAngle;
+		if (sweep < 0) {
+			sweep += 2 * M_PI;
+		}
+		return sweep;
+	}
+	/**
+	* @brief Returns the stored arc length.
+	* @return Radius times sweep angle.
+	*/
+	double getLength() const final { return length_; }
+	/**
+	* @brief Returns the exact bounding box of the arc.
+	*
+	* Besides the endpoints, includes every axis-extreme point of the circle
+	* (at 0, PI/2, PI and 3*PI/2) that the sweep passes through.
+	*
+	* @return Bounding box of the arc.
+	*/
+	BoundingBox2D getBoundingBox() const final {
+		return boundingBoxOf(pointA, pointB, center, radius, counterClockwise ? startAngle : endAngle, getSweepAngle());
+	}
+	/**
+	* @brief Computes the exact bounding box of an arc from its parameters.
+	* @param a One endpoint.
+	* @param b The other endpoint.
+	* @param c Center.
+	* @param r Radius.
+	* @param ccwStart Angle at which the counter-clockwise sweep starts.
+	* @param sweep Sweep angle in [0, 2*PI).
+	* @return Bounding box of the arc.
+	*/
+	static BoundingBox2D boundingBoxOf(const MyPoint& a, const MyPoint& b, const MyPoint& c, double r, double ccwStart, double sweep) {
+		BoundingBox2D box(a, b);
+		for (int quadrant = 0; quadrant < 4; ++quadrant) {
+			double offset = quadrant * M_PI_2 - ccwStart;
+			offset -= 2 * M_PI * std::floor(offset / (2 * M_PI));
+			if (offset <= sweep) {
+				box.expand(polarToCartesian(c, r, quadrant * M_PI_2));
+			}
+		}
+		return box;
+	}
+	/**
+	* @brief Returns the signed area term of the arc.
+	*
+	* The chord's shoelace term plus the circular segment between chord and arc,
+	* r^2 / 2 * (theta - sin(theta)) for sweep theta, negated for clockwise travel.
+	*
+	* @return Signed area term.
+	*/
+	double getSignedAreaTerm() const final {
+		const double sweep = getSweepAngle();
+		const double chord = 0.5 * (pointA.getX() * pointB.getY() - pointB.getX() * pointA.getY());
+		const double segment = 0.5 * radius * radius * (sweep - std::sin(sweep));
+		return counterClockwise ? chord + segment : chord - segment;
+	}
+	/**
+	* @brief Returns the point reached after travelling a distance along the arc.
+	* @param distance Distance from point A.
+	* @return Point on the arc.
+	*/
+	MyPoint pointAtLength(double distance) const final {
+		const double turn = distance / radius;
+		return polarToCartesian(center, radius, counterClockwise ? startAngle + turn : startAngle - turn);
+	}
+	/**
+	* @brief Returns the direction of travel along the arc.
+	* @param distance Distance from point A.
+	* @return Unit tangent, perpendicular to the radius.
+	*/
+	MyPoint tangentAtLength(double distance) const final {
+		const double turn = distance / radius;
+		if (counterClockwise) {
+			const double angle = startAngle + turn;
+			return MyPoint(-std::sin(angle), std::cos(angle));
+		}
+		const double angle = startAngle - turn;
+		return MyPoint(std::sin(angle), -std::cos(angle));
+	}
+	/**
+	* @brief Returns the point of the arc nearest to a given point.
+	* @param p Query point.
+	* @return Nearest point on the arc.
+	*/
+	MyPoint closestPoint(const MyPoint& p) const final {
+		return closestPointOf(pointA, pointB, center, radius, counterClockwise ? startAngle : endAngle, getSweepAngle(), p);
+	}
+	/**
+	* @brief Returns how far along the arc the direction towards a point lies.
+	* @param p Query point; only its direction from the center matters.
+	* @return Distance from point A, clamped to the arc length.
+	*/
+	double lengthAtPoint(const MyPoint& p) const final {
+		const double angle = std::atan2(p.getY() - center.getY(), p.getX() - center.getX());
+		double turn = counterClockwise ? angle - startAngle : startAngle - angle;
+		turn -= 2 * M_PI * std::floor(turn / (2 * M_PI));
+		const double sweep = getSweepAngle();
+		if (turn > sweep) {
+			// Past the end: snap to whichever end is angularly closer
+			turn = turn - sweep < 2 * M_PI - turn ? sweep : 0.0;
+		}
+		return radius * turn;
+	}
+	/**
+	* @brief Creates the part of the arc between two of its points.
+	*
+	* Keeps the center, radius and direction of travel; the endpoints are taken as given.
+	*
+	* @param from Start point.
+	* @param to End point.
+	* @return New ArcSegment2D.
+	*/
+	std::unique_ptr<Segment2D> subSegment(const MyPoint& from, const MyPoint& to) const final {
+		const double start = std::atan2(from.getY() - center.getY(), from.getX() - center.getX());
+		const double end = std::atan2(to.getY() - center.getY(), to.getX() - center.getX());
+		double sweep = counterClockwise ? end - start : start - end;
+		if (sweep < 0) {
+			sweep += 2 * M_PI;
+		}
+		// Center-side flag as the polar constructor and reverse() would leave it
+		const bool centerLeft = counterClockwise ? sweep < M_PI : sweep >= M_PI;
+		return std::make_unique<ArcSegment2D>(from, to, center, radius, start, end, centerLeft, counterClockwise);
+	}
+	/**
+	* @brief Computes the point of an arc nearest to p from the arc's parameters.
+	*
+	* If the direction from the center towards p falls inside the sweep, the answer is the
+	* circle point in that direction; otherwise it is the nearer endpoint.
+	*
+	* @param a One endpoint.
+	* @param b The other endpoint.
+	* @param c Center.
+	* @param r Radius.
+	* @param ccwStart Angle at which the counter-clockwise sweep starts.
+	* @param sweep Sweep angle in [0, 2*PI).
+	* @param p Query point.
+	* @return Nearest point on the arc; a if p is the center.
+	*/
+	static MyPoint closestPointOf(const MyPoint& a, const MyPoint& b, const MyPoint& c, double r, double ccwStart, double sweep, const MyPoint& p) {
+		const double dx = p.getX() - c.getX();
+		const double dy = p.getY() - c.getY();
+		if (dx == 0 && dy == 0) {
+			return a;
+		}
+		double offset = std::atan2(dy, dx) - ccwStart;
+		offset -= 2 * M_PI * std::floor(offset / (2 * M_PI));
+		if (offset <= sweep) {
+			const double scale = r / std::sqrt(dx * dx + dy * dy);
+			return MyPoint(c.getX() + dx * scale, c.getY() + dy * scale);
+		}
+		return p.distanceTo_2D(a) <= p.distanceTo_2D(b) ? a : b;
+	}
 };
 
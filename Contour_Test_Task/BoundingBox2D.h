@@ -0,0 +1,160 @@
+/**
+ * @file BoundingBox2D.h
+ * @brief Defines an axis-aligned 2D bounding box.
+ */
+#pragma once
+#include <limits>
+#include <algorithm>
+#include "MyPoint.h"
+
+ /**
+  * @class BoundingBox2D
+  * @brief Axis-aligned box in the XY plane, possibly empty.
+  *
+  * A default-constructed box is empty: expanding it by a point gives a box of that point.
+  */
+class BoundingBox2D {
+private:
+	double minX = std::numeric_limits<double>::infinity();
+	double minY = std::numeric_limits<double>::infinity();
+	double maxX = -std::numeric_limits<double>::infinity();
+	double maxY = -std::numeric_limits<double>::infinity();
+
+public:
+	/**
+	* @brief Constructs an empty box.
+	*/
+	BoundingBox2D() = default;
+	/**
+	* @brief Constructs a box from its extents.
+	* @param minX_ Smallest X.
+	* @param minY_ Smallest Y.
+	* @param maxX_ Largest X.
+	* @param maxY_ Largest Y.
+	*/
+	BoundingBox2D(double minX_, double minY_, double maxX_, double maxY_)
+		: minX(minX_), minY(minY_), maxX(maxX_), maxY(maxY_) {}
+	/**
+	* @brief Constructs the smallest box containing two points.
+	* @param a First point.
+	* @param b Second point.
+	*/
+	BoundingBox2D(const MyPoint& a, const MyPoint& b) {
+		expand(a);
+		expand(b);
+	}
+
+	/**
+	* @brief Tells whether the box contains no point at all.
+	* @return True if empty.
+	*/
+	bool isEmpty() const { return minX > maxX || minY > maxY; }
+	double getMinX() const { return minX; }	///< @return Smallest X.
+	double getMinY() const { return minY; }	///< @return Smallest Y.
+	double getMaxX() const { return maxX; }	///< @return Largest X.
+	double getMaxY() const { return maxY; }	///< @return Largest Y.
+	/**
+	* @brief Returns the extent along X.
+	* @return Width, or a negative value for an empty box.
+	*/
+	double getWidth() const { return maxX - minX; }
+	/**
+	* @brief Returns the extent along Y.
+	* @return Height, or a negative value for an empty box.
+	*/
+	double getHeight() const { return maxY - minY; }
+
+	/**
+	* @brief Grows the box to include a point.
+	* @param p Point to include.
+	*/
+	void expand(const MyPoint& p) {
+		expand(p.getX(), p.getY());
+	}
+	/**
+	* @brief Grows the box to include a point given by coordinates.
+	* @param x X coordinate.
+	* @param y Y coordinate.
+	*/
+	void expand(double x, double y) {
+		minX = x < minX ? x : minX;
+		minY = y < minY ? y : minY;
+		maxX = x > maxX ? x : maxX;
+		maxY = y > maxY ? y : maxY;
+	}
+	/**
+	* @brief Grows the box to include another box.
+	* @param other Box to include; empty boxes leave this one unchanged.
+	*/
+	void expand(const BoundingBox2D& other) {
+		minX = other.minX < minX ? other.minX : minX;
+		minY = other.minY < minY ? other.minY : minY;
+		maxX = other.maxX > maxX ? other.maxX : maxX;
+		maxY = other.maxY > maxY ? other.maxY : maxY;
+	}
+	/**
+	* @brief Translates the box.
+	* @param dx Offset along X.
+	* @param dy Offset along Y.
+	*/
+	void move(double dx, double dy) {
+		minX += dx;
+		maxX += dx;
+		minY += dy;
+		maxY += dy;
+	}
+	/**
+	* @brief Tells whether two boxes overlap; touching boxes count as overlapping.
+	* @param other Box to test against.
+	* @return True if the boxes share at least one point.
+	*/
+	bool intersects(const BoundingBox2D& other) const {
+		return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+	}
+	/**
+	* @brief Tells whether a point lies inside or on the box.
+	* @param p Point to test; Z is ignored.
+	* @return True if contained.
+	*/
+	bool contains(const MyPoint& p) const {
+		return p.getX() >= minX && p.getX() <= maxX && p.getY() >= minY && p.getY() <= maxY;
+	}
+	/**
+	* @brief Tells whether another box lies entirely inside this one.
+	* @param other Box to test.
+	* @return True if contained; an empty box is contained in any box.
+	*/
+	bool contains(const BoundingBox2D& other) const {
+		return other.isEmpty() || (other.minX >= minX && other.maxX <= maxX && other.minY >= minY && other.maxY <= maxY);
+	}
+	/**
+	* @brief Returns the box grown by a margin on every side.
+	* @param margin Distance to grow by.
+	* @return Inflated box.
+	*/
+	BoundingBox2D inflated(double margin) const {
+		return BoundingBox2D(minX - margin, minY - margin, maxX + margin, maxY + margin);
+	}
+	/**
+	* @brief Returns the squared distance from a point to the nearest point of the box.
+	* @param x X coordinate of the point.
+	* @param y Y coordinate of the point.
+	* @return 0 for points inside the box; infinity for an empty box.
+	*/
+	double squaredDistanceTo(double x, double y) const {
+		const double dx = std::max(std::max(minX - x, x - maxX), 0.0);
+		const double dy = std::max(std::max(minY - y, y - maxY), 0.0);
+		return dx * dx + dy * dy;
+	}
+	/**
+	* @brief Tells whether other touches the boundary of this box.
+	*
+	* Used to decide whether removing the content described by other may shrink this box.
+	*
+	* @param other Box lying inside this one.
+	* @return True if other reaches any side of this box.
+	*/
+	bool touchesBoundary(const BoundingBox2D& other) const {
+		return other.minX <= minX || other.minY <= minY || other.maxX >= maxX || other.maxY >= maxY;
+	}
+};
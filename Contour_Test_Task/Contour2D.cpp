@@ -3,91 +3,556 @@
  * @brief Implements the Contour2D class methods, including copy/move logic, validation, and geometry manipulation.
  */
 #include "Contour2D.h"
+#include <atomic>
+#include <algorithm>
 
-Contour2D::Contour2D(const Contour2D& other) {
-	for (const auto& seg : other.segments) {
-		segments.push_back(seg->clone());
-	}
-	cacheValidity = false;
+Contour2D::Contour2D(const Contour2D& other)
+	: segments(other.shareable ? other.segments : copyStore(other.readSegments())),
+	brokenJoints(other.brokenJoints), lengthCache(other.lengthCache),
+	boundsCache(other.boundsCache), areaTermCache(other.areaTermCache), lengthIndex(other.lengthIndex),
+	segmentBounds(other.segmentBounds) {
 }
 
 Contour2D& Contour2D::operator=(const Contour2D& other) {
 	if (this != &other) {
-		segments.clear();
-		for (const auto& seg : other.segments) {
-			segments.push_back(seg->clone());
-		}
+		segments = other.shareable ? other.segments : copyStore(other.readSegments());
+		shareable = true;
+		brokenJoints = other.brokenJoints;
+		lengthCache = other.lengthCache;
+		boundsCache = other.boundsCache;
+		areaTermCache = other.areaTermCache;
+		lengthIndex = other.lengthIndex;
+		segmentBounds = other.segmentBounds;
+	}
+	return *this;
+}
+
+/**
+ * @brief Copies a chunk list for a contour that has handed out mutable segment references.
+ *
+ * Exposed chunks are cloned; every other chunk is shared with the source.
+ *
+ * @param source Chunk list to copy.
+ * @return New chunk list.
+ */
+Contour2D::Contour2D(Contour2D&& other) noexcept
+	: segments(std::move(other.segments)), shareable(other.shareable),
+	brokenJoints(other.brokenJoints), lengthCache(other.lengthCache),
+	boundsCache(other.boundsCache), areaTermCache(other.areaTermCache), lengthIndex(other.lengthIndex),
+	segmentBounds(other.segmentBounds) {
+	other.resetToEmpty();
+}
+
+Contour2D& Contour2D::operator=(Contour2D&& other) noexcept {
+	if (this != &other) {
+		segments = std::move(other.segments);
+		shareable = other.shareable;
+		brokenJoints = other.brokenJoints;
+		lengthCache = other.lengthCache;
+		boundsCache = other.boundsCache;
+		areaTermCache = other.areaTermCache;
+		lengthIndex = other.lengthIndex;
+		segmentBounds = other.segmentBounds;
+		other.resetToEmpty();
 	}
 	return *this;
 }
 
+/**
+ * @brief Puts the contour into the state of a default-constructed one.
+ *
+ * The cached properties are updated incrementally by later edits, so a moved-from
+ * contour must start again from the known values of an empty contour.
+ */
+void Contour2D::resetToEmpty() noexcept {
+	segments.reset();
+	shareable = true;
+	brokenJoints = JointCounter();
+	lengthCache = LazyValue<double>(0.0);
+	boundsCache = LazyValue<BoundingBox2D>(BoundingBox2D());
+	areaTermCache = LazyValue<double>(0.0);
+	lengthIndex.reset();
+	segmentBounds.reset();
+}
+
+std::shared_ptr<Contour2D::SegmentStore> Contour2D::copyStore(const SegmentStore& source) {
+	auto copy = std::make_shared<SegmentStore>(source);
+	for (auto& chunk : copy->chunks) {
+		if (chunk->exposed) {
+			auto clone = std::make_shared<SegmentChunk>();
+			clone->segments.reserve(chunk->segments.size());
+			for (const auto& seg : chunk->segments) {
+				clone->segments.push_back(seg->clone());
+			}
+			chunk = std::move(clone);
+		}
+	}
+	return copy;
+}
+
+const Contour2D::SegmentStore& Contour2D::readSegments() const {
+	static const SegmentStore empty;
+	return segments ? *segments : empty;
+}
+
+/**
+ * @brief Returns a chunk list owned exclusively by this contour.
+ *
+ * Copies the list of chunk pointers if it is shared with another copy; the chunks
+ * themselves stay shared.
+ *
+ * @return Mutable reference to the chunk list.
+ */
+Contour2D::SegmentStore& Contour2D::writableStore() {
+	if (!segments) {
+		segments = std::make_shared<SegmentStore>();
+	}
+	else if (segments.use_count() > 1) {
+		segments = std::make_shared<SegmentStore>(*segments);
+	}
+	else {
+		// Pairs with the release in the last other owner's destructor before we write
+		std::atomic_thread_fence(std::memory_order_acquire);
+	}
+	return *segments;
+}
+
+/**
+ * @brief Returns a chunk owned exclusively by this contour.
+ *
+ * Clones the segments of that one chunk if it is shared with another copy.
+ *
+ * @param chunk Index of the chunk.
+ * @return Mutable reference to the chunk.
+ */
+Contour2D::SegmentChunk& Contour2D::writableChunk(std::size_t chunk) {
+	std::shared_ptr<SegmentChunk>& slot = writableStore().chunks[chunk];
+	if (slot.use_count() > 1) {
+		auto clone = std::make_shared<SegmentChunk>();
+		clone->segments.reserve(slot->segments.size());
+		for (const auto& seg : slot->segments) {
+			clone->segments.push_back(seg->clone());
+		}
+		slot = std::move(clone);
+	}
+	else {
+		std::atomic_thread_fence(std::memory_order_acquire);
+	}
+	return *slot;
+}
+
+/**
+ * @brief Finds the chunk holding a segment.
+ *
+ * Chunks filled by appending are full, so the chunk is usually index / chunkCapacity;
+ * otherwise it is found by binary search over the chunk starts.
+ *
+ * @param store Chunk list.
+ * @param index Segment index, less than store.count.
+ * @return Index of the chunk.
+ */
+std::size_t Contour2D::chunkOf(const SegmentStore& store, std::size_t index) {
+	const std::size_t guess = index / chunkCapacity;
+	if (guess < store.chunks.size() && store.starts[guess] <= index
+		&& index - store.starts[guess] < store.chunks[guess]->segments.size()) {
+		return guess;
+	}
+	return static_cast<std::size_t>(std::upper_bound(store.starts.begin(), store.starts.end(), index) - store.starts.begin()) - 1;
+}
+
+const Segment2D& Contour2D::segmentIn(const SegmentStore& store, std::size_t index) {
+	const std::size_t chunk = chunkOf(store, index);
+	return *store.chunks[chunk]->segments[index - store.starts[chunk]];
+}
+
+/**
+ * @brief Recomputes the chunk starts and segment count from a given chunk onwards.
+ * @param store Chunk list.
+ * @param firstChunk First chunk whose start may have changed.
+ */
+void Contour2D::updateStarts(SegmentStore& store, std::size_t firstChunk) {
+	store.starts.resize(store.chunks.size());
+	std::size_t next = firstChunk == 0 ? 0 : store.starts[firstChunk - 1] + store.chunks[firstChunk - 1]->segments.size();
+	for (std::size_t i = firstChunk; i < store.chunks.size(); ++i) {
+		store.starts[i] = next;
+		next += store.chunks[i]->segments.size();
+	}
+	store.count = next;
+}
+
+/**
+ * @brief Tells whether the joint between segment joint and segment joint + 1 is open.
+ * @param store Segments of the contour.
+ * @param joint Index of the joint's first segment.
+ * @return True if the endpoints are further apart than epsilon.
+ */
+bool Contour2D::isJointBroken(const SegmentStore& store, std::size_t joint) {
+	return segmentIn(store, joint).getPointB().distanceTo_2D(segmentIn(store, joint + 1).getPointA()) > defaultEpsilon;
+}
+
+bool Contour2D::sharesSegmentsWith(const Contour2D& other) const {
+	if (!segments || !other.segments) {
+		return false;
+	}
+	if (segments == other.segments) {
+		return true;
+	}
+	std::vector<const SegmentChunk*> mine;
+	mine.reserve(segments->chunks.size());
+	for (const auto& chunk : segments->chunks) {
+		mine.push_back(chunk.get());
+	}
+	std::sort(mine.begin(), mine.end());
+	for (const auto& chunk : other.segments->chunks) {
+		if (std::binary_search(mine.begin(), mine.end(), chunk.get())) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Applies an edit to the cached per-segment boxes, if they are known.
+ *
+ * The box array may still be referenced by copies of this contour or by callers of
+ * segmentBoundingBoxes(); it is copied first in that case, like the segments themselves.
+ *
+ * @param edit Callable taking std::vector<BoundingBox2D>&.
+ */
+template <class Edit>
+void Contour2D::editSegmentBounds(Edit edit) {
+	segmentBounds.update([&edit](std::shared_ptr<std::vector<BoundingBox2D>>& boxes) {
+		if (boxes.use_count() > 1) {
+			boxes = std::make_shared<std::vector<BoundingBox2D>>(*boxes);
+		}
+		else {
+			std::atomic_thread_fence(std::memory_order_acquire);
+		}
+		edit(*boxes);
+	});
+}
+
+/**
+ * @brief Brings the cached derived properties up to date after a segment was added.
+ * @param segment The new segment.
+ * @param position Index the segment was inserted at.
+ */
+void Contour2D::segmentAdded(const Segment2D& segment, std::size_t position) {
+	const double length = segment.getLength();
+	const double areaTerm = segment.getSignedAreaTerm();
+	lengthCache.update([length](double& total) { total += length; });
+	areaTermCache.update([areaTerm](double& total) { total += areaTerm; });
+	const BoundingBox2D box = segment.getBoundingBox();
+	boundsCache.update([&box](BoundingBox2D& bounds) { bounds.expand(box); });
+	editSegmentBounds([&box, position](std::vector<BoundingBox2D>& boxes) { boxes.insert(boxes.begin() + position, box); });
+	lengthIndex.invalidate();
+}
+
+/**
+ * @brief Brings the cached derived properties up to date before a segment is removed.
+ *
+ * The bounding box can only shrink if the segment reaches its boundary; in that case it
+ * is recomputed on the next query.
+ *
+ * @param segment The segment being removed.
+ * @param position Index of the segment being removed.
+ */
+void Contour2D::segmentRemoved(const Segment2D& segment, std::size_t position) {
+	const double length = segment.getLength();
+	const double areaTerm = segment.getSignedAreaTerm();
+	lengthCache.update([length](double& total) { total -= length; });
+	areaTermCache.update([areaTerm](double& total) { total -= areaTerm; });
+	bool shrinks = false;
+	const BoundingBox2D box = segment.getBoundingBox();
+	boundsCache.update([&](BoundingBox2D& bounds) { shrinks = bounds.touchesBoundary(box); });
+	if (shrinks) {
+		boundsCache.invalidate();
+	}
+	editSegmentBounds([position](std::vector<BoundingBox2D>& boxes) { boxes.erase(boxes.begin() + position); });
+	lengthIndex.invalidate();
+}
+
+void Contour2D::invalidateDerived() {
+	brokenJoints.invalidate();
+	lengthCache.invalidate();
+	boundsCache.invalidate();
+	areaTermCache.invalidate();
+	lengthIndex.invalidate();
+	segmentBounds.invalidate();
+}
+
 void Contour2D::addSegment(std::unique_ptr<Segment2D> segment) {
-	segments.push_back(std::move(segment));
-	cacheValidity = false;
+	segmentAdded(*segment, getSegmentCount());
+	SegmentStore& store = writableStore();
+	if (store.chunks.empty() || store.chunks.back()->segments.size() >= chunkCapacity) {
+		store.chunks.push_back(std::make_shared<SegmentChunk>());
+		store.starts.push_back(store.count);
+	}
+	writableChunk(store.chunks.size() - 1).segments.push_back(std::move(segment));
+	++store.count;
+	if (store.count > 1) {
+		brokenJoints.add(isJointBroken(store, store.count - 2));
+	}
 }
 void Contour2D::addSegment(const Segment2D& segment) {
-	segments.push_back(segment.clone());
-	cacheValidity = false;
+	addSegment(segment.clone());
 }
 
 void Contour2D::insertSegment(std::unique_ptr<Segment2D> segment, int position) {
-	if (position < 0 || position > static_cast<int>(segments.size())) {
+	if (position < 0 || position > static_cast<int>(getSegmentCount())) {
 		throw std::out_of_range("Invalid position in insertSegment()");
 	}
 
-	segments.insert(segments.begin() + position, std::move(segment));
-	cacheValidity = false;
+	const std::size_t pos = static_cast<std::size_t>(position);
+	if (pos == getSegmentCount()) {
+		addSegment(std::move(segment));
+		return;
+	}
+	SegmentStore& store = writableStore();
+	// The joint the new segment splits disappears; the two around it appear
+	if (pos > 0) {
+		brokenJoints.remove(isJointBroken(store, pos - 1));
+	}
+	segmentAdded(*segment, pos);
+	const std::size_t chunk = chunkOf(store, pos);
+	SegmentChunk& target = writableChunk(chunk);
+	target.segments.insert(target.segments.begin() + (pos - store.starts[chunk]), std::move(segment));
+	if (target.segments.size() > chunkCapacity) {
+		// Split in two so that neither half needs to move again for a while
+		auto tail = std::make_shared<SegmentChunk>();
+		tail->exposed = target.exposed;
+		const std::size_t half = target.segments.size() / 2;
+		std::move(target.segments.begin() + half, target.segments.end(), std::back_inserter(tail->segments));
+		target.segments.resize(half);
+		store.chunks.insert(store.chunks.begin() + (chunk + 1), std::move(tail));
+	}
+	updateStarts(store, chunk + 1);
+	if (pos > 0) {
+		brokenJoints.add(isJointBroken(store, pos - 1));
+	}
+	brokenJoints.add(isJointBroken(store, pos));
 }
 
 void Contour2D::removeSegment(int position) {
-	if (position < 0 || position >= static_cast<int>(segments.size())) {
+	if (position < 0 || position >= static_cast<int>(getSegmentCount())) {
 		throw std::out_of_range("Invalid position in removeSegment()");
 	}
-	segments.erase(segments.begin() + position);
-	cacheValidity = false;
+	SegmentStore& store = writableStore();
+	const std::size_t pos = static_cast<std::size_t>(position);
+	// The joints on both sides of the removed segment disappear; its neighbours meet instead
+	if (pos > 0) {
+		brokenJoints.remove(isJointBroken(store, pos - 1));
+	}
+	if (pos + 1 < store.count) {
+		brokenJoints.remove(isJointBroken(store, pos));
+	}
+	segmentRemoved(segmentIn(store, pos), pos);
+	const std::size_t chunk = chunkOf(store, pos);
+	SegmentChunk& target = writableChunk(chunk);
+	target.segments.erase(target.segments.begin() + (pos - store.starts[chunk]));
+	if (target.segments.empty()) {
+		store.chunks.erase(store.chunks.begin() + chunk);
+	}
+	updateStarts(store, chunk);
+	if (pos > 0 && pos < store.count) {
+		brokenJoints.add(isJointBroken(store, pos - 1));
+	}
 }
 
 
 /**
  * @brief Checks if all segments in the contour are connected end-to-end within a tolerance.
  *
- * This method is cached for performance. A contour is valid if the end of each segment
- * matches the start of the next within a small epsilon.
+ * A contour is valid if the end of each segment matches the start of the next within a
+ * small epsilon, i.e. if it has no broken joints.
  *
  * @return True if the contour is continuous.
  */
 bool Contour2D::isValid() const {
-	//here we check the distance between the end of a segmnet and the following segment
+	return getBrokenJointCount() == 0;
+}
+
+/**
+ * @brief Returns the number of broken joints.
+ *
+ * Edits keep the count current, so this is O(1) except after a mutable getSegmentAt(),
+ * which forces one full rescan. The count is an atomic, so concurrent callers on a shared
+ * contour do not race.
+ *
+ * @return Number of joints whose endpoints are further apart than epsilon.
+ */
+size_t Contour2D::getBrokenJointCount() const {
 	//since these are not directional segments, distance is calculated between point b and point A of the next pointer
-	//need to go through all the segments in this contuor
-	//need to cache the validity check to avoid recalculations
-	if (!cacheValidity) {
-		cachedIsValid = true;
-		for (size_t i = 0; i + 1 < segments.size(); ++i) {
-			const MyPoint& end = segments[i]->getPointB();
-			const MyPoint& start = segments[i + 1]->getPointA();
-			if (end.distanceTo_2D(start) > epsilon) {
-				cachedIsValid = false;
+	return brokenJoints.get([this]() {
+		size_t broken = 0;
+		const Segment2D* previous = nullptr;
+		for (const Segment2D& seg : *this) {
+			if (previous && previous->getPointB().distanceTo_2D(seg.getPointA()) > defaultEpsilon) {
+				++broken;
 			}
+			previous = &seg;
 		}
-		cacheValidity = true;
-	}
-	return cachedIsValid;
+		return broken;
+	});
+}
 
+/**
+ * @brief Builds a joint-level validation report.
+ *
+ * Segment endpoints are gathered into contiguous arrays once, then scanned by the
+ * vectorized gap kernel.
+ *
+ * @param epsilon Maximum allowed gap at each joint.
+ * @return Report of every broken joint.
+ */
+ValidationReport Contour2D::validate(double epsilon) const {
+	const std::size_t count = getSegmentCount();
+	std::vector<double> endpoints(4 * count);
+	double* ax = endpoints.data();
+	double* ay = ax + count;
+	double* bx = ay + count;
+	double* by = bx + count;
+	std::size_t i = 0;
+	for (const Segment2D& seg : *this) {
+		const MyPoint& a = seg.getPointA();
+		const MyPoint& b = seg.getPointB();
+		ax[i] = a.getX();
+		ay[i] = a.getY();
+		bx[i] = b.getX();
+		by[i] = b.getY();
+		++i;
+	}
+	return validateEndpoints(ax, ay, bx, by, count, epsilon);
 }
 
 Segment2D& Contour2D::getSegmentAt(std::size_t index) {
-	if (index >= segments.size()) {
+	if (index >= getSegmentCount()) {
+		throw std::out_of_range("Invalid index in getSegmentAt()");
+	}
+	const std::size_t chunk = chunkOf(readSegments(), index);
+	SegmentChunk& target = writableChunk(chunk);
+	// The caller may modify the segment, so its chunk can no longer be shared with copies
+	target.exposed = true;
+	shareable = false;
+	invalidateDerived();
+	return *target.segments[index - segments->starts[chunk]];
+}
+
+const Segment2D& Contour2D::getSegmentAt(std::size_t index) const {
+	if (index >= getSegmentCount()) {
 		throw std::out_of_range("Invalid index in getSegmentAt()");
 	}
-	return *segments[index];
+	return segmentIn(*segments, index);
 }
 
 
+/**
+ * @brief Translates every segment.
+ *
+ * Length is unchanged by a translation and the cached bounding box is shifted. Each
+ * segment's area term changes by (dx * (yB - yA) - dy * (xB - xA)) / 2, which is summed
+ * in the same pass.
+ *
+ * @param dx Offset along the X axis.
+ * @param dy Offset along the Y axis.
+ */
 void Contour2D::move(double dx, double dy) {
-	for (auto& segPtr : segments) {
-		segPtr->move(dx, dy);
+	double areaShift = 0.0;
+	for (std::size_t chunk = 0; chunk < readSegments().chunks.size(); ++chunk) {
+		for (auto& segPtr : writableChunk(chunk).segments) {
+			const MyPoint& a = segPtr->getPointA();
+			const MyPoint& b = segPtr->getPointB();
+			areaShift += dx * (b.getY() - a.getY()) - dy * (b.getX() - a.getX());
+			segPtr->move(dx, dy);
+		}
+	}
+	areaTermCache.update([areaShift](double& total) { total += 0.5 * areaShift; });
+	boundsCache.update([dx, dy](BoundingBox2D& bounds) { bounds.move(dx, dy); });
+	editSegmentBounds([dx, dy](std::vector<BoundingBox2D>& boxes) {
+		for (auto& box : boxes) {
+			box.move(dx, dy);
+		}
+	});
+}
+
+void Contour2D::reverse() {
+	SegmentStore& store = writableStore();
+	std::reverse(store.chunks.begin(), store.chunks.end());
+	for (std::size_t chunk = 0; chunk < store.chunks.size(); ++chunk) {
+		SegmentChunk& target = writableChunk(chunk);
+		std::reverse(target.segments.begin(), target.segments.end());
+		for (auto& segPtr : target.segments) {
+			segPtr->reverse();
+		}
+	}
+	updateStarts(store, 0);
+	// Joint gaps are symmetric, so the broken joint count is unchanged
+	areaTermCache.update([](double& total) { total = -total; });
+	editSegmentBounds([](std::vector<BoundingBox2D>& boxes) { std::reverse(boxes.begin(), boxes.end()); });
+	lengthIndex.invalidate();
+}
+
+double Contour2D::totalLength() const {
+	return lengthCache.get([this]() {
+		double total = 0.0;
+		for (const Segment2D& seg : *this) {
+			total += seg.getLength();
+		}
+		return total;
+	});
+}
+
+BoundingBox2D Contour2D::boundingBox() const {
+	return boundsCache.get([this]() {
+		BoundingBox2D bounds;
+		for (const Segment2D& seg : *this) {
+			bounds.expand(seg.getBoundingBox());
+		}
+		return bounds;
+	});
+}
+
+std::shared_ptr<const std::vector<BoundingBox2D>> Contour2D::segmentBoundingBoxes() const {
+	return segmentBounds.get([this]() {
+		auto boxes = std::make_shared<std::vector<BoundingBox2D>>();
+		boxes->reserve(getSegmentCount());
+		for (const Segment2D& seg : *this) {
+			boxes->push_back(seg.getBoundingBox());
+		}
+		return boxes;
+	});
+}
+
+std::vector<std::size_t> Contour2D::findSegmentsIntersecting(const BoundingBox2D& window) const {
+	std::vector<std::size_t> result;
+	if (!boundingBox().intersects(window)) {
+		return result;
+	}
+	const std::shared_ptr<const std::vector<BoundingBox2D>> boxes = segmentBoundingBoxes();
+	for (std::size_t i = 0; i < boxes->size(); ++i) {
+		if ((*boxes)[i].intersects(window)) {
+			result.push_back(i);
+		}
+	}
+	return result;
+}
+
+double Contour2D::signedArea() const {
+	const SegmentStore& store = readSegments();
+	if (store.count == 0) {
+		return 0.0;
 	}
+	const double segmentTerms = areaTermCache.get([this]() {
+		double total = 0.0;
+		for (const Segment2D& seg : *this) {
+			total += seg.getSignedAreaTerm();
+		}
+		return total;
+	});
+	// Closing chord from the end of the contour back to its start; zero for closed contours
+	const MyPoint& end = store.chunks.back()->segments.back()->getPointB();
+	const MyPoint& start = store.chunks.front()->segments.front()->getPointA();
+	return segmentTerms + 0.5 * (end.getX() * start.getY() - start.getX() * end.getY());
 }
 
 /**
@@ -101,20 +566,138 @@ void Contour2D::move(double dx, double dy) {
 
 bool Contour2D::isClosedShape() const {
 
+	const SegmentStore& store = readSegments();
 	if (!isValid()) {
 		return false;
 	}
 
-	if (segments.size() == 1) {
-		if (segments.front()->isNonZeroLength(epsilon)) {
-			return (segments.front()->getPointA().distanceTo_2D(segments.front()->getPointB()) < epsilon);
+	if (store.count == 0) {
+		return false;
+	}
+	const Segment2D& front = *store.chunks.front()->segments.front();
+	const Segment2D& back = *store.chunks.back()->segments.back();
+	if (store.count == 1) {
+		if (front.isNonZeroLength(defaultEpsilon)) {
+			return (front.getPointA().distanceTo_2D(front.getPointB()) < defaultEpsilon);
 		}
 	}
-	else if (segments.size() > 1) {
+	else {
 
-		if (segments.back()->getPointB().distanceTo_2D(segments.front()->getPointA()) < epsilon) {
+		if (back.getPointB().distanceTo_2D(front.getPointA()) < defaultEpsilon) {
 			return true;
 		}
 	}
 	return false;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Returns the prefix sums of segment lengths, building them if needed.
+ *
+ * Entry i is the distance from the start of the contour to the start of segment i; the
+ * last entry is the total length.
+ *
+ * @return Shared, immutable prefix sum array.
+ */
+std::shared_ptr<const std::vector<double>> Contour2D::getLengthIndex() const {
+	return lengthIndex.get([this]() {
+		auto prefix = std::make_shared<std::vector<double>>();
+		prefix->reserve(getSegmentCount() + 1);
+		double total = 0.0;
+		prefix->push_back(total);
+		for (const Segment2D& seg : *this) {
+			total += seg.getLength();
+			prefix->push_back(total);
+		}
+		return std::shared_ptr<const std::vector<double>>(std::move(prefix));
+	});
+}
+
+MyPoint Contour2D::pointAtLength(double distance) const {
+	double local = 0.0;
+	const Segment2D& seg = segmentAtLength(distance, local);
+	return seg.pointAtLength(local);
+}
+
+MyPoint Contour2D::tangentAtLength(double distance) const {
+	double local = 0.0;
+	const Segment2D& seg = segmentAtLength(distance, local);
+	return seg.tangentAtLength(local);
+}
+
+/**
+ * @brief Locates the segment containing a given arc length by binary search.
+ * @param distance Distance along the contour; clamped to [0, totalLength()].
+ * @param local Receives the distance from the start of the returned segment.
+ * @return Segment containing the distance.
+ */
+const Segment2D& Contour2D::segmentAtLength(double distance, double& local) const {
+	const SegmentStore& store = readSegments();
+	if (store.count == 0) {
+		throw std::out_of_range("Contour has no segments in pointAtLength()");
+	}
+	const std::shared_ptr<const std::vector<double>> index = getLengthIndex();
+	const std::vector<double>& prefix = *index;
+	const double s = distance < 0.0 ? 0.0 : (distance > prefix.back() ? prefix.back() : distance);
+	// Last segment starting at or before s, so zero-length segments before it are skipped
+	std::size_t seg = static_cast<std::size_t>(std::upper_bound(prefix.begin(), prefix.end(), s) - prefix.begin()) - 1;
+	if (seg >= store.count) {
+		seg = store.count - 1;
+	}
+	local = s - prefix[seg];
+	return segmentIn(store, seg);
+}
+
+std::vector<MyPoint> Contour2D::pointsAtLengths(const std::vector<double>& distances) const {
+	return sampleAtLengths(distances, [](const Segment2D& seg, double local) { return seg.pointAtLength(local); });
+}
+
+std::vector<MyPoint> Contour2D::tangentsAtLengths(const std::vector<double>& distances) const {
+	return sampleAtLengths(distances, [](const Segment2D& seg, double local) { return seg.tangentAtLength(local); });
+}
+
+/**
+ * @brief Shared walk behind the arc-length queries.
+ *
+ * The first distance is located by binary search; after that the segment cursor only
+ * moves forward, so a sorted batch of m distances never costs more than O(log n + n + m).
+ *
+ * @param distances Distances in ascending order.
+ * @param evaluate Callable (const Segment2D&, double localDistance) returning MyPoint.
+ * @return One result per distance.
+ */
+template <class Evaluate>
+std::vector<MyPoint> Contour2D::sampleAtLengths(const std::vector<double>& distances, Evaluate evaluate) const {
+	const SegmentStore& store = readSegments();
+	if (store.count == 0) {
+		throw std::out_of_range("Contour has no segments in pointAtLength()");
+	}
+	std::vector<MyPoint> results;
+	if (distances.empty()) {
+		return results;
+	}
+	results.reserve(distances.size());
+
+	const std::shared_ptr<const std::vector<double>> index = getLengthIndex();
+	const std::vector<double>& prefix = *index;
+	const std::size_t lastSegment = store.count - 1;
+
+	auto clamp = [&prefix](double distance) {
+		return distance < 0.0 ? 0.0 : (distance > prefix.back() ? prefix.back() : distance);
+	};
+
+	std::size_t seg = static_cast<std::size_t>(std::upper_bound(prefix.begin(), prefix.end(), clamp(distances.front())) - prefix.begin()) - 1;
+	seg = seg < lastSegment ? seg : lastSegment;
+	double previous = distances.front();
+	for (double distance : distances) {
+		if (distance < previous) {
+			throw std::invalid_argument("Distances must be sorted in pointsAtLengths()");
+		}
+		previous = distance;
+		const double s = clamp(distance);
+		while (seg < lastSegment && prefix[seg + 1] <= s) {
+			++seg;
+		}
+		results.push_back(evaluate(segmentIn(store, seg), s - prefix[seg]));
+	}
+	return results;
+}
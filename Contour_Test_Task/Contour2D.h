@@ -10,8 +10,14 @@
 #include <vector>
 #include <memory>
 #include <stdexcept>
+#include <iterator>
+#include <cstddef>
 #include "Segment2D.h"
 #include "MyPoint.h"
+#include "JointCounter.h"
+#include "ContourValidation.h"
+#include "LazyValue.h"
+#include "BoundingBox2D.h"
 
  /**
  * @class Contour2D
@@ -19,13 +25,66 @@
  *
  * Allows adding, removing, and moving segments, and checks if the contour is valid (i.e., continuous).
  * A contour is considered valid if all segments are connected end-to-end within a small epsilon tolerance.
+ *
+ * Copies are copy-on-write: a copy shares the segment storage of its source until either
+ * of them is modified. Segments are stored in chunks of at most chunkCapacity, and an edit
+ * clones only the chunks it writes to, so changing one segment of a large shared contour
+ * copies one chunk rather than the whole contour.
+ * Const queries may be called concurrently from several threads on the same contour.
  */
 class Contour2D {
 private:
-	const double epsilon = defaultEpsilon;
-	std::vector<std::unique_ptr<Segment2D>> segments;
-	mutable bool cachedIsValid = false;
-	mutable bool cacheValidity = false;
+	/// Most segments held by one storage chunk; an insert into a full chunk splits it in two.
+	static constexpr std::size_t chunkCapacity = 256;
+
+	/**
+	* @brief A run of consecutive segments that copies share or clone as a unit.
+	*
+	* An exposed chunk holds a segment handed out by the mutable getSegmentAt(). It belongs
+	* to a single contour, and copies of that contour clone it instead of sharing it.
+	*/
+	struct SegmentChunk {
+		std::vector<std::unique_ptr<Segment2D>> segments;
+		bool exposed = false;
+	};
+	/**
+	* @brief The chunks of a contour in order, with the index of each chunk's first segment.
+	*
+	* Chunks are never empty.
+	*/
+	struct SegmentStore {
+		std::vector<std::shared_ptr<SegmentChunk>> chunks;
+		std::vector<std::size_t> starts;
+		std::size_t count = 0;
+	};
+
+	std::shared_ptr<SegmentStore> segments;
+	bool shareable = true;
+	JointCounter brokenJoints;
+	LazyValue<double> lengthCache{ 0.0 };
+	LazyValue<BoundingBox2D> boundsCache{ BoundingBox2D() };
+	LazyValue<double> areaTermCache{ 0.0 };
+	LazyValue<std::shared_ptr<const std::vector<double>>> lengthIndex;
+	LazyValue<std::shared_ptr<std::vector<BoundingBox2D>>> segmentBounds;
+
+	const SegmentStore& readSegments() const;
+	SegmentStore& writableStore();
+	SegmentChunk& writableChunk(std::size_t chunk);
+	static std::shared_ptr<SegmentStore> copyStore(const SegmentStore& source);
+	static std::size_t chunkOf(const SegmentStore& store, std::size_t index);
+	static const Segment2D& segmentIn(const SegmentStore& store, std::size_t index);
+	static void updateStarts(SegmentStore& store, std::size_t firstChunk);
+	static bool isJointBroken(const SegmentStore& store, std::size_t joint);
+	void segmentAdded(const Segment2D& segment, std::size_t position);
+	void segmentRemoved(const Segment2D& segment, std::size_t position);
+	template <class Edit>
+	void editSegmentBounds(Edit edit);
+	void invalidateDerived();
+	void resetToEmpty() noexcept;
+	std::shared_ptr<const std::vector<double>> getLengthIndex() const;
+	const Segment2D& segmentAtLength(double distance, double& local) const;
+	template <class Evaluate>
+	std::vector<MyPoint> sampleAtLengths(const std::vector<double>& distances, Evaluate evaluate) const;
 
 public:
 
@@ -36,26 +95,42 @@ public:
 	Contour2D() = default;
 	/**
 	* @brief Copy constructor.
+	*
+	* Shares the segments of other in O(1). A chunk of segments is cloned when either
+	* contour first modifies it. Chunks that other has handed out a mutable segment reference
+	* into through getSegmentAt() are cloned immediately. Cloned segments are allocated on
+	* the heap; use copyContour() to copy into a SegmentArena.
+	*
 	* @param other Contour2D to copy from.
 	*/
 	Contour2D(const Contour2D& other);
 	/**
 	* @brief Copy assignment operator.
+	*
+	* Shares segment storage like the copy constructor.
+	*
 	* @param other Contour2D to copy from.
 	* @return Reference to this.
 	*/
 	Contour2D& operator=(const Contour2D& other);
 	/**
 	* @brief Move constructor.
+	*
+	* Takes over the segments and cached properties of other, which is left as an empty
+	* contour that can be reused.
+	*
 	* @param other Contour2D to move from.
 	*/
-	Contour2D(Contour2D&& other) noexcept = default;
+	Contour2D(Contour2D&& other) noexcept;
 	/**
 	* @brief Move assignment operator.
+	*
+	* Leaves other as an empty contour, like the move constructor.
+	*
 	* @param other Contour2D to move from.
 	* @return Reference to this.
 	*/
-	Contour2D& operator=(Contour2D&& other) noexcept = default;
+	Contour2D& operator=(Contour2D&& other) noexcept;
 
 
 	/**
@@ -70,6 +145,10 @@ public:
 	void addSegment(const Segment2D& segment);
 	/**
 	* @brief Checks whether the contour is valid (continuous).
+	*
+	* O(1) after the first call: edits keep a count of broken joints up to date by checking
+	* only the joints they touch. Thread-safe; the cached path does not lock.
+	*
 	* @return True if all segments are connected within epsilon.
 	*/
 	bool isValid() const;
@@ -86,19 +165,75 @@ public:
 	void removeSegment(const int position);
 	/**
 	* @brief Retrieves a reference to the segment at the given index.
+	*
+	* Clones the chunk holding the segment if it is shared with copies. Because the returned
+	* reference allows modification, later copies of this contour clone that chunk instead
+	* of sharing it.
+	*
+	* The next isValid() call rescans every joint, since the segment may be edited in place.
+	*
 	* @param index Index of the segment.
 	* @return Reference to the Segment2D.
 	*/
 	Segment2D& getSegmentAt(std::size_t index);
+	/**
+	* @brief Retrieves a read-only reference to the segment at the given index.
+	* @param index Index of the segment.
+	* @return Const reference to the Segment2D.
+	*/
+	const Segment2D& getSegmentAt(std::size_t index) const;
+	/**
+	* @brief Checks whether this contour currently shares segment storage with another.
+	* @param other Contour to compare with.
+	* @return True if both contours read at least one segment object in common.
+	*/
+	bool sharesSegmentsWith(const Contour2D& other) const;
+
+	/**
+	* @class const_iterator
+	* @brief Read-only forward iterator over the segments of a contour.
+	*
+	* Dereferences to const Segment2D&, so segments that may be shared with copies
+	* cannot be changed behind the contour's back. Use getSegmentAt() for write access.
+	*/
+	class const_iterator {
+	private:
+		const std::vector<std::shared_ptr<SegmentChunk>>* chunks = nullptr;
+		std::size_t chunk = 0;
+		std::size_t offset = 0;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Segment2D;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const Segment2D*;
+		using reference = const Segment2D&;
+
+		const_iterator() = default;
+		const_iterator(const std::vector<std::shared_ptr<SegmentChunk>>& chunks_, std::size_t chunk_) : chunks(&chunks_), chunk(chunk_) {}
+
+		reference operator*() const { return *(*chunks)[chunk]->segments[offset]; }
+		pointer operator->() const { return (*chunks)[chunk]->segments[offset].get(); }
+		const_iterator& operator++() {
+			if (++offset == (*chunks)[chunk]->segments.size()) {
+				++chunk;
+				offset = 0;
+			}
+			return *this;
+		}
+		const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+		bool operator==(const const_iterator& other) const { return chunk == other.chunk && offset == other.offset; }
+		bool operator!=(const const_iterator& other) const { return !(*this == other); }
+	};
 
 	/**
-	 * @brief Returns a const iterator to the beginning of the segment container.
-	 */
-	std::vector<std::unique_ptr<Segment2D>>::const_iterator begin() const { return segments.begin(); }
+	* @brief Returns a read-only iterator to the first segment.
+	*/
+	const_iterator begin() const { return const_iterator(readSegments().chunks, 0); }
 	/**
-	* @brief Returns a const iterator to the end of the segment container.
+	* @brief Returns a read-only iterator past the last segment.
 	*/
-	std::vector<std::unique_ptr<Segment2D>>::const_iterator end() const { return segments.end(); }
+	const_iterator end() const { return const_iterator(readSegments().chunks, readSegments().chunks.size()); }
 	/**
 	* @brief Determines whether the contour forms a closed shape.
 	* @return True if the start point and end point are within epsilon.
@@ -114,6 +249,123 @@ public:
 	* @brief Returns the number of segments in the contour.
 	* @return Number of segments.
 	*/
-	size_t getSegmentCount()const { return segments.size(); }
+	size_t getSegmentCount()const { return segments ? segments->count : 0; }
+	/**
+	* @brief Returns the number of joints whose endpoints are further apart than epsilon.
+	* @return Number of broken joints; zero for a valid contour.
+	*/
+	size_t getBrokenJointCount() const;
+	/**
+	* @brief Reports every broken joint with its gap and any reversed neighbouring segment.
+	* @param epsilon Maximum allowed gap at each joint.
+	* @return Validation report; report.isValid() matches isValid() for the default epsilon.
+	*/
+	ValidationReport validate(double epsilon = defaultEpsilon) const;
+	/**
+	* @brief Returns the summed length of all segments.
+	*
+	* Cached; edits adjust the cached value instead of discarding it.
+	*
+	* @return Total length.
+	*/
+	double totalLength() const;
+	/**
+	* @brief Returns the smallest axis-aligned box containing every segment.
+	*
+	* Exact for arcs. Cached; adding segments grows the cached box and move() shifts it.
+	*
+	* @return Bounding box; empty for a contour without segments.
+	*/
+	BoundingBox2D boundingBox() const;
+	/**
+	* @brief Returns the exact bounding box of every segment.
+	*
+	* Built on first use and then kept up to date by edits; move() shifts the boxes instead
+	* of recomputing arc extremes.
+	*
+	* @return Shared, read-only array with one box per segment.
+	*/
+	std::shared_ptr<const std::vector<BoundingBox2D>> segmentBoundingBoxes() const;
+	/**
+	* @brief Finds the segments whose bounding box overlaps a window.
+	*
+	* Rejects the whole contour through boundingBox() first, then compares the cached
+	* segment boxes. No segment geometry is evaluated.
+	*
+	* @param window Query box.
+	* @return Indices of candidate segments in ascending order.
+	*/
+	std::vector<std::size_t> findSegmentsIntersecting(const BoundingBox2D& window) const;
+	/**
+	* @brief Returns the signed area enclosed by the contour.
+	*
+	* Line segments contribute their shoelace term and arcs additionally the circular
+	* segment between chord and arc. An open contour is treated as closed by a straight
+	* line from its end back to its start. Positive for counter-clockwise contours.
+	* Cached; edits and move() adjust the cached value.
+	*
+	* @return Signed area.
+	*/
+	double signedArea() const;
+	/**
+	* @brief Returns the winding direction of the contour from its signed area.
+	* @return CounterClockwise, Clockwise, or Degenerate if the area is within epsilon^2 of zero.
+	*/
+	Orientation orientation() const { return orientationFromArea(signedArea()); }
+	/**
+	* @brief Classifies a signed area as an orientation.
+	* @param area Signed area.
+	* @return CounterClockwise, Clockwise, or Degenerate if |area| <= epsilon^2.
+	*/
+	static Orientation orientationFromArea(double area) {
+		if (area > defaultEpsilon * defaultEpsilon) {
+			return Orientation::CounterClockwise;
+		}
+		if (area < -defaultEpsilon * defaultEpsilon) {
+			return Orientation::Clockwise;
+		}
+		return Orientation::Degenerate;
+	}
+	/**
+	* @brief Reverses the contour in place: segment order and every segment's direction.
+	*
+	* Keeps validity, length and bounding box, and negates the signed area.
+	*/
+	void reverse();
+	/**
+	* @brief Returns the point at a given arc length from the start of the contour.
+	*
+	* Backed by a cached prefix sum of segment lengths, so a query is a binary search plus
+	* one segment evaluation. The index is rebuilt lazily after segments are added, inserted
+	* or removed; move() keeps it. Gaps between segments do not count towards the distance.
+	*
+	* @param distance Distance along the contour; clamped to [0, totalLength()].
+	* @return Point on the contour.
+	* @throws std::out_of_range If the contour has no segments.
+	*/
+	MyPoint pointAtLength(double distance) const;
+	/**
+	* @brief Returns the unit direction of travel at a given arc length.
+	* @param distance Distance along the contour; clamped to [0, totalLength()].
+	* @return Unit tangent stored as a point.
+	* @throws std::out_of_range If the contour has no segments.
+	*/
+	MyPoint tangentAtLength(double distance) const;
+	/**
+	* @brief Evaluates pointAtLength() for many distances in one forward walk.
+	* @param distances Distances in ascending order.
+	* @return One point per distance.
+	* @throws std::invalid_argument If distances are not sorted.
+	* @throws std::out_of_range If the contour has no segments.
+	*/
+	std::vector<MyPoint> pointsAtLengths(const std::vector<double>& distances) const;
+	/**
+	* @brief Evaluates tangentAtLength() for many distances in one forward walk.
+	* @param distances Distances in ascending order.
+	* @return One unit tangent per distance.
+	* @throws std::invalid_argument If distances are not sorted.
+	* @throws std::out_of_range If the contour has no segments.
+	*/
+	std::vector<MyPoint> tangentsAtLengths(const std::vector<double>& distances) const;
 
 };
@@ -0,0 +1,90 @@
+/**
+ * @file ContourBatch.h
+ * @brief Batch queries over collections of Contour2D objects.
+ */
+#pragma once
+#include <vector>
+#include <iterator>
+#include <cstddef>
+#include "Contour2D.h"
+#include "ParallelFor.h"
+
+ /**
+ * @struct ValidityPartition
+ * @brief Indices of the valid and invalid contours of a batch.
+ *
+ * Both lists are in ascending order; every index of the batch appears in exactly one.
+ */
+struct ValidityPartition {
+	std::vector<std::size_t> valid;		///< Indices of valid contours.
+	std::vector<std::size_t> invalid;	///< Indices of invalid contours.
+};
+
+/**
+* @brief Splits a range of contours into valid and invalid ones in a single parallel pass.
+*
+* Each contour is checked once with isValid(). Chunks record their own results, which are
+* concatenated in chunk order at the end, so no locking happens per contour.
+*
+* @param first Random-access iterator to the first Contour2D.
+* @param last Iterator one past the last Contour2D.
+* @param executor Executor that runs the checks.
+* @return Indices relative to first, partitioned by validity.
+*/
+template <class RandomIt>
+ValidityPartition partitionByValidity(RandomIt first, RandomIt last, const ParallelExecutor& executor = ParallelExecutor()) {
+	const std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+	const std::size_t grain = executor.defaultGrainSize(count);
+	std::vector<ValidityPartition> chunkResults(ParallelExecutor::chunkCount(count, grain));
+
+	executor.forChunks(count, grain, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+		ValidityPartition& local = chunkResults[chunk];
+		for (std::size_t i = begin; i < end; ++i) {
+			const Contour2D& contour = first[i];
+			(contour.isValid() ? local.valid : local.invalid).push_back(i);
+		}
+	});
+
+	ValidityPartition result;
+	std::size_t validCount = 0;
+	for (const auto& local : chunkResults) {
+		validCount += local.valid.size();
+	}
+	result.valid.reserve(validCount);
+	result.invalid.reserve(count - validCount);
+	for (const auto& local : chunkResults) {
+		result.valid.insert(result.valid.end(), local.valid.begin(), local.valid.end());
+		result.invalid.insert(result.invalid.end(), local.invalid.begin(), local.invalid.end());
+	}
+	return result;
+}
+
+/**
+* @brief Splits a vector of contours into valid and invalid ones in a single parallel pass.
+* @param contours Contours to check.
+* @param executor Executor that runs the checks.
+* @return Indices into contours, partitioned by validity.
+*/
+inline ValidityPartition partitionByValidity(const std::vector<Contour2D>& contours, const ParallelExecutor& executor = ParallelExecutor()) {
+	return partitionByValidity(contours.begin(), contours.end(), executor);
+}
+
+/**
+* @brief Finds the contours whose bounding box overlaps a window.
+*
+* A broad-phase filter over the cached Contour2D::boundingBox() values; contours that pass
+* still need an exact test.
+*
+* @param contours Contours to filter.
+* @param window Query box.
+* @return Indices of overlapping contours in ascending order.
+*/
+inline std::vector<std::size_t> findContoursIntersecting(const std::vector<Contour2D>& contours, const BoundingBox2D& window) {
+	std::vector<std::size_t> result;
+	for (std::size_t i = 0; i < contours.size(); ++i) {
+		if (contours[i].boundingBox().intersects(window)) {
+			result.push_back(i);
+		}
+	}
+	return result;
+}
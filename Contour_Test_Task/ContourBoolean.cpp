@@ -0,0 +1,129 @@
+/**
+ * @file ContourBoolean.cpp
+ * @brief Implements boolean operations by splitting, classifying and chaining pieces.
+ */
+#include "ContourBoolean.h"
+#include "ContourIntersection.h"
+#include "ContourDistance.h"
+#include "PreparedContour2D.h"
+#include "ContourPieces.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+	/**
+	 * @brief Where a piece of one outline lies relative to the other region.
+	 */
+	enum class PieceSide : unsigned char {
+		Outside,
+		Inside,
+		SharedSame,		// on the other boundary, running the same way
+		SharedOpposite	// on the other boundary, running the opposite way
+	};
+
+	/**
+	 * @brief What to do with a piece: drop it, keep it, or keep it reversed.
+	 */
+	enum class PieceAction : unsigned char { Drop, Keep, Reverse };
+
+	PieceAction actionFor(BooleanOperation operation, bool fromFirst, PieceSide side) {
+		switch (operation) {
+		case BooleanOperation::Union:
+			return side == PieceSide::Outside || (fromFirst && side == PieceSide::SharedSame) ? PieceAction::Keep : PieceAction::Drop;
+		case BooleanOperation::Intersection:
+			return side == PieceSide::Inside || (fromFirst && side == PieceSide::SharedSame) ? PieceAction::Keep : PieceAction::Drop;
+		case BooleanOperation::Difference:
+			if (fromFirst) {
+				return side == PieceSide::Outside || side == PieceSide::SharedOpposite ? PieceAction::Keep : PieceAction::Drop;
+			}
+			return side == PieceSide::Inside ? PieceAction::Reverse : PieceAction::Drop;
+		case BooleanOperation::Xor:
+			return side == PieceSide::Outside ? PieceAction::Keep
+				: side == PieceSide::Inside ? PieceAction::Reverse : PieceAction::Drop;
+		}
+		return PieceAction::Drop;
+	}
+
+	/**
+	 * @brief One operand prepared for classification: counter-clockwise copy, grid and tree.
+	 */
+	struct Operand {
+		Contour2D contour;
+		PreparedContour2D grid;
+		SegmentTree2D tree;
+
+		Operand(const Contour2D& source, double epsilon)
+			: contour(counterClockwiseCopy(source)), grid(contour, epsilon), tree(contour) {
+		}
+
+		static Contour2D counterClockwiseCopy(const Contour2D& source) {
+			Contour2D copy(source);
+			if (copy.orientation() == Orientation::Clockwise) {
+				copy.reverse();
+			}
+			return copy;
+		}
+	};
+
+	void requireClosed(const Contour2D& contour, double epsilon) {
+		if (!isClosedContour(contour, epsilon)) {
+			throw std::invalid_argument("Operands must be closed contours in booleanOperation()");
+		}
+	}
+
+	/**
+	 * @brief Splits every segment at the intersection points that fall on it.
+	 */
+	std::vector<std::unique_ptr<Segment2D>> splitAtIntersections(const Contour2D& contour, const std::vector<IntersectionPoint>& hits,
+		bool fromFirst, double epsilon) {
+
+		std::vector<std::vector<MyPoint>> cuts(contour.getSegmentCount());
+		for (const IntersectionPoint& hit : hits) {
+			cuts[fromFirst ? hit.first : hit.second].push_back(hit.point);
+		}
+		return splitSegments(contour, cuts, epsilon);
+	}
+
+	PieceSide classify(const Segment2D& piece, const Operand& other) {
+		const double half = 0.5 * piece.getLength();
+		const MyPoint middle = piece.pointAtLength(half);
+		const PointLocation location = other.grid.locate(middle);
+		if (location != PointLocation::Boundary) {
+			return location == PointLocation::Inside ? PieceSide::Inside : PieceSide::Outside;
+		}
+		const ClosestPoint nearest = other.tree.closestPoint(middle);
+		const Segment2D& seg = other.contour.getSegmentAt(nearest.segment);
+		const MyPoint otherTangent = seg.tangentAtLength(seg.lengthAtPoint(nearest.point));
+		const MyPoint tangent = piece.tangentAtLength(half);
+		const double dot = tangent.getX() * otherTangent.getX() + tangent.getY() * otherTangent.getY();
+		return dot > 0 ? PieceSide::SharedSame : PieceSide::SharedOpposite;
+	}
+
+}
+
+std::vector<Contour2D> booleanOperation(const Contour2D& a, const Contour2D& b, BooleanOperation operation, double epsilon) {
+	requireClosed(a, epsilon);
+	requireClosed(b, epsilon);
+	const Operand first(a, epsilon);
+	const Operand second(b, epsilon);
+	const std::vector<IntersectionPoint> hits = intersections(first.contour, first.tree, second.contour, second.tree, epsilon);
+
+	std::vector<std::unique_ptr<Segment2D>> kept;
+	for (int side = 0; side < 2; ++side) {
+		const bool fromFirst = side == 0;
+		const Operand& self = fromFirst ? first : second;
+		const Operand& other = fromFirst ? second : first;
+		for (auto& piece : splitAtIntersections(self.contour, hits, fromFirst, epsilon)) {
+			const PieceAction action = actionFor(operation, fromFirst, classify(*piece, other));
+			if (action == PieceAction::Drop) {
+				continue;
+			}
+			if (action == PieceAction::Reverse) {
+				piece->reverse();
+			}
+			kept.push_back(std::move(piece));
+		}
+	}
+	return chainLoops(kept, epsilon);
+}
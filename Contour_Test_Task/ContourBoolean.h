@@ -0,0 +1,70 @@
+/**
+ * @file ContourBoolean.h
+ * @brief Boolean operations on closed regions bounded by lines and arcs.
+ */
+#pragma once
+#include <vector>
+#include "Contour2D.h"
+
+ /**
+ * @enum BooleanOperation
+ * @brief Set operation applied to the regions of two closed contours.
+ */
+enum class BooleanOperation : unsigned char {
+	Union,			///< Points in either region.
+	Intersection,	///< Points in both regions.
+	Difference,		///< Points in the first region but not the second.
+	Xor				///< Points in exactly one region.
+};
+
+/**
+* @brief Applies a boolean operation to the regions bounded by two closed contours.
+*
+* Both outlines are split at their mutual intersections, found with intersections().
+* Each piece is classified by where its midpoint lies relative to the other region;
+* pieces on the shared boundary are told apart by comparing directions. The pieces the
+* operation keeps are chained end to start into closed loops. Arcs stay arcs throughout:
+* a split arc becomes shorter arcs on the same circle.
+*
+* The operands must be closed and free of self-intersections; their orientation does not
+* matter. Outer boundaries of the result run counter-clockwise and holes clockwise, so
+* the result region is the set of points with a non-zero total winding number. Where two
+* result loops touch at a single point they may come out joined as one loop through it.
+*
+* @param a First contour.
+* @param b Second contour.
+* @param operation Operation to apply.
+* @param epsilon Distance tolerance for intersections and shared boundaries.
+* @return Boundary loops of the result; empty if the result region is empty.
+* @throws std::invalid_argument If either contour is empty or not closed.
+*/
+std::vector<Contour2D> booleanOperation(const Contour2D& a, const Contour2D& b, BooleanOperation operation,
+	double epsilon = Contour2D::defaultEpsilon);
+
+/**
+* @brief Returns the union of two closed regions; see booleanOperation().
+*/
+inline std::vector<Contour2D> unionOf(const Contour2D& a, const Contour2D& b, double epsilon = Contour2D::defaultEpsilon) {
+	return booleanOperation(a, b, BooleanOperation::Union, epsilon);
+}
+
+/**
+* @brief Returns the intersection of two closed regions; see booleanOperation().
+*/
+inline std::vector<Contour2D> intersectionOf(const Contour2D& a, const Contour2D& b, double epsilon = Contour2D::defaultEpsilon) {
+	return booleanOperation(a, b, BooleanOperation::Intersection, epsilon);
+}
+
+/**
+* @brief Returns the first region minus the second; see booleanOperation().
+*/
+inline std::vector<Contour2D> differenceOf(const Contour2D& a, const Contour2D& b, double epsilon = Contour2D::defaultEpsilon) {
+	return booleanOperation(a, b, BooleanOperation::Difference, epsilon);
+}
+
+/**
+* @brief Returns the points in exactly one of two closed regions; see booleanOperation().
+*/
+inline std::vector<Contour2D> xorOf(const Contour2D& a, const Contour2D& b, double epsilon = Contour2D::defaultEpsilon) {
+	return booleanOperation(a, b, BooleanOperation::Xor, epsilon);
+}
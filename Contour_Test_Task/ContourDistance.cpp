@@ -0,0 +1,193 @@
+/**
+ * @file ContourDistance.cpp
+ * @brief Implements closest-point queries and the segment bounding-volume hierarchy.
+ */
+#include "ContourDistance.h"
+#include "LineSegment2D.h"
+#include "ArcSegment2D.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <cmath>
+
+namespace {
+
+	const std::size_t leafSize = 4;
+
+	inline double squaredDistance(const MyPoint& a, const MyPoint& b) {
+		const double dx = a.getX() - b.getX();
+		const double dy = a.getY() - b.getY();
+		return dx * dx + dy * dy;
+	}
+
+}
+
+SegmentTree2D::SegmentTree2D(const Contour2D& contour) {
+	const std::size_t count = contour.getSegmentCount();
+	if (count == 0) {
+		return;
+	}
+	std::vector<BuildItem> items;
+	items.reserve(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		const BoundingBox2D box = contour.getSegmentAt(i).getBoundingBox();
+		items.push_back({ box, 0.5 * (box.getMinX() + box.getMaxX()), 0.5 * (box.getMinY() + box.getMaxY()), i });
+	}
+	nodes.reserve(2 * (count / leafSize + 1));
+	build(items, 0, count);
+
+	// Copy the geometry in leaf order so that a leaf reads consecutive slots
+	pointA.reserve(count); pointB.reserve(count); center.reserve(count);
+	radius.reserve(count); ccwStart.reserve(count); sweep.reserve(count);
+	boxes.reserve(count); segmentIndex.reserve(count);
+	for (const BuildItem& item : items) {
+		const Segment2D& seg = contour.getSegmentAt(item.segment);
+		boxes.push_back(item.box);
+		pointA.push_back(seg.getPointA());
+		pointB.push_back(seg.getPointB());
+		if (seg.getKind() == SegmentKind::Arc) {
+			const ArcSegment2D& arc = static_cast<const ArcSegment2D&>(seg);
+			center.push_back(arc.getCenter());
+			radius.push_back(arc.getRadius());
+			ccwStart.push_back(arc.isCounterClockwise() ? arc.getStartAngle() : arc.getEndAngle());
+			sweep.push_back(arc.getSweepAngle());
+		}
+		else {
+			center.push_back(MyPoint());
+			radius.push_back(0.0);
+			ccwStart.push_back(0.0);
+			sweep.push_back(0.0);
+		}
+		segmentIndex.push_back(item.segment);
+	}
+}
+
+/**
+ * @brief Builds the subtree over items [first, last) and returns its node index.
+ *
+ * Nodes are stored depth-first, so the left child of an inner node is the next node.
+ */
+std::size_t SegmentTree2D::build(std::vector<BuildItem>& items, std::size_t first, std::size_t last) {
+	const std::size_t index = nodes.size();
+	nodes.push_back(Node());
+	BoundingBox2D box;
+	BoundingBox2D centers;
+	for (std::size_t i = first; i < last; ++i) {
+		box.expand(items[i].box);
+		centers.expand(items[i].centerX, items[i].centerY);
+	}
+	nodes[index].box = box;
+	if (last - first <= leafSize) {
+		nodes[index].first = first;
+		nodes[index].count = last - first;
+		return index;
+	}
+
+	const std::size_t middle = first + (last - first) / 2;
+	const bool splitX = centers.getWidth() >= centers.getHeight();
+	std::nth_element(items.begin() + first, items.begin() + middle, items.begin() + last,
+		[splitX](const BuildItem& a, const BuildItem& b) {
+			return splitX ? a.centerX < b.centerX : a.centerY < b.centerY;
+		});
+	build(items, first, middle);
+	const std::size_t right = build(items, middle, last);
+	nodes[index].right = right;
+	return index;
+}
+
+MyPoint SegmentTree2D::closestInSlot(std::size_t slot, const MyPoint& p) const {
+	if (radius[slot] > 0) {
+		return ArcSegment2D::closestPointOf(pointA[slot], pointB[slot], center[slot], radius[slot], ccwStart[slot], sweep[slot], p);
+	}
+	return LineSegment2D::closestPointOf(pointA[slot], pointB[slot], p);
+}
+
+ClosestPoint SegmentTree2D::closestPoint(const MyPoint& p) const {
+	if (nodes.empty()) {
+		throw std::out_of_range("Contour has no segments in closestPoint()");
+	}
+	ClosestPoint best;
+	double bestSq = std::numeric_limits<double>::infinity();
+	std::size_t bestSegment = std::numeric_limits<std::size_t>::max();
+
+	// Median splits keep the depth near log2(n / leafSize), far below the stack size
+	std::size_t stack[128];
+	std::size_t top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		const Node& node = nodes[stack[--top]];
+		if (node.box.squaredDistanceTo(p.getX(), p.getY()) > bestSq) {
+			continue;
+		}
+		if (node.count > 0) {
+			for (std::size_t slot = node.first; slot < node.first + node.count; ++slot) {
+				const MyPoint q = closestInSlot(slot, p);
+				const double distanceSq = squaredDistance(p, q);
+				if (distanceSq < bestSq || (distanceSq == bestSq && segmentIndex[slot] < bestSegment)) {
+					bestSq = distanceSq;
+					bestSegment = segmentIndex[slot];
+					best.point = q;
+				}
+			}
+			continue;
+		}
+		// Push the farther child first so that the nearer one is searched next
+		const std::size_t left = static_cast<std::size_t>(&node - nodes.data()) + 1;
+		const double leftSq = nodes[left].box.squaredDistanceTo(p.getX(), p.getY());
+		const double rightSq = nodes[node.right].box.squaredDistanceTo(p.getX(), p.getY());
+		if (leftSq <= rightSq) {
+			stack[top++] = node.right;
+			stack[top++] = left;
+		}
+		else {
+			stack[top++] = left;
+			stack[top++] = node.right;
+		}
+	}
+	best.distance = std::sqrt(bestSq);
+	best.segment = bestSegment;
+	return best;
+}
+
+std::vector<ClosestPoint> SegmentTree2D::closestPoints(const std::vector<MyPoint>& points, const ParallelExecutor& executor) const {
+	std::vector<ClosestPoint> result(points.size());
+	executor.forChunks(points.size(), executor.defaultGrainSize(points.size()), [&](std::size_t, std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i) {
+			result[i] = closestPoint(points[i]);
+		}
+	});
+	return result;
+}
+
+ClosestPoint closestPoint(const Contour2D& contour, const MyPoint& p) {
+	const std::size_t count = contour.getSegmentCount();
+	if (count == 0) {
+		throw std::out_of_range("Contour has no segments in closestPoint()");
+	}
+	const std::shared_ptr<const std::vector<BoundingBox2D>> boxes = contour.segmentBoundingBoxes();
+	ClosestPoint best;
+	double bestSq = std::numeric_limits<double>::infinity();
+	for (std::size_t i = 0; i < count; ++i) {
+		if ((*boxes)[i].squaredDistanceTo(p.getX(), p.getY()) >= bestSq) {
+			continue;
+		}
+		const MyPoint q = contour.getSegmentAt(i).closestPoint(p);
+		const double distanceSq = squaredDistance(p, q);
+		if (distanceSq < bestSq) {
+			bestSq = distanceSq;
+			best.point = q;
+			best.segment = i;
+		}
+	}
+	best.distance = std::sqrt(bestSq);
+	return best;
+}
+
+double distanceTo(const Contour2D& contour, const MyPoint& p) {
+	return closestPoint(contour, p).distance;
+}
+
+std::vector<ClosestPoint> closestPoints(const Contour2D& contour, const std::vector<MyPoint>& points, const ParallelExecutor& executor) {
+	const SegmentTree2D tree(contour);
+	return tree.closestPoints(points, executor);
+}
@@ -0,0 +1,196 @@
+/**
+ * @file ContourDistance.h
+ * @brief Closest-point and distance queries against contours of lines and arcs.
+ */
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include "Contour2D.h"
+#include "BoundingBox2D.h"
+#include "ParallelFor.h"
+
+ /**
+ * @struct ClosestPoint
+ * @brief Result of a nearest-point query.
+ */
+struct ClosestPoint {
+	MyPoint point;				///< Nearest point on the contour.
+	double distance = 0.0;		///< Distance from the query point to point.
+	std::size_t segment = 0;	///< Index of the segment holding point.
+};
+
+ /**
+ * @class SegmentTree2D
+ * @brief Bounding-volume hierarchy over the segments of a contour.
+ *
+ * A binary tree of boxes built by median splits along the wider axis of the segment
+ * centers, with a few segments per leaf. Nearest-point queries descend into the nearer
+ * child first and skip every subtree whose box is farther away than the best segment
+ * found so far, so they touch O(log n) nodes for typical contours.
+ *
+ * The tree copies the segment geometry; build it once and query it from any number of
+ * threads. Ties are resolved towards the lowest segment index.
+ */
+class SegmentTree2D {
+private:
+	struct Node {
+		BoundingBox2D box;
+		std::size_t first = 0;		// first slot of a leaf
+		std::size_t count = 0;		// slots in a leaf, 0 for inner nodes
+		std::size_t right = 0;		// right child of an inner node; the left child follows the node
+	};
+	struct BuildItem {
+		BoundingBox2D box;
+		double centerX;
+		double centerY;
+		std::size_t segment;
+	};
+
+	// Segment geometry in tree order; radius is 0 for lines
+	std::vector<MyPoint> pointA, pointB, center;
+	std::vector<double> radius, ccwStart, sweep;
+	std::vector<BoundingBox2D> boxes;
+	std::vector<std::size_t> segmentIndex;
+	std::vector<Node> nodes;
+
+	std::size_t build(std::vector<BuildItem>& items, std::size_t first, std::size_t last);
+	MyPoint closestInSlot(std::size_t slot, const MyPoint& p) const;
+
+public:
+	/**
+	* @brief Builds the tree over all segments of a contour.
+	* @param contour Contour to index; it is copied, so it may change afterwards.
+	*/
+	explicit SegmentTree2D(const Contour2D& contour);
+
+	/**
+	* @brief Finds the point of the contour nearest to a query point.
+	* @param p Query point; Z is ignored.
+	* @return Nearest point, its distance and its segment.
+	* @throws std::out_of_range If the contour has no segments.
+	*/
+	ClosestPoint closestPoint(const MyPoint& p) const;
+	/**
+	* @brief Returns the distance from a point to the contour.
+	* @param p Query point.
+	* @return Distance to the nearest point.
+	* @throws std::out_of_range If the contour has no segments.
+	*/
+	double distanceTo(const MyPoint& p) const { return closestPoint(p).distance; }
+	/**
+	* @brief Finds the nearest points for many queries, spread over the executor's threads.
+	* @param points Query points.
+	* @param executor Executor that runs the queries.
+	* @return One result per point.
+	* @throws std::out_of_range If the contour has no segments and points is not empty.
+	*/
+	std::vector<ClosestPoint> closestPoints(const std::vector<MyPoint>& points, const ParallelExecutor& executor = ParallelExecutor()) const;
+
+	/**
+	* @brief Calls visit for every pair of segments, one from each tree, whose boxes overlap.
+	*
+	* Descends both trees together and only opens node pairs whose boxes overlap, always
+	* splitting the node with the larger box. Leaf pairs then compare the exact boxes of
+	* their segments.
+	*
+	* @param other Tree of the second contour.
+	* @param margin Amount by which boxes are grown before testing them.
+	* @param visit Called as visit(segment of this tree, segment of other); returning
+	*        false stops the traversal.
+	* @return False if visit stopped the traversal, true otherwise.
+	*/
+	template <class Visit>
+	bool forEachOverlappingPair(const SegmentTree2D& other, double margin, Visit visit) const {
+		if (nodes.empty() || other.nodes.empty()) {
+			return true;
+		}
+		std::vector<std::pair<std::size_t, std::size_t>> stack;
+		stack.emplace_back(0, 0);
+		while (!stack.empty()) {
+			const std::size_t mine = stack.back().first;
+			const std::size_t theirs = stack.back().second;
+			stack.pop_back();
+			const Node& a = nodes[mine];
+			const Node& b = other.nodes[theirs];
+			if (!a.box.inflated(margin).intersects(b.box)) {
+				continue;
+			}
+			if (a.count > 0 && b.count > 0) {
+				for (std::size_t i = a.first; i < a.first + a.count; ++i) {
+					const BoundingBox2D grown = boxes[i].inflated(margin);
+					for (std::size_t j = b.first; j < b.first + b.count; ++j) {
+						if (grown.intersects(other.boxes[j]) && !visit(segmentIndex[i], other.segmentIndex[j])) {
+							return false;
+						}
+					}
+				}
+				continue;
+			}
+			const bool splitMine = b.count > 0
+				|| (a.count == 0 && a.box.getWidth() * a.box.getHeight() >= b.box.getWidth() * b.box.getHeight());
+			if (splitMine) {
+				stack.emplace_back(mine + 1, theirs);
+				stack.emplace_back(a.right, theirs);
+			}
+			else {
+				stack.emplace_back(mine, theirs + 1);
+				stack.emplace_back(mine, b.right);
+			}
+		}
+		return true;
+	}
+
+	/**
+	* @brief Returns the number of indexed segments.
+	* @return Segment count of the contour.
+	*/
+	std::size_t size() const { return segmentIndex.size(); }
+	/**
+	* @brief Returns the number of tree nodes.
+	* @return Node count; 0 for an empty contour.
+	*/
+	std::size_t getNodeCount() const { return nodes.size(); }
+	/**
+	* @brief Returns the box of the whole contour.
+	* @return Box of the root node; empty for an empty contour.
+	*/
+	BoundingBox2D getBoundingBox() const { return nodes.empty() ? BoundingBox2D() : nodes.front().box; }
+};
+
+/**
+* @brief Finds the point of a contour nearest to a query point.
+*
+* Walks the segments once and skips those whose cached box, from
+* Contour2D::segmentBoundingBoxes(), is farther away than the best point so far.
+* Prefer SegmentTree2D when the same contour is queried many times.
+*
+* @param contour Contour to search.
+* @param p Query point.
+* @return Nearest point, its distance and its segment.
+* @throws std::out_of_range If the contour has no segments.
+*/
+ClosestPoint closestPoint(const Contour2D& contour, const MyPoint& p);
+
+/**
+* @brief Returns the distance from a point to a contour.
+* @param contour Contour to measure against.
+* @param p Query point.
+* @return Distance to the nearest point of the contour.
+* @throws std::out_of_range If the contour has no segments.
+*/
+double distanceTo(const Contour2D& contour, const MyPoint& p);
+
+/**
+* @brief Finds the nearest contour points for many queries.
+*
+* Builds a SegmentTree2D once and spreads the points over the executor's threads.
+*
+* @param contour Contour to search.
+* @param points Query points.
+* @param executor Executor that runs the queries.
+* @return One result per point.
+* @throws std::out_of_range If the contour has no segments and points is not empty.
+*/
+std::vector<ClosestPoint> closestPoints(const Contour2D& contour, const std::vector<MyPoint>& points,
+	const ParallelExecutor& executor = ParallelExecutor());
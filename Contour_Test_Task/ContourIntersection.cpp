@@ -0,0 +1,318 @@
+/**
+ * @file ContourIntersection.cpp
+ * @brief Implements the self-intersection sweep and the tree-based pairwise search.
+ */
+#include "ContourIntersection.h"
+#include "PointContainment.h"
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <utility>
+
+namespace {
+
+	/**
+	 * @brief Y intervals of the boxes currently open in the sweep.
+	 *
+	 * A centered interval tree whose shape is fixed up front from every box's Y range. Each
+	 * interval belongs to the highest node whose center it contains, and a node keeps its
+	 * active intervals ordered both by lower and by upper end, so a query only touches
+	 * intervals that overlap it. Subtrees without active intervals are skipped, which keeps
+	 * a query at O((1 + k) log n) for k overlaps.
+	 */
+	class ActiveIntervals {
+	private:
+		using Entry = std::pair<double, std::size_t>;
+
+		static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+		struct Node {
+			double center = 0.0;
+			std::size_t left = npos;
+			std::size_t right = npos;
+			std::size_t parent = npos;
+			std::size_t active = 0;		///< Active intervals in this subtree.
+			std::set<Entry> byLow;
+			std::set<Entry> byHigh;
+		};
+
+		std::vector<Node> nodes;
+		std::vector<double> low;
+		std::vector<double> high;
+		std::vector<std::size_t> home;
+
+		std::size_t build(const std::vector<double>& centers, std::size_t first, std::size_t last, std::size_t parent) {
+			if (first >= last) {
+				return npos;
+			}
+			const std::size_t mid = first + (last - first) / 2;
+			const std::size_t index = nodes.size();
+			nodes.emplace_back();
+			nodes[index].center = centers[mid];
+			nodes[index].parent = parent;
+			const std::size_t left = build(centers, first, mid, index);
+			const std::size_t right = build(centers, mid + 1, last, index);
+			nodes[index].left = left;
+			nodes[index].right = right;
+			return index;
+		}
+
+		template <class Visit>
+		bool visitOverlaps(std::size_t index, double from, double to, Visit& visit) const {
+			if (index == npos || nodes[index].active == 0) {
+				return true;
+			}
+			const Node& node = nodes[index];
+			// Every interval stored here contains the center
+			if (to < node.center) {
+				for (auto it = node.byLow.begin(); it != node.byLow.end() && it->first <= to; ++it) {
+					if (!visit(it->second)) {
+						return false;
+					}
+				}
+				return visitOverlaps(node.left, from, to, visit);
+			}
+			if (from > node.center) {
+				for (auto it = node.byHigh.rbegin(); it != node.byHigh.rend() && it->first >= from; ++it) {
+					if (!visit(it->second)) {
+						return false;
+					}
+				}
+				return visitOverlaps(node.right, from, to, visit);
+			}
+			for (const Entry& entry : node.byLow) {
+				if (!visit(entry.second)) {
+					return false;
+				}
+			}
+			return visitOverlaps(node.left, from, to, visit) && visitOverlaps(node.right, from, to, visit);
+		}
+
+		void countActive(std::size_t index, bool added) {
+			for (; index != npos; index = nodes[index].parent) {
+				added ? ++nodes[index].active : --nodes[index].active;
+			}
+		}
+
+	public:
+		/**
+		 * @brief Prepares the tree for the intervals [low_[i], high_[i]]; none is active yet.
+		 */
+		ActiveIntervals(std::vector<double> low_, std::vector<double> high_) : low(std::move(low_)), high(std::move(high_)), home(low.size()) {
+			std::vector<double> centers(low);
+			centers.insert(centers.end(), high.begin(), high.end());
+			std::sort(centers.begin(), centers.end());
+			centers.erase(std::unique(centers.begin(), centers.end()), centers.end());
+			nodes.reserve(centers.size());
+			build(centers, 0, centers.size(), npos);
+			for (std::size_t i = 0; i < low.size(); ++i) {
+				// Descending towards low[i] always reaches a center inside the interval
+				std::size_t index = 0;
+				while (high[i] < nodes[index].center || low[i] > nodes[index].center) {
+					index = high[i] < nodes[index].center ? nodes[index].left : nodes[index].right;
+				}
+				home[i] = index;
+			}
+		}
+
+		void insert(std::size_t i) {
+			nodes[home[i]].byLow.emplace(low[i], i);
+			nodes[home[i]].byHigh.emplace(high[i], i);
+			countActive(home[i], true);
+		}
+
+		void erase(std::size_t i) {
+			nodes[home[i]].byLow.erase(Entry(low[i], i));
+			nodes[home[i]].byHigh.erase(Entry(high[i], i));
+			countActive(home[i], false);
+		}
+
+		/**
+		 * @brief Calls visit(i) for every active interval that overlaps [from, to].
+		 * @return False if visit asked to stop.
+		 */
+		template <class Visit>
+		bool forEachOverlap(double from, double to, Visit visit) const {
+			return nodes.empty() || visitOverlaps(0, from, to, visit);
+		}
+	};
+
+	/**
+	 * @brief Calls visit(i, j) for every pair of segments whose boxes overlap.
+	 *
+	 * Sweeps the boxes along X. Boxes that are open at the sweep position are kept in an
+	 * ActiveIntervals tree over Y, so each new box visits only the boxes it really overlaps
+	 * and the whole sweep runs in O((n + k) log n) for k overlapping pairs.
+	 * Stops as soon as visit returns false.
+	 */
+	template <class Visit>
+	void sweepOverlappingPairs(const std::vector<BoundingBox2D>& boxes, double epsilon, Visit visit) {
+		const std::size_t count = boxes.size();
+		std::vector<std::size_t> starts(count);
+		std::iota(starts.begin(), starts.end(), std::size_t(0));
+		std::sort(starts.begin(), starts.end(), [&boxes](std::size_t a, std::size_t b) {
+			return boxes[a].getMinX() < boxes[b].getMinX();
+		});
+		std::vector<std::size_t> ends(starts);
+		std::sort(ends.begin(), ends.end(), [&boxes](std::size_t a, std::size_t b) {
+			return boxes[a].getMaxX() < boxes[b].getMaxX();
+		});
+
+		// Widening every upper end by epsilon makes closed-interval overlap match the tolerance
+		std::vector<double> low(count);
+		std::vector<double> high(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			low[i] = boxes[i].getMinY();
+			high[i] = boxes[i].getMaxY() + epsilon;
+		}
+		ActiveIntervals active(std::move(low), std::move(high));
+
+		std::size_t nextEnd = 0;
+		for (std::size_t current : starts) {
+			const BoundingBox2D& box = boxes[current];
+			// Boxes that end before this one starts were all opened earlier
+			while (nextEnd < count && boxes[ends[nextEnd]].getMaxX() + epsilon < box.getMinX()) {
+				active.erase(ends[nextEnd++]);
+			}
+			const bool proceed = active.forEachOverlap(box.getMinY(), box.getMaxY() + epsilon, [&](std::size_t other) {
+				return visit(std::min(current, other), std::max(current, other));
+			});
+			if (!proceed) {
+				return;
+			}
+			active.insert(current);
+		}
+	}
+
+	/**
+	 * @brief Calls report(point) for every intersection of segments i < j of a contour,
+	 * skipping the joints consecutive segments share. Stops when report returns false.
+	 */
+	template <class Report>
+	bool reportPairIntersections(const Contour2D& contour, std::size_t i, std::size_t j, double epsilon, bool closed, Report report) {
+		const Segment2D& first = contour.getSegmentAt(i);
+		const Segment2D& second = contour.getSegmentAt(j);
+		const SegmentHits hits = intersectSegments(first, second, epsilon);
+		const bool sharesEnd = j == i + 1;
+		const bool sharesStart = closed && i == 0 && j == contour.getSegmentCount() - 1;
+		for (std::size_t k = 0; k < hits.count; ++k) {
+			const MyPoint& p = hits.points[k];
+			if ((sharesEnd && p.distanceTo_2D(first.getPointB()) <= epsilon)
+				|| (sharesStart && p.distanceTo_2D(first.getPointA()) <= epsilon)) {
+				continue;
+			}
+			if (!report(p)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool isClosed(const Contour2D& contour, double epsilon) {
+		const std::size_t count = contour.getSegmentCount();
+		return count >= 2
+			&& contour.getSegmentAt(count - 1).getPointB().distanceTo_2D(contour.getSegmentAt(0).getPointA()) <= epsilon;
+	}
+
+}
+
+std::vector<IntersectionPoint> findSelfIntersections(const Contour2D& contour, double epsilon) {
+	std::vector<IntersectionPoint> result;
+	if (contour.getSegmentCount() < 2) {
+		return result;
+	}
+	const bool closed = isClosed(contour, epsilon);
+	const std::shared_ptr<const std::vector<BoundingBox2D>> boxes = contour.segmentBoundingBoxes();
+	sweepOverlappingPairs(*boxes, epsilon, [&](std::size_t i, std::size_t j) {
+		return reportPairIntersections(contour, i, j, epsilon, closed, [&](const MyPoint& p) {
+			IntersectionPoint hit;
+			hit.first = i;
+			hit.second = j;
+			hit.point = p;
+			result.push_back(hit);
+			return true;
+		});
+	});
+	std::stable_sort(result.begin(), result.end(), [](const IntersectionPoint& a, const IntersectionPoint& b) {
+		return a.first != b.first ? a.first < b.first : a.second < b.second;
+	});
+	return result;
+}
+
+bool isSimple(const Contour2D& contour, double epsilon) {
+	if (contour.getSegmentCount() < 2) {
+		return true;
+	}
+	const bool closed = isClosed(contour, epsilon);
+	const std::shared_ptr<const std::vector<BoundingBox2D>> boxes = contour.segmentBoundingBoxes();
+	bool simple = true;
+	sweepOverlappingPairs(*boxes, epsilon, [&](std::size_t i, std::size_t j) {
+		return reportPairIntersections(contour, i, j, epsilon, closed, [&](const MyPoint&) {
+			simple = false;
+			return false;
+		});
+	});
+	return simple;
+}
+
+bool outlinesIntersect(const Contour2D& a, const Contour2D& b, double epsilon) {
+	if (!a.boundingBox().inflated(epsilon).intersects(b.boundingBox())) {
+		return false;
+	}
+	return outlinesIntersect(a, SegmentTree2D(a), b, SegmentTree2D(b), epsilon);
+}
+
+bool outlinesIntersect(const Contour2D& a, const SegmentTree2D& treeA, const Contour2D& b, const SegmentTree2D& treeB, double epsilon) {
+	return !treeA.forEachOverlappingPair(treeB, epsilon, [&](std::size_t i, std::size_t j) {
+		return intersectSegments(a.getSegmentAt(i), b.getSegmentAt(j), epsilon).count == 0;
+	});
+}
+
+namespace {
+	// Called once the outlines are known to be apart
+	bool eitherContainsTheOther(const Contour2D& a, const Contour2D& b) {
+		if (a.getSegmentCount() == 0 || b.getSegmentCount() == 0) {
+			return false;
+		}
+		return containsPoint(b, a.getSegmentAt(0).getPointA()) || containsPoint(a, b.getSegmentAt(0).getPointA());
+	}
+}
+
+bool overlaps(const Contour2D& a, const Contour2D& b, double epsilon) {
+	if (!a.boundingBox().inflated(epsilon).intersects(b.boundingBox())) {
+		return false;
+	}
+	return overlaps(a, SegmentTree2D(a), b, SegmentTree2D(b), epsilon);
+}
+
+bool overlaps(const Contour2D& a, const SegmentTree2D& treeA, const Contour2D& b, const SegmentTree2D& treeB, double epsilon) {
+	return outlinesIntersect(a, treeA, b, treeB, epsilon) || eitherContainsTheOther(a, b);
+}
+
+std::vector<IntersectionPoint> intersections(const Contour2D& a, const Contour2D& b, double epsilon) {
+	if (!a.boundingBox().inflated(epsilon).intersects(b.boundingBox())) {
+		return std::vector<IntersectionPoint>();
+	}
+	return intersections(a, SegmentTree2D(a), b, SegmentTree2D(b), epsilon);
+}
+
+std::vector<IntersectionPoint> intersections(const Contour2D& a, const SegmentTree2D& treeA, const Contour2D& b,
+	const SegmentTree2D& treeB, double epsilon) {
+
+	std::vector<IntersectionPoint> result;
+	treeA.forEachOverlappingPair(treeB, epsilon, [&](std::size_t i, std::size_t j) {
+		const SegmentHits hits = intersectSegments(a.getSegmentAt(i), b.getSegmentAt(j), epsilon);
+		for (std::size_t k = 0; k < hits.count; ++k) {
+			IntersectionPoint hit;
+			hit.first = i;
+			hit.second = j;
+			hit.point = hits.points[k];
+			result.push_back(hit);
+		}
+		return true;
+	});
+	std::stable_sort(result.begin(), result.end(), [](const IntersectionPoint& x, const IntersectionPoint& y) {
+		return x.first != y.first ? x.first < y.first : x.second < y.second;
+	});
+	return result;
+}
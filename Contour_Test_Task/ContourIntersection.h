@@ -0,0 +1,125 @@
+/**
+ * @file ContourIntersection.h
+ * @brief Self- and pairwise intersection queries for contours of lines and arcs.
+ */
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "Contour2D.h"
+#include "SegmentIntersection.h"
+#include "ContourDistance.h"
+
+ /**
+ * @struct IntersectionPoint
+ * @brief A point where two segments meet.
+ */
+struct IntersectionPoint {
+	std::size_t first = 0;	///< Index of the first segment.
+	std::size_t second = 0;	///< Index of the second segment.
+	MyPoint point;			///< Location of the intersection.
+};
+
+/**
+* @brief Finds every point where a contour crosses or touches itself.
+*
+* Sweeps the exact segment boxes, from Contour2D::segmentBoundingBoxes(), along X. The
+* boxes open at the sweep position are kept in an interval tree over Y, so each box is
+* paired only with the boxes it overlaps, in O((n + k) log n) for k overlapping pairs.
+* Pairs are tested with intersectSegments(). Consecutive segments, including the last and first of a closed
+* contour, are not reported for the joint they share, but are reported if they meet
+* anywhere else, e.g. when a line doubles back over its predecessor.
+*
+* @param contour Contour to check.
+* @param epsilon Distance tolerance for contacts and joints.
+* @return Intersections with first < second, ordered by first, then second.
+*/
+std::vector<IntersectionPoint> findSelfIntersections(const Contour2D& contour, double epsilon = Contour2D::defaultEpsilon);
+
+/**
+* @brief Tells whether a contour is free of self-intersections.
+*
+* Runs the same sweep as findSelfIntersections() but stops at the first intersection.
+* Joint continuity is not checked; combine with Contour2D::isValid() for that.
+*
+* @param contour Contour to check.
+* @param epsilon Distance tolerance for contacts and joints.
+* @return True if no two segments meet except at their shared joints.
+*/
+bool isSimple(const Contour2D& contour, double epsilon = Contour2D::defaultEpsilon);
+
+/**
+* @brief Tells whether the outlines of two contours meet.
+*
+* Rejects contours whose cached boxes are apart, then descends the segment trees of
+* both contours together and stops at the first segment pair that intersects. This is
+* an outline-only test: a contour nested inside another without touching it does not
+* count. Use overlaps() to check parts for overlap.
+*
+* @param a First contour.
+* @param b Second contour.
+* @param epsilon Distance tolerance for contacts.
+* @return True if some segment of a meets some segment of b.
+*/
+bool outlinesIntersect(const Contour2D& a, const Contour2D& b, double epsilon = Contour2D::defaultEpsilon);
+
+/**
+* @brief Tells whether the outlines of two contours meet, reusing prebuilt trees.
+*
+* Use this form when one contour is tested against many others, so each tree is built once.
+*
+* @param a First contour.
+* @param treeA Segment tree built from a.
+* @param b Second contour.
+* @param treeB Segment tree built from b.
+* @param epsilon Distance tolerance for contacts.
+* @return True if some segment of a meets some segment of b.
+*/
+bool outlinesIntersect(const Contour2D& a, const SegmentTree2D& treeA, const Contour2D& b, const SegmentTree2D& treeB,
+	double epsilon = Contour2D::defaultEpsilon);
+
+/**
+* @brief Tells whether two closed contours overlap, including when one lies inside the other.
+*
+* Runs outlinesIntersect() first. If the outlines are apart, each contour lies either
+* wholly inside or wholly outside the other, so one containsPoint() test of a vertex
+* each way settles it.
+*
+* @param a First contour.
+* @param b Second contour.
+* @param epsilon Distance tolerance for contacts.
+* @return True if the outlines meet or one contour encloses the other.
+*/
+bool overlaps(const Contour2D& a, const Contour2D& b, double epsilon = Contour2D::defaultEpsilon);
+
+/**
+* @brief Tells whether two closed contours overlap, reusing prebuilt trees.
+* @param a First contour.
+* @param treeA Segment tree built from a.
+* @param b Second contour.
+* @param treeB Segment tree built from b.
+* @param epsilon Distance tolerance for contacts.
+* @return True if the outlines meet or one contour encloses the other.
+*/
+bool overlaps(const Contour2D& a, const SegmentTree2D& treeA, const Contour2D& b, const SegmentTree2D& treeB,
+	double epsilon = Contour2D::defaultEpsilon);
+
+/**
+* @brief Finds every point where the outlines of two contours meet.
+* @param a First contour.
+* @param b Second contour.
+* @param epsilon Distance tolerance for contacts.
+* @return Intersections with first indexing a and second indexing b, ordered by first, then second.
+*/
+std::vector<IntersectionPoint> intersections(const Contour2D& a, const Contour2D& b, double epsilon = Contour2D::defaultEpsilon);
+
+/**
+* @brief Finds every point where the outlines of two contours meet, reusing prebuilt trees.
+* @param a First contour.
+* @param treeA Segment tree built from a.
+* @param b Second contour.
+* @param treeB Segment tree built from b.
+* @param epsilon Distance tolerance for contacts.
+* @return Intersections with first indexing a and second indexing b, ordered by first, then second.
+*/
+std::vector<IntersectionPoint> intersections(const Contour2D& a, const SegmentTree2D& treeA, const Contour2D& b,
+	const SegmentTree2D& treeB, double epsilon = Contour2D::defaultEpsilon);
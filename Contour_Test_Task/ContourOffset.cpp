@@ -0,0 +1,215 @@
+/**
+ * @file ContourOffset.cpp
+ * @brief Implements segment offsetting, corner joining and self-intersection cleanup.
+ */
+#include "ContourOffset.h"
+#include "LineSegment2D.h"
+#include "ArcSegment2D.h"
+#include "ContourIntersection.h"
+#include "ContourDistance.h"
+#include "ContourPieces.h"
+#include "PreparedContour2D.h"
+#include <stdexcept>
+#include <limits>
+#include <cmath>
+
+namespace {
+
+	/**
+	 * @brief Offset of one original segment, with the points it is trimmed to.
+	 */
+	struct OffsetPart {
+		std::unique_ptr<Segment2D> segment;
+		MyPoint from;			// start after trimming
+		MyPoint to;				// end after trimming
+		bool collapsed = false;	// arc whose radius fell to zero; segment is the original chord
+	};
+
+	/**
+	 * @brief Moves a segment sideways; positive distances move to the right of travel.
+	 */
+	OffsetPart offsetSegment(const Segment2D& seg, double distance, double epsilon) {
+		OffsetPart part;
+		if (seg.getKind() == SegmentKind::Arc) {
+			const ArcSegment2D& arc = static_cast<const ArcSegment2D&>(seg);
+			// Travelling counter-clockwise, the center is on the left, so moving right grows the radius
+			const double r = arc.isCounterClockwise() ? arc.getRadius() + distance : arc.getRadius() - distance;
+			if (r <= epsilon) {
+				part.segment = std::make_unique<LineSegment2D>(seg.getPointA(), seg.getPointB());
+				part.collapsed = true;
+			}
+			else {
+				const double scale = r / arc.getRadius();
+				const MyPoint& c = arc.getCenter();
+				const MyPoint a(c.getX() + (arc.getPointA().getX() - c.getX()) * scale, c.getY() + (arc.getPointA().getY() - c.getY()) * scale);
+				const MyPoint b(c.getX() + (arc.getPointB().getX() - c.getX()) * scale, c.getY() + (arc.getPointB().getY() - c.getY()) * scale);
+				part.segment = std::make_unique<ArcSegment2D>(a, b, c, r, arc.getStartAngle(), arc.getEndAngle(),
+					arc.isClockwise(), arc.isCounterClockwise());
+			}
+		}
+		else {
+			const MyPoint t = seg.tangentAtLength(0.0);
+			const double nx = t.getY() * distance;
+			const double ny = -t.getX() * distance;
+			part.segment = std::make_unique<LineSegment2D>(MyPoint(seg.getPointA().getX() + nx, seg.getPointA().getY() + ny),
+				MyPoint(seg.getPointB().getX() + nx, seg.getPointB().getY() + ny));
+		}
+		part.from = part.segment->getPointA();
+		part.to = part.segment->getPointB();
+		return part;
+	}
+
+	/**
+	 * @brief Arc of radius |distance| around a vertex, from the end of one offset to the start of the next.
+	 */
+	std::unique_ptr<Segment2D> joiningArc(const MyPoint& vertex, const MyPoint& from, const MyPoint& to, double distance) {
+		const double startAngle = std::atan2(from.getY() - vertex.getY(), from.getX() - vertex.getX());
+		const double endAngle = std::atan2(to.getY() - vertex.getY(), to.getX() - vertex.getX());
+		if (distance > 0) {
+			return std::make_unique<ArcSegment2D>(vertex, distance, startAngle, endAngle);
+		}
+		auto arc = std::make_unique<ArcSegment2D>(vertex, -distance, endAngle, startAngle);
+		arc->reverse();
+		return arc;
+	}
+
+	enum class CornerKind : unsigned char { Touching, Join, Trim, Connect };
+
+	/**
+	 * @brief Appends a segment unless it is shorter than epsilon.
+	 */
+	void appendSegment(Contour2D& raw, std::unique_ptr<Segment2D> seg, double epsilon) {
+		if (seg->getPointA().distanceTo_2D(seg->getPointB()) > epsilon || seg->getLength() > epsilon) {
+			raw.addSegment(std::move(seg));
+		}
+	}
+
+	/**
+	 * @brief Builds the raw offset curve: offset segments with their corner joins, trims and connectors.
+	 */
+	Contour2D rawOffset(const Contour2D& source, double distance, double epsilon) {
+		std::vector<const Segment2D*> segments;
+		segments.reserve(source.getSegmentCount());
+		for (const auto& seg : source) {
+			if (seg.getLength() > epsilon) {
+				segments.push_back(&seg);
+			}
+		}
+		const std::size_t count = segments.size();
+		std::vector<OffsetPart> parts;
+		parts.reserve(count);
+		for (const Segment2D* seg : segments) {
+			parts.push_back(offsetSegment(*seg, distance, epsilon));
+		}
+
+		// Decide every corner first, because trimming moves the ends of both neighbours
+		std::vector<CornerKind> corners(count, CornerKind::Connect);
+		for (std::size_t i = 0; i < count; ++i) {
+			OffsetPart& current = parts[i];
+			OffsetPart& next = parts[(i + 1) % count];
+			if (current.segment->getPointB().distanceTo_2D(next.segment->getPointA()) <= epsilon) {
+				corners[i] = CornerKind::Touching;
+				continue;
+			}
+			if (current.collapsed || next.collapsed) {
+				continue;
+			}
+			const Segment2D& before = *segments[i];
+			const Segment2D& after = *segments[(i + 1) % count];
+			const MyPoint out = before.tangentAtLength(before.getLength());
+			const MyPoint in = after.tangentAtLength(0.0);
+			const double turn = out.getX() * in.getY() - out.getY() * in.getX();
+			if (turn * distance > 0) {
+				corners[i] = CornerKind::Join;
+				continue;
+			}
+			const SegmentHits hits = intersectSegments(*current.segment, *next.segment, epsilon);
+			const MyPoint& vertex = before.getPointB();
+			double best = std::numeric_limits<double>::infinity();
+			for (std::size_t k = 0; k < hits.count; ++k) {
+				const double d = hits.points[k].distanceTo_2D(vertex);
+				if (d < best) {
+					best = d;
+					current.to = hits.points[k];
+					next.from = hits.points[k];
+					corners[i] = CornerKind::Trim;
+				}
+			}
+		}
+
+		Contour2D raw;
+		for (std::size_t i = 0; i < count; ++i) {
+			const OffsetPart& part = parts[i];
+			const Segment2D& seg = *part.segment;
+			const bool trimmed = part.from.distanceTo_2D(seg.getPointA()) > 0 || part.to.distanceTo_2D(seg.getPointB()) > 0;
+			if (!trimmed) {
+				appendSegment(raw, seg.clone(), epsilon);
+			}
+			else if (seg.lengthAtPoint(part.from) < seg.lengthAtPoint(part.to) - epsilon) {
+				appendSegment(raw, seg.subSegment(part.from, part.to), epsilon);
+			}
+			else {
+				// Both trims overshot each other: keep the chain closed, cleanup removes the loop
+				appendSegment(raw, std::make_unique<LineSegment2D>(part.from, part.to), epsilon);
+			}
+
+			const OffsetPart& next = parts[(i + 1) % count];
+			const MyPoint& vertex = segments[i]->getPointB();
+			switch (corners[i]) {
+			case CornerKind::Join:
+				appendSegment(raw, joiningArc(vertex, part.to, next.from, distance), epsilon);
+				break;
+			case CornerKind::Connect:
+				// Detour through the original vertex; these pieces lie closer than the distance and are dropped later
+				appendSegment(raw, std::make_unique<LineSegment2D>(part.to, vertex), epsilon);
+				appendSegment(raw, std::make_unique<LineSegment2D>(vertex, next.from), epsilon);
+				break;
+			default:
+				break;
+			}
+		}
+		return raw;
+	}
+
+}
+
+std::vector<Contour2D> offsetContour(const Contour2D& contour, double distance, double epsilon) {
+	if (!isClosedContour(contour, epsilon)) {
+		throw std::invalid_argument("Contour must be closed in offsetContour()");
+	}
+	Contour2D source(contour);
+	if (source.orientation() == Orientation::Clockwise) {
+		source.reverse();
+	}
+	std::vector<Contour2D> result;
+	// Within epsilon of the source every piece of the raw offset would fail the distance test
+	if (std::abs(distance) <= epsilon) {
+		result.push_back(std::move(source));
+		return result;
+	}
+
+	// Counter-clockwise contours have the region on their left, so outward is to the right
+	const Contour2D raw = rawOffset(source, distance, epsilon);
+	if (raw.getSegmentCount() == 0) {
+		return result;
+	}
+	const std::vector<IntersectionPoint> crossings = findSelfIntersections(raw, epsilon);
+	std::vector<std::vector<MyPoint>> cuts(raw.getSegmentCount());
+	for (const IntersectionPoint& hit : crossings) {
+		cuts[hit.first].push_back(hit.point);
+		cuts[hit.second].push_back(hit.point);
+	}
+
+	const SegmentTree2D tree(source);
+	const PreparedContour2D region(source, epsilon);
+	const double reach = std::abs(distance) - epsilon;
+	const PointLocation side = distance > 0 ? PointLocation::Outside : PointLocation::Inside;
+	std::vector<std::unique_ptr<Segment2D>> kept;
+	for (auto& piece : splitSegments(raw, cuts, epsilon)) {
+		const MyPoint middle = piece->pointAtLength(0.5 * piece->getLength());
+		if (tree.closestPoint(middle).distance >= reach && region.locate(middle) == side) {
+			kept.push_back(std::move(piece));
+		}
+	}
+	return chainLoops(kept, epsilon);
+}
@@ -0,0 +1,31 @@
+/**
+ * @file ContourOffset.h
+ * @brief Arc-preserving offsetting of closed line/arc contours.
+ */
+#pragma once
+#include <vector>
+#include "Contour2D.h"
+
+/**
+* @brief Offsets the region bounded by a closed contour by a signed distance.
+*
+* Every line moves sideways to a parallel line and every arc to a concentric arc, so no
+* segment is flattened. Where neighbouring offsets separate, at convex corners of an
+* outward offset and concave corners of an inward one, they are joined by an arc of
+* radius |distance| around the original vertex. Where they overlap they are trimmed at
+* their intersection. Arcs whose radius would drop to zero are replaced by connectors.
+*
+* The raw result may still cross itself where features are narrower than twice the
+* distance. It is split at its self-intersections, found by the sweep in
+* findSelfIntersections(), and only pieces lying at the full distance from the original
+* contour, on the correct side, are chained into the result. A distance no larger than
+* epsilon returns the contour itself, oriented counter-clockwise.
+*
+* @param contour Closed, simple contour; its orientation does not matter.
+* @param distance Offset distance; positive grows the region, negative shrinks it.
+* @param epsilon Distance tolerance for joints, trimming and cleanup.
+* @return Boundary loops of the offset region, outer loops counter-clockwise and holes
+*         clockwise; empty if an inward offset removes the whole region.
+* @throws std::invalid_argument If the contour is empty or not closed.
+*/
+std::vector<Contour2D> offsetContour(const Contour2D& contour, double distance, double epsilon = Contour2D::defaultEpsilon);
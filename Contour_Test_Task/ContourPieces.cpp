@@ -0,0 +1,95 @@
+/**
+ * @file ContourPieces.cpp
+ * @brief Implements splitting of contours into pieces and chaining of pieces into loops.
+ */
+#include "ContourPieces.h"
+#include <algorithm>
+
+std::vector<std::unique_ptr<Segment2D>> splitSegments(const Contour2D& contour, const std::vector<std::vector<MyPoint>>& cuts, double epsilon) {
+	std::vector<std::unique_ptr<Segment2D>> pieces;
+	pieces.reserve(contour.getSegmentCount());
+	std::vector<std::pair<double, MyPoint>> ordered;
+	for (std::size_t i = 0; i < contour.getSegmentCount(); ++i) {
+		const Segment2D& seg = contour.getSegmentAt(i);
+		ordered.clear();
+		for (const MyPoint& p : cuts[i]) {
+			ordered.emplace_back(seg.lengthAtPoint(p), p);
+		}
+		std::sort(ordered.begin(), ordered.end(), [](const std::pair<double, MyPoint>& x, const std::pair<double, MyPoint>& y) {
+			return x.first < y.first;
+		});
+		const double length = seg.getLength();
+		MyPoint from = seg.getPointA();
+		double fromLength = 0.0;
+		bool split = false;
+		for (const auto& cut : ordered) {
+			if (cut.first - fromLength <= epsilon || cut.first >= length - epsilon) {
+				continue;
+			}
+			pieces.push_back(seg.subSegment(from, cut.second));
+			from = cut.second;
+			fromLength = cut.first;
+			split = true;
+		}
+		pieces.push_back(split ? seg.subSegment(from, seg.getPointB()) : seg.clone());
+	}
+	return pieces;
+}
+
+std::vector<Contour2D> chainLoops(std::vector<std::unique_ptr<Segment2D>>& pieces, double epsilon) {
+	std::sort(pieces.begin(), pieces.end(), [](const std::unique_ptr<Segment2D>& x, const std::unique_ptr<Segment2D>& y) {
+		return x->getPointA().getX() < y->getPointA().getX();
+	});
+	// Start points are copied out because pieces are moved into the loops as they are used
+	std::vector<MyPoint> starts;
+	starts.reserve(pieces.size());
+	for (const auto& piece : pieces) {
+		starts.push_back(piece->getPointA());
+	}
+	std::vector<char> used(pieces.size(), 0);
+	auto findSuccessor = [&](const MyPoint& end) {
+		auto low = std::lower_bound(starts.begin(), starts.end(), end.getX() - epsilon,
+			[](const MyPoint& start, double x) { return start.getX() < x; });
+		for (std::size_t k = static_cast<std::size_t>(low - starts.begin()); k < starts.size(); ++k) {
+			if (starts[k].getX() > end.getX() + epsilon) {
+				break;
+			}
+			if (!used[k] && starts[k].distanceTo_2D(end) <= epsilon) {
+				return k;
+			}
+		}
+		return pieces.size();
+	};
+
+	std::vector<Contour2D> loops;
+	for (std::size_t first = 0; first < pieces.size(); ++first) {
+		if (used[first]) {
+			continue;
+		}
+		used[first] = 1;
+		const MyPoint origin = starts[first];
+		MyPoint end = pieces[first]->getPointB();
+		Contour2D loop;
+		loop.addSegment(std::move(pieces[first]));
+		bool closed = end.distanceTo_2D(origin) <= epsilon;
+		while (!closed) {
+			const std::size_t next = findSuccessor(end);
+			if (next == pieces.size()) {
+				break;
+			}
+			used[next] = 1;
+			end = pieces[next]->getPointB();
+			loop.addSegment(std::move(pieces[next]));
+			closed = end.distanceTo_2D(origin) <= epsilon;
+		}
+		if (closed) {
+			loops.push_back(std::move(loop));
+		}
+	}
+	return loops;
+}
+
+bool isClosedContour(const Contour2D& contour, double epsilon) {
+	const std::size_t count = contour.getSegmentCount();
+	return count > 0 && contour.getSegmentAt(count - 1).getPointB().distanceTo_2D(contour.getSegmentAt(0).getPointA()) <= epsilon;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file ContourPieces.h
+ * @brief Splitting contours into pieces and chaining pieces back into loops.
+ *
+ * Shared by the operations that rebuild outlines from parts of other outlines, such as
+ * booleanOperation() and offsetContour().
+ */
+#pragma once
+#include <vector>
+#include <memory>
+#include "Contour2D.h"
+
+/**
+* @brief Splits every segment of a contour at given points.
+*
+* Cuts within epsilon of a segment end or of the previous cut are skipped, so a cut at a
+* vertex does not produce zero-length pieces. Segments without cuts are cloned.
+*
+* @param contour Contour to split.
+* @param cuts For each segment, points on it where it is to be split, in any order.
+* @param epsilon Minimum piece length.
+* @return Pieces in contour order.
+*/
+std::vector<std::unique_ptr<Segment2D>> splitSegments(const Contour2D& contour, const std::vector<std::vector<MyPoint>>& cuts, double epsilon);
+
+/**
+* @brief Chains pieces end to start into closed loops.
+*
+* Pieces are sorted by the X of their start point, so the successor of a piece is
+* searched for in a narrow window. Where several pieces start at the same point the
+* first unused one is taken. Chains that cannot be closed are dropped.
+*
+* @param pieces Pieces to chain; they are moved into the loops.
+* @param epsilon Distance within which an end meets a start.
+* @return Closed loops.
+*/
+std::vector<Contour2D> chainLoops(std::vector<std::unique_ptr<Segment2D>>& pieces, double epsilon);
+
+/**
+* @brief Tells whether a contour has segments and ends where it starts.
+* @param contour Contour to check.
+* @param epsilon Distance tolerance between the end and the start.
+* @return True if closed.
+*/
+bool isClosedContour(const Contour2D& contour, double epsilon);
@@ -0,0 +1,153 @@
+/**
+ * @file ContourSet.cpp
+ * @brief Implements ContourView queries and ContourSet batch operations.
+ */
+#include "ContourSet.h"
+
+bool ContourView::isValid() const {
+	return segments->isContinuous(first, last, ContourSet::defaultEpsilon);
+}
+
+bool ContourView::isClosedShape() const {
+	return isValid() && segments->isClosed(first, last, ContourSet::defaultEpsilon);
+}
+
+double ContourView::getLength() const {
+	double total = 0.0;
+	for (std::size_t i = first; i < last; ++i) {
+		total += segments->getLength(i);
+	}
+	return total;
+}
+
+SegmentKind ContourView::getKindAt(std::size_t index) const {
+	if (index >= getSegmentCount()) {
+		throw std::out_of_range("Invalid index in getKindAt()");
+	}
+	return segments->kinds[first + index];
+}
+
+MyPoint ContourView::getPointAAt(std::size_t index) const {
+	if (index >= getSegmentCount()) {
+		throw std::out_of_range("Invalid index in getPointAAt()");
+	}
+	return segments->getPointA(first + index);
+}
+
+MyPoint ContourView::getPointBAt(std::size_t index) const {
+	if (index >= getSegmentCount()) {
+		throw std::out_of_range("Invalid index in getPointBAt()");
+	}
+	return segments->getPointB(first + index);
+}
+
+std::unique_ptr<Segment2D> ContourView::getSegmentCopyAt(std::size_t index) const {
+	if (index >= getSegmentCount()) {
+		throw std::out_of_range("Invalid index in getSegmentCopyAt()");
+	}
+	return segments->makeSegment(first + index);
+}
+
+Contour2D ContourView::toContour2D() const {
+	Contour2D contour;
+	for (std::size_t i = first; i < last; ++i) {
+		contour.addSegment(segments->makeSegment(i));
+	}
+	return contour;
+}
+
+void ContourSet::reserve(std::size_t contourCount, std::size_t segmentCount) {
+	offsets.reserve(contourCount + 1);
+	bounds.reserve(contourCount);
+	segments.reserve(segmentCount);
+}
+
+std::size_t ContourSet::addContour(const Contour2D& contour) {
+	for (const auto& seg : contour) {
+		segments.append(seg);
+	}
+	bounds.push_back(segments.getBoundingBox(offsets.back(), segments.size()));
+	offsets.push_back(segments.size());
+	return size() - 1;
+}
+
+std::size_t ContourSet::addContour(const FlatContour2D& contour) {
+	const SegmentArrays2D& source = contour.getArrays();
+	segments.appendRange(source, 0, source.size());
+	bounds.push_back(segments.getBoundingBox(offsets.back(), segments.size()));
+	offsets.push_back(segments.size());
+	return size() - 1;
+}
+
+void ContourSet::clear() {
+	segments.clear();
+	offsets.assign(1, 0);
+	bounds.clear();
+}
+
+ContourView ContourSet::getContourAt(std::size_t index) const {
+	if (index >= size()) {
+		throw std::out_of_range("Invalid index in getContourAt()");
+	}
+	return (*this)[index];
+}
+
+std::vector<bool> ContourSet::areValid() const {
+	std::vector<bool> result(size());
+	for (std::size_t c = 0; c < size(); ++c) {
+		result[c] = segments.isContinuous(offsets[c], offsets[c + 1], defaultEpsilon);
+	}
+	return result;
+}
+
+std::vector<bool> ContourSet::areClosedShapes() const {
+	std::vector<bool> result(size());
+	for (std::size_t c = 0; c < size(); ++c) {
+		result[c] = segments.isContinuous(offsets[c], offsets[c + 1], defaultEpsilon)
+			&& segments.isClosed(offsets[c], offsets[c + 1], defaultEpsilon);
+	}
+	return result;
+}
+
+std::vector<double> ContourSet::getLengths() const {
+	std::vector<double> result(size(), 0.0);
+	for (std::size_t c = 0; c < size(); ++c) {
+		for (std::size_t i = offsets[c]; i < offsets[c + 1]; ++i) {
+			result[c] += segments.getLength(i);
+		}
+	}
+	return result;
+}
+
+std::vector<double> ContourSet::getSignedAreas() const {
+	std::vector<double> result(size());
+	for (std::size_t c = 0; c < size(); ++c) {
+		result[c] = segments.signedArea(offsets[c], offsets[c + 1]);
+	}
+	return result;
+}
+
+std::vector<std::size_t> ContourSet::findIntersecting(const BoundingBox2D& window) const {
+	std::vector<std::size_t> result;
+	for (std::size_t c = 0; c < size(); ++c) {
+		if (bounds[c].intersects(window)) {
+			result.push_back(c);
+		}
+	}
+	return result;
+}
+
+void ContourSet::move(double dx, double dy) {
+	segments.move(0, segments.size(), dx, dy);
+	for (auto& box : bounds) {
+		box.move(dx, dy);
+	}
+}
+
+void ContourSet::move(std::size_t index, double dx, double dy) {
+	if (index >= size()) {
+		throw std::out_of_range("Invalid index in move()");
+	}
+	segments.move(offsets[index], offsets[index + 1], dx, dy);
+	bounds[index].move(dx, dy);
+}
@@ -0,0 +1,234 @@
+/**
+ * @file ContourSet.h
+ * @brief Defines a flat container that packs many contours into shared segment arrays.
+ *
+ * All segments of all contours live in one SegmentArrays2D, and an offsets table marks where
+ * each contour starts. Batch queries walk the arrays once for the whole set.
+ */
+#pragma once
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include "SegmentArrays2D.h"
+#include "Contour2D.h"
+#include "FlatContour2D.h"
+
+ /**
+ * @class ContourView
+ * @brief Lightweight read-only view of one contour inside a ContourSet.
+ *
+ * Offers the query side of the Contour2D interface. A view stays valid until the owning
+ * ContourSet is modified or destroyed.
+ */
+class ContourView {
+private:
+	const SegmentArrays2D* segments;
+	std::size_t first;
+	std::size_t last;
+
+public:
+	/**
+	* @brief Creates a view of segments [first_, last_) of the given arrays.
+	* @param segments_ Arrays owned by a ContourSet.
+	* @param first_ Index of the first segment of the contour.
+	* @param last_ One past the index of the last segment of the contour.
+	*/
+	ContourView(const SegmentArrays2D& segments_, std::size_t first_, std::size_t last_)
+		: segments(&segments_), first(first_), last(last_) {}
+
+	/**
+	* @brief Returns the number of segments in the contour.
+	* @return Number of segments.
+	*/
+	size_t getSegmentCount() const { return last - first; }
+	/**
+	* @brief Checks whether the contour is valid (continuous).
+	* @return True if all segments are connected within epsilon.
+	*/
+	bool isValid() const;
+	/**
+	* @brief Determines whether the contour forms a closed shape.
+	* @return True if the contour is valid and its ends meet within epsilon.
+	*/
+	bool isClosedShape() const;
+	/**
+	* @brief Returns the summed length of all segments.
+	* @return Contour length.
+	*/
+	double getLength() const;
+	/**
+	* @brief Returns the signed area enclosed by the contour.
+	* @return Signed area, positive for counter-clockwise contours.
+	*/
+	double getSignedArea() const { return segments->signedArea(first, last); }
+	/**
+	* @brief Returns the exact bounding box of the contour.
+	* @return Bounding box; empty for a contour without segments.
+	*/
+	BoundingBox2D getBoundingBox() const { return segments->getBoundingBox(first, last); }
+	/**
+	* @brief Returns the kind of the segment at the given index.
+	* @param index Index of the segment within the contour.
+	* @return Segment kind.
+	*/
+	SegmentKind getKindAt(std::size_t index) const;
+	/**
+	* @brief Returns the start point of the segment at the given index.
+	* @param index Index of the segment within the contour.
+	* @return Point A of the segment.
+	*/
+	MyPoint getPointAAt(std::size_t index) const;
+	/**
+	* @brief Returns the end point of the segment at the given index.
+	* @param index Index of the segment within the contour.
+	* @return Point B of the segment.
+	*/
+	MyPoint getPointBAt(std::size_t index) const;
+	/**
+	* @brief Returns a standalone copy of the segment at the given index.
+	* @param index Index of the segment within the contour.
+	* @return A unique_ptr to the rebuilt segment.
+	*/
+	std::unique_ptr<Segment2D> getSegmentCopyAt(std::size_t index) const;
+	/**
+	* @brief Copies the viewed contour into a Contour2D.
+	* @return A Contour2D holding equivalent segments.
+	*/
+	Contour2D toContour2D() const;
+	/**
+	* @brief Returns the index of the contour's first segment in the shared arrays.
+	* @return Offset into getArrays().
+	*/
+	std::size_t getFirstSegment() const { return first; }
+	/**
+	* @brief Gives read access to the shared arrays for batch kernels.
+	* @return Const reference to the segment arrays.
+	*/
+	const SegmentArrays2D& getArrays() const { return *segments; }
+};
+
+ /**
+ * @class ContourSet
+ * @brief Packs the segments of many contours into contiguous shared arrays.
+ *
+ * Contour i owns segments [offsets[i], offsets[i + 1]) of the shared arrays. Contours are
+ * appended by copy and accessed through ContourView. Batch operations process the whole set
+ * in a single pass. The bounding box of every contour is kept alongside the offsets and
+ * shifted by move(), so broad-phase queries never touch segment data.
+ */
+class ContourSet {
+private:
+	SegmentArrays2D segments;
+	std::vector<std::size_t> offsets = std::vector<std::size_t>(1, 0);
+	std::vector<BoundingBox2D> bounds;
+
+public:
+
+	static constexpr double defaultEpsilon = Contour2D::defaultEpsilon;
+	/**
+	* @brief Default constructor.
+	*/
+	ContourSet() = default;
+	/**
+	* @brief Reserves storage for contours and segments.
+	* @param contourCount Expected number of contours.
+	* @param segmentCount Expected total number of segments.
+	*/
+	void reserve(std::size_t contourCount, std::size_t segmentCount);
+	/**
+	* @brief Appends a copy of a contour.
+	* @param contour Contour2D to copy.
+	* @return Index of the new contour.
+	*/
+	std::size_t addContour(const Contour2D& contour);
+	/**
+	* @brief Appends a copy of a flat contour.
+	* @param contour FlatContour2D to copy.
+	* @return Index of the new contour.
+	*/
+	std::size_t addContour(const FlatContour2D& contour);
+	/**
+	* @brief Removes all contours.
+	*/
+	void clear();
+	/**
+	* @brief Returns the number of contours in the set.
+	* @return Contour count.
+	*/
+	std::size_t size() const { return offsets.size() - 1; }
+	/**
+	* @brief Returns the total number of segments across all contours.
+	* @return Segment count.
+	*/
+	std::size_t getSegmentCount() const { return segments.size(); }
+	/**
+	* @brief Returns a view of the contour at the given index.
+	* @param index Index of the contour.
+	* @return ContourView of that contour.
+	*/
+	ContourView getContourAt(std::size_t index) const;
+	/**
+	* @brief Returns a view of the contour at the given index without bounds checking.
+	* @param index Index of the contour.
+	* @return ContourView of that contour.
+	*/
+	ContourView operator[](std::size_t index) const { return ContourView(segments, offsets[index], offsets[index + 1]); }
+	/**
+	* @brief Gives read access to the shared arrays for batch kernels.
+	* @return Const reference to the segment arrays.
+	*/
+	const SegmentArrays2D& getArrays() const { return segments; }
+	/**
+	* @brief Gives read access to the offsets table.
+	* @return Vector of size() + 1 segment offsets.
+	*/
+	const std::vector<std::size_t>& getOffsets() const { return offsets; }
+
+	/**
+	* @brief Checks the validity of every contour in one pass.
+	* @return One flag per contour, true if the contour is continuous.
+	*/
+	std::vector<bool> areValid() const;
+	/**
+	* @brief Checks closedness of every contour in one pass.
+	* @return One flag per contour, true if the contour is a closed shape.
+	*/
+	std::vector<bool> areClosedShapes() const;
+	/**
+	* @brief Computes the length of every contour in one pass.
+	* @return One length per contour.
+	*/
+	std::vector<double> getLengths() const;
+	/**
+	* @brief Computes the signed area of every contour in one pass over the shared arrays.
+	* @return One signed area per contour, positive for counter-clockwise contours.
+	*/
+	std::vector<double> getSignedAreas() const;
+	/**
+	* @brief Returns the bounding box of every contour.
+	* @return One box per contour.
+	*/
+	const std::vector<BoundingBox2D>& getBoundingBoxes() const { return bounds; }
+	/**
+	* @brief Finds the contours whose bounding box overlaps a window.
+	*
+	* A broad-phase filter: only the stored per-contour boxes are compared, never the geometry.
+	*
+	* @param window Query box.
+	* @return Indices of overlapping contours in ascending order.
+	*/
+	std::vector<std::size_t> findIntersecting(const BoundingBox2D& window) const;
+	/**
+	* @brief Translates every contour in the set by the given delta.
+	* @param dx Offset along the X axis.
+	* @param dy Offset along the Y axis.
+	*/
+	void move(double dx, double dy);
+	/**
+	* @brief Translates a single contour by the given delta.
+	* @param index Index of the contour.
+	* @param dx Offset along the X axis.
+	* @param dy Offset along the Y axis.
+	*/
+	void move(std::size_t index, double dx, double dy);
+};
@@ -0,0 +1,163 @@
+/**
+ * @file ContourTessellation.cpp
+ * @brief Implements chord counting and recurrence-based arc flattening.
+ */
+#include "ContourTessellation.h"
+#include "ArcSegment2D.h"
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CONTOUR_TESSELLATION_SSE2 1
+#endif
+
+namespace {
+
+	// Points generated by the recurrence before it restarts from exact cos/sin values
+	const std::size_t restartInterval = 64;
+
+	void requirePositive(double tolerance, const char* message) {
+		if (!(tolerance > 0)) {
+			throw std::invalid_argument(message);
+		}
+	}
+
+	/**
+	 * @brief Writes the points at angles start + k * step, k = 1 .. count, on a circle.
+	 */
+	void rotatePoints(double cx, double cy, double r, double start, double step, std::size_t count, double* xs, double* ys) {
+		std::size_t k = 1;
+		while (k <= count) {
+			// Restart from exact values at the beginning of every block
+			const std::size_t blockEnd = std::min(count, k + restartInterval - 1);
+			double angle = start + k * step;
+			double ux = r * std::cos(angle);
+			double uy = r * std::sin(angle);
+			const double c = std::cos(step);
+			const double s = std::sin(step);
+			std::size_t i = k;
+#ifdef CONTOUR_TESSELLATION_SSE2
+			if (blockEnd - k + 1 >= 2) {
+				// Lanes hold points i and i + 1; both rotate by two steps per iteration
+				const double vx = ux * c - uy * s;
+				const double vy = ux * s + uy * c;
+				__m128d x = _mm_set_pd(vx, ux);
+				__m128d y = _mm_set_pd(vy, uy);
+				const double c2 = c * c - s * s;
+				const double s2 = 2 * s * c;
+				const __m128d vc2 = _mm_set1_pd(c2);
+				const __m128d vs2 = _mm_set1_pd(s2);
+				const __m128d vcx = _mm_set1_pd(cx);
+				const __m128d vcy = _mm_set1_pd(cy);
+				for (; i + 1 <= blockEnd; i += 2) {
+					_mm_storeu_pd(xs + i - 1, _mm_add_pd(x, vcx));
+					_mm_storeu_pd(ys + i - 1, _mm_add_pd(y, vcy));
+					const __m128d nx = _mm_sub_pd(_mm_mul_pd(x, vc2), _mm_mul_pd(y, vs2));
+					y = _mm_add_pd(_mm_mul_pd(x, vs2), _mm_mul_pd(y, vc2));
+					x = nx;
+				}
+				double lanes[2];
+				_mm_storeu_pd(lanes, x);
+				ux = lanes[0];
+				_mm_storeu_pd(lanes, y);
+				uy = lanes[0];
+			}
+#endif
+			for (; i <= blockEnd; ++i) {
+				xs[i - 1] = cx + ux;
+				ys[i - 1] = cy + uy;
+				const double nx = ux * c - uy * s;
+				uy = ux * s + uy * c;
+				ux = nx;
+			}
+			k = blockEnd + 1;
+		}
+	}
+
+	std::size_t segmentPointCount(const Segment2D& seg, double tolerance) {
+		if (seg.getKind() != SegmentKind::Arc) {
+			return 1;
+		}
+		const ArcSegment2D& arc = static_cast<const ArcSegment2D&>(seg);
+		return arcChordCount(arc.getRadius(), arc.getSweepAngle(), tolerance);
+	}
+
+}
+
+std::size_t arcChordCount(double radius, double sweep, double tolerance) {
+	requirePositive(tolerance, "Tolerance must be positive in arcChordCount()");
+	const double maxStep = tolerance < radius ? 2 * std::acos(1 - tolerance / radius) : M_PI;
+	const double chords = std::ceil(sweep / maxStep - 1e-9);
+	return chords > 1 ? static_cast<std::size_t>(chords) : 1;
+}
+
+std::size_t tessellatedPointCount(const Contour2D& contour, double tolerance) {
+	requirePositive(tolerance, "Tolerance must be positive in tessellatedPointCount()");
+	if (contour.getSegmentCount() == 0) {
+		return 0;
+	}
+	std::size_t count = 1;
+	for (const auto& seg : contour) {
+		count += segmentPointCount(seg, tolerance);
+	}
+	return count;
+}
+
+std::size_t tessellate(const Contour2D& contour, double tolerance, double* xs, double* ys, std::size_t capacity) {
+	const std::size_t required = tessellatedPointCount(contour, tolerance);
+	if (capacity < required) {
+		throw std::length_error("Buffer too small in tessellate()");
+	}
+	if (required == 0) {
+		return 0;
+	}
+	const MyPoint& start = contour.getSegmentAt(0).getPointA();
+	xs[0] = start.getX();
+	ys[0] = start.getY();
+	std::size_t written = 1;
+	for (const auto& seg : contour) {
+		const std::size_t count = segmentPointCount(seg, tolerance);
+		if (seg.getKind() == SegmentKind::Arc) {
+			const ArcSegment2D& arc = static_cast<const ArcSegment2D&>(seg);
+			const double sweep = arc.getSweepAngle();
+			const double step = (arc.isCounterClockwise() ? sweep : -sweep) / count;
+			// The last point is the stored end point itself
+			rotatePoints(arc.getCenter().getX(), arc.getCenter().getY(), arc.getRadius(), arc.getStartAngle(), step,
+				count - 1, xs + written, ys + written);
+		}
+		written += count;
+		xs[written - 1] = seg.getPointB().getX();
+		ys[written - 1] = seg.getPointB().getY();
+	}
+	return written;
+}
+
+std::vector<MyPoint> tessellate(const Contour2D& contour, double tolerance) {
+	const std::size_t count = tessellatedPointCount(contour, tolerance);
+	std::vector<double> xs(count);
+	std::vector<double> ys(count);
+	tessellate(contour, tolerance, xs.data(), ys.data(), count);
+	std::vector<MyPoint> points;
+	points.reserve(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		points.push_back(MyPoint(xs[i], ys[i]));
+	}
+	return points;
+}
+
+FlatContour2D tessellateToFlatContour(const Contour2D& contour, double tolerance) {
+	const std::size_t count = tessellatedPointCount(contour, tolerance);
+	std::vector<double> xs(count);
+	std::vector<double> ys(count);
+	tessellate(contour, tolerance, xs.data(), ys.data(), count);
+	FlatContour2D flat;
+	if (count > 1) {
+		flat.reserve(count - 1);
+	}
+	for (std::size_t i = 1; i < count; ++i) {
+		flat.addLine(MyPoint(xs[i - 1], ys[i - 1]), MyPoint(xs[i], ys[i]));
+	}
+	return flat;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file ContourTessellation.h
+ * @brief Flattening of line/arc contours into polylines within a chord-error tolerance.
+ */
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "Contour2D.h"
+#include "FlatContour2D.h"
+
+/**
+* @brief Returns the number of chords needed to approximate an arc within a tolerance.
+*
+* A chord spanning angle theta deviates from its arc by r * (1 - cos(theta / 2)), so the
+* largest allowed step is 2 * acos(1 - tolerance / r).
+*
+* @param radius Arc radius.
+* @param sweep Swept angle in radians.
+* @param tolerance Largest allowed distance between a chord and the arc; must be positive.
+* @return Chord count, at least 1.
+*/
+std::size_t arcChordCount(double radius, double sweep, double tolerance);
+
+/**
+* @brief Returns how many points tessellate() produces for a contour.
+*
+* Use it to size the buffers passed to tessellate().
+*
+* @param contour Contour to flatten.
+* @param tolerance Chord-error tolerance.
+* @return One point for the start plus, per segment, one point per line or chord.
+* @throws std::invalid_argument If tolerance is not positive.
+*/
+std::size_t tessellatedPointCount(const Contour2D& contour, double tolerance);
+
+/**
+* @brief Flattens a contour into caller-provided coordinate arrays.
+*
+* Writes the start point of the first segment followed by the end point of every line
+* and chord, so consecutive points form the polyline and a closed contour repeats its
+* start point at the end. Arc points come from a rotation recurrence: one cos/sin pair
+* per arc, then two multiply-adds per coordinate, two points at a time with SSE2. The
+* recurrence is restarted from exact values every 64 points and every arc ends exactly
+* at its stored end point, so rounding does not accumulate.
+*
+* @param contour Contour to flatten.
+* @param tolerance Chord-error tolerance.
+* @param xs Output X coordinates.
+* @param ys Output Y coordinates.
+* @param capacity Number of entries available in xs and ys.
+* @return Number of points written, equal to tessellatedPointCount().
+* @throws std::invalid_argument If tolerance is not positive.
+* @throws std::length_error If capacity is smaller than tessellatedPointCount().
+*/
+std::size_t tessellate(const Contour2D& contour, double tolerance, double* xs, double* ys, std::size_t capacity);
+
+/**
+* @brief Flattens a contour into a list of points.
+* @param contour Contour to flatten.
+* @param tolerance Chord-error tolerance.
+* @return Polyline vertices, as written by the array overload.
+* @throws std::invalid_argument If tolerance is not positive.
+*/
+std::vector<MyPoint> tessellate(const Contour2D& contour, double tolerance);
+
+/**
+* @brief Flattens a contour into a FlatContour2D made of lines only.
+* @param contour Contour to flatten.
+* @param tolerance Chord-error tolerance.
+* @return Polyline contour, closed if the input is closed.
+* @throws std::invalid_argument If tolerance is not positive.
+*/
+FlatContour2D tessellateToFlatContour(const Contour2D& contour, double tolerance);
@@ -36,3 +36,33 @@ Contour2D polylineContourFromPoints(std::vector<MyPoint>& ptr, bool closedContou
 	return myContour;
 
 }
+
+Contour2D polylineContourFromPoints(std::vector<MyPoint>& ptr, bool closedContour, SegmentArena& arena) {
+
+	Contour2D myContour;
+	if (!ptr.empty()) {
+
+		for (size_t i = 0; i + 1 < ptr.size(); ++i) {
+			if (ptr[i].distanceTo_2D(ptr[i + 1]) > Contour2D::defaultEpsilon) {
+				myContour.addSegment(arena.make<LineSegment2D>(ptr[i], ptr[i + 1]));
+			}
+		}
+
+		if (closedContour) {
+			if (ptr.front().distanceTo_2D(ptr.back()) > Contour2D::defaultEpsilon) {
+				myContour.addSegment(arena.make<LineSegment2D>(ptr.back(), ptr.front()));
+			}
+		}
+
+	}
+	return myContour;
+
+}
+
+Contour2D copyContour(const Contour2D& contour, SegmentArena& arena) {
+	Contour2D copy;
+	for (const auto& segment : contour) {
+		copy.addSegment(arena.copy(segment));
+	}
+	return copy;
+}
@@ -5,6 +5,7 @@
 #pragma once
 #include "Contour2D.h"
 #include "LineSegment2D.h"
+#include "SegmentArena.h"
 
  /**
   * @brief Constructs a Contour2D from a list of points interpreted as a polyline.
@@ -16,4 +17,30 @@
   * @param closedContour If true, adds a segment from the last point to the first.
   * @return A Contour2D composed of straight segments between the given points.
   */
-Contour2D polylineContourFromPoints(std::vector<MyPoint>& ptr, bool closedContour);
\ No newline at end of file
+Contour2D polylineContourFromPoints(std::vector<MyPoint>& ptr, bool closedContour);
+
+ /**
+  * @brief Constructs a polyline Contour2D whose segments are allocated from an arena.
+  *
+  * Same as polylineContourFromPoints(ptr, closedContour), but every LineSegment2D is
+  * carved out of the given arena. The arena must outlive the returned contour.
+  *
+  * @param ptr Vector of points to connect.
+  * @param closedContour If true, adds a segment from the last point to the first.
+  * @param arena Arena that receives the segment allocations.
+  * @return A Contour2D composed of straight segments between the given points.
+  */
+Contour2D polylineContourFromPoints(std::vector<MyPoint>& ptr, bool closedContour, SegmentArena& arena);
+
+ /**
+  * @brief Makes a deep copy of a contour whose segments are allocated from an arena.
+  *
+  * Unlike the Contour2D copy constructor, which shares segments copy-on-write and
+  * clones onto the heap when it detaches, every segment of the result is placed in
+  * the given arena. The arena must outlive the returned contour.
+  *
+  * @param contour Contour to copy.
+  * @param arena Arena that receives the segment allocations.
+  * @return An independent copy of contour.
+  */
+Contour2D copyContour(const Contour2D& contour, SegmentArena& arena);
@@ -0,0 +1,102 @@
+/**
+ * @file ContourValidation.cpp
+ * @brief Implements the joint gap kernel and validation reports.
+ */
+#include "ContourValidation.h"
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CONTOUR_VALIDATION_SSE2 1
+#endif
+
+std::size_t findOpenJoints(const double* endX, const double* endY, const double* startX, const double* startY,
+	std::size_t count, double epsilonSquared, std::vector<std::size_t>& joints) {
+
+	const std::size_t before = joints.size();
+	std::size_t i = 0;
+
+#ifdef CONTOUR_VALIDATION_SSE2
+	const __m128d limit = _mm_set1_pd(epsilonSquared);
+	for (; i + 2 <= count; i += 2) {
+		const __m128d dx = _mm_sub_pd(_mm_loadu_pd(startX + i), _mm_loadu_pd(endX + i));
+		const __m128d dy = _mm_sub_pd(_mm_loadu_pd(startY + i), _mm_loadu_pd(endY + i));
+		const __m128d gapSq = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+		const int mask = _mm_movemask_pd(_mm_cmpgt_pd(gapSq, limit));
+		// Valid contours take this branch almost never, so the loop streams through memory
+		if (mask != 0) {
+			if (mask & 1) {
+				joints.push_back(i);
+			}
+			if (mask & 2) {
+				joints.push_back(i + 1);
+			}
+		}
+	}
+#endif
+
+	for (; i < count; ++i) {
+		const double dx = startX[i] - endX[i];
+		const double dy = startY[i] - endY[i];
+		if (dx * dx + dy * dy > epsilonSquared) {
+			joints.push_back(i);
+		}
+	}
+	return joints.size() - before;
+}
+
+namespace {
+
+	bool pointsMeet(double x1, double y1, double x2, double y2, double epsilonSquared) {
+		const double dx = x2 - x1;
+		const double dy = y2 - y1;
+		return dx * dx + dy * dy <= epsilonSquared;
+	}
+
+}
+
+ValidationReport validateEndpoints(const double* ax, const double* ay, const double* bx, const double* by,
+	std::size_t segmentCount, double epsilon) {
+
+	ValidationReport report;
+	if (segmentCount < 2) {
+		return report;
+	}
+	report.jointCount = segmentCount - 1;
+
+	const double epsilonSq = epsilon * epsilon;
+	std::vector<std::size_t> joints;
+	findOpenJoints(bx, by, ax + 1, ay + 1, report.jointCount, epsilonSq, joints);
+
+	report.defects.reserve(joints.size());
+	for (std::size_t j : joints) {
+		JointDefect defect;
+		defect.joint = j;
+		const double dx = ax[j + 1] - bx[j];
+		const double dy = ay[j + 1] - by[j];
+		defect.gap = sqrt(dx * dx + dy * dy);
+
+		if (pointsMeet(bx[j], by[j], bx[j + 1], by[j + 1], epsilonSq)) {
+			defect.reversal = JointReversal::Next;
+		}
+		else if (pointsMeet(ax[j], ay[j], ax[j + 1], ay[j + 1], epsilonSq)) {
+			defect.reversal = JointReversal::Previous;
+		}
+		else if (pointsMeet(ax[j], ay[j], bx[j + 1], by[j + 1], epsilonSq)) {
+			defect.reversal = JointReversal::Both;
+		}
+		else {
+			defect.reversal = JointReversal::None;
+		}
+		report.defects.push_back(defect);
+	}
+	return report;
+}
+
+ValidationReport validateSegments(const SegmentArrays2D& arrays, std::size_t first, std::size_t last, double epsilon) {
+	if (last <= first) {
+		return ValidationReport();
+	}
+	return validateEndpoints(arrays.ax.data() + first, arrays.ay.data() + first,
+		arrays.bx.data() + first, arrays.by.data() + first, last - first, epsilon);
+}
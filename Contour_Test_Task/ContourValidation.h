@@ -0,0 +1,90 @@
+/**
+ * @file ContourValidation.h
+ * @brief Defines joint-level validation reports and the gap-scanning kernel behind them.
+ *
+ * Where isValid() only answers yes or no, a ValidationReport lists every joint whose
+ * endpoints do not meet, how far apart they are and whether a reversed neighbouring
+ * segment would close the gap.
+ */
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "SegmentArrays2D.h"
+
+ /**
+ * @enum JointReversal
+ * @brief Which segment at a broken joint appears to run the wrong way.
+ */
+enum class JointReversal : unsigned char {
+	None,		///< No reversal explains the gap.
+	Previous,	///< The segment before the joint is reversed (its start meets the next start).
+	Next,		///< The segment after the joint is reversed (its end meets the previous end).
+	Both		///< Both segments are reversed (previous start meets next end).
+};
+
+ /**
+ * @struct JointDefect
+ * @brief One broken joint of a contour.
+ */
+struct JointDefect {
+	std::size_t joint;			///< Index of the segment before the joint; the joint is joint -> joint + 1.
+	double gap;					///< Distance between the end of segment joint and the start of joint + 1.
+	JointReversal reversal;		///< Reversal that would close the gap, if any.
+};
+
+ /**
+ * @struct ValidationReport
+ * @brief Result of validating a contour joint by joint.
+ */
+struct ValidationReport {
+	std::size_t jointCount = 0;			///< Number of joints checked (segments - 1).
+	std::vector<JointDefect> defects;	///< Broken joints in ascending order.
+
+	/**
+	* @brief Tells whether the validated contour is continuous.
+	* @return True if no joint is broken.
+	*/
+	bool isValid() const { return defects.empty(); }
+};
+
+/**
+* @brief Collects the joints whose squared gap exceeds epsilonSquared.
+*
+* Joint i compares (endX[i], endY[i]) with (startX[i], startY[i]); callers pass the start
+* arrays offset by one segment. Uses SSE2 when available, two joints per step, with a
+* scalar loop for the remainder and on other targets.
+*
+* @param endX End point X of the segment before each joint.
+* @param endY End point Y of the segment before each joint.
+* @param startX Start point X of the segment after each joint.
+* @param startY Start point Y of the segment after each joint.
+* @param count Number of joints.
+* @param epsilonSquared Squared gap tolerance.
+* @param joints Receives the indices of broken joints, appended in ascending order.
+* @return Number of broken joints found.
+*/
+std::size_t findOpenJoints(const double* endX, const double* endY, const double* startX, const double* startY,
+	std::size_t count, double epsilonSquared, std::vector<std::size_t>& joints);
+
+/**
+* @brief Validates a chain of segments given as contiguous endpoint arrays.
+* @param ax Start point X of each segment.
+* @param ay Start point Y of each segment.
+* @param bx End point X of each segment.
+* @param by End point Y of each segment.
+* @param segmentCount Number of segments.
+* @param epsilon Maximum allowed gap at each joint.
+* @return Report of every broken joint.
+*/
+ValidationReport validateEndpoints(const double* ax, const double* ay, const double* bx, const double* by,
+	std::size_t segmentCount, double epsilon);
+
+/**
+* @brief Validates segments [first, last) of a SegmentArrays2D.
+* @param arrays Segment arrays.
+* @param first Index of the first segment.
+* @param last One past the index of the last segment.
+* @param epsilon Maximum allowed gap at each joint.
+* @return Report of every broken joint, with joint indices relative to first.
+*/
+ValidationReport validateSegments(const SegmentArrays2D& arrays, std::size_t first, std::size_t last, double epsilon);
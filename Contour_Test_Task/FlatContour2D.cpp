@@ -0,0 +1,98 @@
+/**
+ * @file FlatContour2D.cpp
+ * @brief Implements the FlatContour2D class: conversion, editing and array-based queries.
+ */
+#include "FlatContour2D.h"
+
+FlatContour2D::FlatContour2D(const Contour2D& contour) {
+	segments.reserve(contour.getSegmentCount());
+	for (const auto& seg : contour) {
+		segments.append(seg);
+	}
+}
+
+Contour2D FlatContour2D::toContour2D() const {
+	Contour2D contour;
+	for (std::size_t i = 0; i < segments.size(); ++i) {
+		contour.addSegment(segments.makeSegment(i));
+	}
+	return contour;
+}
+
+void FlatContour2D::addSegment(std::unique_ptr<Segment2D> segment) {
+	segments.append(*segment);
+	validity.invalidate();
+}
+
+void FlatContour2D::addSegment(const Segment2D& segment) {
+	segments.append(segment);
+	validity.invalidate();
+}
+
+void FlatContour2D::insertSegment(std::unique_ptr<Segment2D> segment, int position) {
+	if (position < 0 || position > static_cast<int>(segments.size())) {
+		throw std::out_of_range("Invalid position in insertSegment()");
+	}
+	segments.insert(static_cast<std::size_t>(position), *segment);
+	validity.invalidate();
+}
+
+void FlatContour2D::removeSegment(int position) {
+	if (position < 0 || position >= static_cast<int>(segments.size())) {
+		throw std::out_of_range("Invalid position in removeSegment()");
+	}
+	segments.erase(static_cast<std::size_t>(position));
+	validity.invalidate();
+}
+
+std::unique_ptr<Segment2D> FlatContour2D::getSegmentCopyAt(std::size_t index) const {
+	if (index >= segments.size()) {
+		throw std::out_of_range("Invalid index in getSegmentCopyAt()");
+	}
+	return segments.makeSegment(index);
+}
+
+SegmentKind FlatContour2D::getKindAt(std::size_t index) const {
+	if (index >= segments.size()) {
+		throw std::out_of_range("Invalid index in getKindAt()");
+	}
+	return segments.kinds[index];
+}
+
+MyPoint FlatContour2D::getPointAAt(std::size_t index) const {
+	if (index >= segments.size()) {
+		throw std::out_of_range("Invalid index in getPointAAt()");
+	}
+	return segments.getPointA(index);
+}
+
+MyPoint FlatContour2D::getPointBAt(std::size_t index) const {
+	if (index >= segments.size()) {
+		throw std::out_of_range("Invalid index in getPointBAt()");
+	}
+	return segments.getPointB(index);
+}
+
+/**
+ * @brief Checks if all segments are connected end-to-end within a tolerance.
+ *
+ * Cached like Contour2D::isValid(); the scan itself walks the endpoint arrays.
+ *
+ * @return True if the contour is continuous.
+ */
+bool FlatContour2D::isValid() const {
+	return validity.get([this]() {
+		return segments.isContinuous(0, segments.size(), defaultEpsilon);
+	});
+}
+
+bool FlatContour2D::isClosedShape() const {
+	if (!isValid()) {
+		return false;
+	}
+	return segments.isClosed(0, segments.size(), defaultEpsilon);
+}
+
+void FlatContour2D::move(double dx, double dy) {
+	segments.move(0, segments.size(), dx, dy);
+}
@@ -0,0 +1,163 @@
+/**
+ * @file FlatContour2D.h
+ * @brief Defines a 2D contour that stores its segments in contiguous parallel arrays.
+ *
+ * FlatContour2D offers the same editing and query interface as Contour2D, but keeps
+ * endpoints, kinds and arc parameters in a SegmentArrays2D instead of one heap object per
+ * segment. It converts losslessly to and from Contour2D.
+ */
+#pragma once
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include "Segment2D.h"
+#include "SegmentArrays2D.h"
+#include "Contour2D.h"
+#include "ValidityCache.h"
+#include "ContourValidation.h"
+
+ /**
+ * @class FlatContour2D
+ * @brief Structure-of-arrays counterpart of Contour2D for large contours.
+ *
+ * Validity, closedness and movement run as linear passes over contiguous arrays.
+ * Segments are copied in and out; individual segments are not addressable by reference.
+ */
+class FlatContour2D {
+private:
+	SegmentArrays2D segments;
+	ValidityCache validity;
+
+public:
+
+	static constexpr double defaultEpsilon = Contour2D::defaultEpsilon;
+	/**
+	* @brief Default constructor.
+	*/
+	FlatContour2D() = default;
+	/**
+	* @brief Builds a flat copy of an existing contour.
+	* @param contour Contour2D to copy from.
+	*/
+	explicit FlatContour2D(const Contour2D& contour);
+	/**
+	* @brief Converts the flat contour back into a Contour2D.
+	* @return A Contour2D holding equivalent segments.
+	*/
+	Contour2D toContour2D() const;
+
+	/**
+	* @brief Adds a segment to the contour.
+	* @param segment A unique_ptr to a Segment2D.
+	*/
+	void addSegment(std::unique_ptr<Segment2D> segment);
+	/**
+	* @brief Adds a copy of an existing segment to the contour.
+	* @param segment The Segment2D to copy.
+	*/
+	void addSegment(const Segment2D& segment);
+	/**
+	* @brief Checks whether the contour is valid (continuous).
+	* @return True if all segments are connected within epsilon.
+	*/
+	bool isValid() const;
+	/**
+	* @brief Reports every broken joint with its gap and any reversed neighbouring segment.
+	* @param epsilon Maximum allowed gap at each joint.
+	* @return Validation report.
+	*/
+	ValidationReport validate(double epsilon = defaultEpsilon) const { return validateSegments(segments, 0, segments.size(), epsilon); }
+	/**
+	* @brief Appends a line segment directly to the arrays.
+	* @param a Start point.
+	* @param b End point.
+	*/
+	void addLine(const MyPoint& a, const MyPoint& b) {
+		segments.appendLine(a, b);
+		validity.invalidate();
+	}
+	/**
+	* @brief Reserves storage for a number of segments.
+	* @param count Expected segment count.
+	*/
+	void reserve(std::size_t count) { segments.reserve(count); }
+	/**
+	* @brief Inserts a segment at a specified position.
+	* @param segment A unique_ptr to a Segment2D.
+	* @param position Index at which to insert the segment.
+	*/
+	void insertSegment(std::unique_ptr<Segment2D> segment, int position);
+	/**
+	* @brief Removes a segment at the given position.
+	* @param position Index of the segment to remove.
+	*/
+	void removeSegment(const int position);
+	/**
+	* @brief Returns a standalone copy of the segment at the given index.
+	* @param index Index of the segment.
+	* @return A unique_ptr to the rebuilt segment.
+	*/
+	std::unique_ptr<Segment2D> getSegmentCopyAt(std::size_t index) const;
+	/**
+	* @brief Returns the kind of the segment at the given index.
+	* @param index Index of the segment.
+	* @return Segment kind.
+	*/
+	SegmentKind getKindAt(std::size_t index) const;
+	/**
+	* @brief Returns the start point of the segment at the given index.
+	* @param index Index of the segment.
+	* @return Point A of the segment.
+	*/
+	MyPoint getPointAAt(std::size_t index) const;
+	/**
+	* @brief Returns the end point of the segment at the given index.
+	* @param index Index of the segment.
+	* @return Point B of the segment.
+	*/
+	MyPoint getPointBAt(std::size_t index) const;
+	/**
+	* @brief Gives read access to the underlying arrays for batch kernels.
+	* @return Const reference to the segment arrays.
+	*/
+	const SegmentArrays2D& getArrays() const { return segments; }
+	/**
+	* @brief Determines whether the contour forms a closed shape.
+	* @return True if the start point and end point are within epsilon.
+	*/
+	bool isClosedShape() const;
+	/**
+	* @brief Translates all segments in the contour by the given delta.
+	* @param dx Offset along the X axis.
+	* @param dy Offset along the Y axis.
+	*/
+	void move(double dx, double dy);
+	/**
+	* @brief Returns the signed area enclosed by the contour.
+	*
+	* Same definition as Contour2D::signedArea(), computed by one pass over the arrays.
+	*
+	* @return Signed area, positive for counter-clockwise contours.
+	*/
+	double signedArea() const { return segments.signedArea(0, segments.size()); }
+	/**
+	* @brief Returns the exact bounding box of the contour.
+	* @return Bounding box; empty for a contour without segments.
+	*/
+	BoundingBox2D boundingBox() const { return segments.getBoundingBox(0, segments.size()); }
+	/**
+	* @brief Returns the winding direction of the contour.
+	* @return Orientation derived from signedArea().
+	*/
+	Orientation orientation() const { return Contour2D::orientationFromArea(signedArea()); }
+	/**
+	* @brief Reverses the contour in place: segment order and every segment's direction.
+	*/
+	void reverse() { segments.reverse(0, segments.size()); }
+	/**
+	* @brief Returns the number of segments in the contour.
+	* @return Number of segments.
+	*/
+	size_t getSegmentCount() const { return segments.size(); }
+
+};
@@ -0,0 +1,101 @@
+/**
+ * @file InlineContour2D.cpp
+ * @brief Implements the InlineContour2D class: conversion, editing and validation.
+ */
+#include "InlineContour2D.h"
+
+InlineContour2D::InlineContour2D(const Contour2D& contour) {
+	segments.reserve(contour.getSegmentCount());
+	for (const auto& seg : contour) {
+		segments.emplace_back(seg);
+	}
+}
+
+Contour2D InlineContour2D::toContour2D() const {
+	Contour2D contour;
+	for (const auto& seg : segments) {
+		contour.addSegment(seg.clone());
+	}
+	return contour;
+}
+
+void InlineContour2D::addSegment(std::unique_ptr<Segment2D> segment) {
+	segments.emplace_back(*segment);
+	validity.invalidate();
+}
+
+void InlineContour2D::addSegment(const Segment2D& segment) {
+	segments.emplace_back(segment);
+	validity.invalidate();
+}
+
+void InlineContour2D::addSegment(const SegmentVariant2D& segment) {
+	segments.push_back(segment);
+	validity.invalidate();
+}
+
+void InlineContour2D::insertSegment(std::unique_ptr<Segment2D> segment, int position) {
+	if (position < 0 || position > static_cast<int>(segments.size())) {
+		throw std::out_of_range("Invalid position in insertSegment()");
+	}
+	segments.insert(segments.begin() + position, SegmentVariant2D(*segment));
+	validity.invalidate();
+}
+
+void InlineContour2D::removeSegment(int position) {
+	if (position < 0 || position >= static_cast<int>(segments.size())) {
+		throw std::out_of_range("Invalid position in removeSegment()");
+	}
+	segments.erase(segments.begin() + position);
+	validity.invalidate();
+}
+
+const SegmentVariant2D& InlineContour2D::getSegmentAt(std::size_t index) const {
+	if (index >= segments.size()) {
+		throw std::out_of_range("Invalid index in getSegmentAt()");
+	}
+	return segments[index];
+}
+
+/**
+ * @brief Checks if all segments are connected end-to-end within a tolerance.
+ *
+ * Same rule and caching as Contour2D::isValid(), without virtual calls per joint.
+ *
+ * @return True if the contour is continuous.
+ */
+bool InlineContour2D::isValid() const {
+	return validity.get([this]() {
+		for (size_t i = 0; i + 1 < segments.size(); ++i) {
+			if (segments[i].getPointB().distanceTo_2D(segments[i + 1].getPointA()) > defaultEpsilon) {
+				return false;
+			}
+		}
+		return true;
+	});
+}
+
+void InlineContour2D::move(double dx, double dy) {
+	for (auto& seg : segments) {
+		seg.visit([dx, dy](auto& concrete) { concrete.move(dx, dy); });
+	}
+}
+
+bool InlineContour2D::isClosedShape() const {
+
+	if (!isValid()) {
+		return false;
+	}
+
+	if (segments.size() == 1) {
+		if (segments.front().isNonZeroLength(defaultEpsilon)) {
+			return (segments.front().getPointA().distanceTo_2D(segments.front().getPointB()) < defaultEpsilon);
+		}
+	}
+	else if (segments.size() > 1) {
+		if (segments.back().getPointB().distanceTo_2D(segments.front().getPointA()) < defaultEpsilon) {
+			return true;
+		}
+	}
+	return false;
+}
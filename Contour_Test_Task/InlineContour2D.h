@@ -0,0 +1,109 @@
+/**
+ * @file InlineContour2D.h
+ * @brief Defines a 2D contour that stores its segments inline as SegmentVariant2D values.
+ *
+ * InlineContour2D mirrors the Contour2D interface while keeping all segments in a single
+ * contiguous vector, so a contour costs one allocation and segment calls are not virtual.
+ */
+#pragma once
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include "SegmentVariant2D.h"
+#include "Contour2D.h"
+#include "ValidityCache.h"
+
+ /**
+ * @class InlineContour2D
+ * @brief Contour of value-type segments with visitor-based dispatch.
+ *
+ * Segments are copied in from any Segment2D. Iteration yields SegmentVariant2D objects
+ * whose visit() method exposes the concrete segment type.
+ */
+class InlineContour2D {
+private:
+	std::vector<SegmentVariant2D> segments;
+	ValidityCache validity;
+
+public:
+
+	static constexpr double defaultEpsilon = Contour2D::defaultEpsilon;
+	/**
+	* @brief Default constructor.
+	*/
+	InlineContour2D() = default;
+	/**
+	* @brief Builds an inline copy of an existing contour.
+	* @param contour Contour2D to copy from.
+	*/
+	explicit InlineContour2D(const Contour2D& contour);
+	/**
+	* @brief Converts the contour back into a Contour2D.
+	* @return A Contour2D holding equivalent segments.
+	*/
+	Contour2D toContour2D() const;
+
+	/**
+	* @brief Adds a segment to the contour.
+	* @param segment A unique_ptr to a Segment2D.
+	*/
+	void addSegment(std::unique_ptr<Segment2D> segment);
+	/**
+	* @brief Adds a copy of an existing segment to the contour.
+	* @param segment The Segment2D to copy.
+	*/
+	void addSegment(const Segment2D& segment);
+	/**
+	* @brief Adds a copy of a value-type segment to the contour.
+	* @param segment The SegmentVariant2D to copy.
+	*/
+	void addSegment(const SegmentVariant2D& segment);
+	/**
+	* @brief Checks whether the contour is valid (continuous).
+	* @return True if all segments are connected within epsilon.
+	*/
+	bool isValid() const;
+	/**
+	* @brief Inserts a segment at a specified position.
+	* @param segment A unique_ptr to a Segment2D.
+	* @param position Index at which to insert the segment.
+	*/
+	void insertSegment(std::unique_ptr<Segment2D> segment, int position);
+	/**
+	* @brief Removes a segment at the given position.
+	* @param position Index of the segment to remove.
+	*/
+	void removeSegment(const int position);
+	/**
+	* @brief Retrieves the segment at the given index.
+	* @param index Index of the segment.
+	* @return Const reference to the SegmentVariant2D.
+	*/
+	const SegmentVariant2D& getSegmentAt(std::size_t index) const;
+
+	/**
+	 * @brief Returns a const iterator to the beginning of the segment container.
+	 */
+	std::vector<SegmentVariant2D>::const_iterator begin() const { return segments.begin(); }
+	/**
+	* @brief Returns a const iterator to the end of the segment container.
+	*/
+	std::vector<SegmentVariant2D>::const_iterator end() const { return segments.end(); }
+	/**
+	* @brief Determines whether the contour forms a closed shape.
+	* @return True if the start point and end point are within epsilon.
+	*/
+	bool isClosedShape() const;
+	/**
+	* @brief Translates all segments in the contour by the given delta.
+	* @param dx Offset along the X axis.
+	* @param dy Offset along the Y axis.
+	*/
+	void move(double dx, double dy);
+	/**
+	* @brief Returns the number of segments in the contour.
+	* @return Number of segments.
+	*/
+	size_t getSegmentCount() const { return segments.size(); }
+
+};
@@ -0,0 +1,87 @@
+/**
+ * @file JointCounter.h
+ * @brief Defines a lock-free, incrementally maintained count of broken contour joints.
+ */
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+ /**
+  * @class JointCounter
+  * @brief Number of joints whose endpoints do not meet, or "unknown".
+  *
+  * Const readers that find the count unknown compute it with a full scan and publish it,
+  * like ValidityCache. Editors that know which joints they touch call add()/remove() for
+  * just those joints, so a known count stays known and isValid() remains O(1) across edits.
+  * Mutating calls require exclusive access to the owner, as any edit does.
+  */
+class JointCounter {
+private:
+	static constexpr std::size_t unknown = static_cast<std::size_t>(-1);
+
+	mutable std::atomic<std::size_t> count{ 0 };
+
+public:
+	/**
+	* @brief Creates a count of zero, matching an empty contour.
+	*/
+	JointCounter() = default;
+	/**
+	* @brief Copies the count of another counter.
+	* @param other Counter to copy from.
+	*/
+	JointCounter(const JointCounter& other) noexcept : count(other.count.load(std::memory_order_acquire)) {}
+	/**
+	* @brief Copies the count of another counter.
+	* @param other Counter to copy from.
+	* @return Reference to this.
+	*/
+	JointCounter& operator=(const JointCounter& other) noexcept {
+		count.store(other.count.load(std::memory_order_acquire), std::memory_order_release);
+		return *this;
+	}
+
+	/**
+	* @brief Returns the count, computing and publishing it first if unknown.
+	* @param compute Callable returning the number of broken joints.
+	* @return Number of broken joints.
+	*/
+	template <class Compute>
+	std::size_t get(Compute&& compute) const {
+		std::size_t current = count.load(std::memory_order_acquire);
+		if (current == unknown) {
+			current = compute();
+			count.store(current, std::memory_order_release);
+		}
+		return current;
+	}
+	/**
+	* @brief Tells whether the count is currently known.
+	* @return True if incremental updates will be applied.
+	*/
+	bool isKnown() const noexcept { return count.load(std::memory_order_relaxed) != unknown; }
+	/**
+	* @brief Records that a joint became part of the contour; no-op while unknown.
+	* @param broken True if the joint's endpoints do not meet.
+	*/
+	void add(bool broken) noexcept {
+		std::size_t current = count.load(std::memory_order_relaxed);
+		if (current != unknown && broken) {
+			count.store(current + 1, std::memory_order_relaxed);
+		}
+	}
+	/**
+	* @brief Records that a joint left the contour; no-op while unknown.
+	* @param broken True if the joint's endpoints did not meet.
+	*/
+	void remove(bool broken) noexcept {
+		std::size_t current = count.load(std::memory_order_relaxed);
+		if (current != unknown && broken) {
+			count.store(current - 1, std::memory_order_relaxed);
+		}
+	}
+	/**
+	* @brief Marks the count as unknown.
+	*/
+	void invalidate() noexcept { count.store(unknown, std::memory_order_relaxed); }
+};
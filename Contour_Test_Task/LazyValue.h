@@ -0,0 +1,104 @@
+/**
+ * @file LazyValue.h
+ * @brief Defines a lock-free cache for a lazily computed value of any copyable type.
+ */
+#pragma once
+#include <atomic>
+
+ /**
+  * @class LazyValue
+  * @brief Caches a derived value so that concurrent const queries are race-free.
+  *
+  * Readers that find the value known return it after one acquire load. Readers that find it
+  * unknown compute it; the first of them to claim the slot stores and publishes its result,
+  * the others return their own (identical) result without writing. Values wider than one
+  * word therefore never need a lock. update() and invalidate() must only be called while
+  * the owner is being modified, which already requires exclusive access.
+  *
+  * @tparam T Value type with a non-throwing copy.
+  */
+template <class T>
+class LazyValue {
+private:
+	static constexpr unsigned char unknown = 0;
+	static constexpr unsigned char storing = 1;
+	static constexpr unsigned char known = 2;
+
+	mutable std::atomic<unsigned char> state{ unknown };
+	mutable T value{};
+
+public:
+	/**
+	* @brief Creates an unknown value.
+	*/
+	LazyValue() = default;
+	/**
+	* @brief Creates a known value.
+	* @param initial Initial value.
+	*/
+	explicit LazyValue(const T& initial) : state(known), value(initial) {}
+	/**
+	* @brief Copies the value of another cache if it is known.
+	* @param other Cache to copy from.
+	*/
+	LazyValue(const LazyValue& other) noexcept {
+		*this = other;
+	}
+	/**
+	* @brief Copies the value of another cache if it is known.
+	* @param other Cache to copy from.
+	* @return Reference to this.
+	*/
+	LazyValue& operator=(const LazyValue& other) noexcept {
+		if (other.state.load(std::memory_order_acquire) == known) {
+			value = other.value;
+			state.store(known, std::memory_order_relaxed);
+		}
+		else {
+			state.store(unknown, std::memory_order_relaxed);
+		}
+		return *this;
+	}
+
+	/**
+	* @brief Returns the cached value, computing it first if unknown.
+	* @param compute Callable returning the current value.
+	* @return Cached or freshly computed value.
+	*/
+	template <class Compute>
+	T get(Compute&& compute) const {
+		if (state.load(std::memory_order_acquire) == known) {
+			return value;
+		}
+		T result = compute();
+		unsigned char expected = unknown;
+		if (state.compare_exchange_strong(expected, storing, std::memory_order_acquire, std::memory_order_relaxed)) {
+			value = result;
+			state.store(known, std::memory_order_release);
+		}
+		return result;
+	}
+	/**
+	* @brief Applies an in-place update if the value is known; no-op otherwise.
+	* @param apply Callable taking T& that brings the value up to date.
+	*/
+	template <class Apply>
+	void update(Apply&& apply) {
+		if (state.load(std::memory_order_relaxed) == known) {
+			apply(value);
+		}
+	}
+	/**
+	* @brief Marks the value as unknown.
+	*/
+	void invalidate() noexcept { state.store(unknown, std::memory_order_relaxed); }
+	/**
+	* @brief Marks the value as unknown and drops the stored value.
+	*
+	* Unlike invalidate(), releases whatever the value holds, e.g. a shared array.
+	*/
+	void reset() noexcept {
+		value = T{};
+		state.store(unknown, std::memory_order_relaxed);
+	}
+};
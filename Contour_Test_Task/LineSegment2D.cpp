@@ -3,6 +3,7 @@
  * @brief Represents a 2D line segment defined by two endpoints and provides slope calculation.
  */
 #include "LineSegment2D.h"
+#include <limits>
 
  /**
   * @brief Calculates and stores the slope of the line segment.
@@ -11,6 +11,8 @@
   *
   * Provides geometric utilities such as length, slope calculation, and movement.
   * Automatically recalculates properties when endpoints are modified.
+  * Its overrides are final so that calls through a LineSegment2D reference are devirtualized;
+  * the class itself stays open only for SegmentArena's ArenaSegment wrapper.
   */
 class LineSegment2D : public Segment2D {
 private:
@@ -23,10 +25,14 @@ public:
 	* @brief Creates a clone (deep copy) of the line segment.
 	* @return A unique_ptr to the cloned LineSegment2D.
 	*/
-	std::unique_ptr<Segment2D> clone() const override {
+	std::unique_ptr<Segment2D> clone() const final {
 		return std::make_unique<LineSegment2D>(*this);
 	}
 	/**
+	* @brief Returns SegmentKind::Line.
+	*/
+	SegmentKind getKind() const final { return SegmentKind::Line; }
+	/**
 	* @brief Constructs a line segment from two endpoints.
 	* @param a Start point.
 	* @param b End point.
@@ -40,12 +46,12 @@ public:
 	* @brief Gets the first endpoint of the segment.
 	* @return Reference to point A.
 	*/
-	const MyPoint& getPointA() const override { return pointA; }
+	const MyPoint& getPointA() const final { return pointA; }
 	/**
 	 * @brief Gets the second endpoint of the segment.
 	 * @return Reference to point B.
 	 */
-	const MyPoint& getPointB() const override { return pointB; }
+	const MyPoint& getPointB() const final { return pointB; }
 	/**
 	* @brief Returns the slope of the segment.
 	* @return Slope value (infinite if vertical).
@@ -79,7 +85,7 @@ public:
 	* @param dx Offset along X.
 	* @param dy Offset along Y.
 	*/
-	void move(double dx, double dy) override {
+	void move(double dx, double dy) final {
 		pointA.setX(pointA.getX() + dx);
 		pointB.setX(pointB.getX() + dx);
 
@@ -89,9 +95,15 @@ public:
 
 	}
 	/**
+	* @brief Swaps the endpoints so that the line runs from point B to point A.
+	*/
+	void reverse() final {
+		std::swap(pointA, pointB);
+	}
+	/**
 	* @brief Calculates and stores the segment length.
 	*/
-	void length() override {
+	void length() final {
 		length_ = getPointA().distanceTo_2D(getPointB());
 	}
 	/**
@@ -100,4 +112,84 @@ public:
 	* @return True if length exceeds epsilon.
 	*/
 	bool isNonZeroLength(double epsilon) const { return (length_ > epsilon); }
+	/**
+	* @brief Returns the stored length of the line.
+	* @return Distance between the endpoints.
+	*/
+	double getLength() const final { return length_; }
+	/**
+	* @brief Returns the box spanned by the endpoints.
+	* @return Bounding box of the line.
+	*/
+	BoundingBox2D getBoundingBox() const final { return BoundingBox2D(pointA, pointB); }
+	/**
+	* @brief Returns the shoelace term of the line.
+	* @return (xA * yB - xB * yA) / 2.
+	*/
+	double getSignedAreaTerm() const final {
+		return 0.5 * (pointA.getX() * pointB.getY() - pointB.getX() * pointA.getY());
+	}
+	/**
+	* @brief Interpolates linearly from point A towards point B.
+	* @param distance Distance from point A.
+	* @return Point on the line; point A for a zero-length line.
+	*/
+	MyPoint pointAtLength(double distance) const final {
+		const double t = length_ > 0 ? distance / length_ : 0.0;
+		return MyPoint(pointA.getX() + t * (pointB.getX() - pointA.getX()),
+			pointA.getY() + t * (pointB.getY() - pointA.getY()),
+			pointA.getZ() + t * (pointB.getZ() - pointA.getZ()));
+	}
+	/**
+	* @brief Returns the direction from point A to point B.
+	*
+	* The direction is constant along a line, so the distance is ignored.
+	*
+	* @return Unit tangent; the zero vector for a zero-length line.
+	*/
+	MyPoint tangentAtLength(double /*distance*/) const final {
+		if (!(length_ > 0)) {
+			return MyPoint();
+		}
+		return MyPoint((pointB.getX() - pointA.getX()) / length_, (pointB.getY() - pointA.getY()) / length_);
+	}
+	/**
+	* @brief Projects a point onto the line and clamps it to the endpoints.
+	* @param p Query point.
+	* @return Nearest point on the line.
+	*/
+	MyPoint closestPoint(const MyPoint& p) const final { return closestPointOf(pointA, pointB, p); }
+	/**
+	* @brief Projects a point onto the line and returns its distance from point A.
+	* @param p Query point.
+	* @return Clamped distance along the line.
+	*/
+	double lengthAtPoint(const MyPoint& p) const final { return closestPointOf(pointA, pointB, p).distanceTo_2D(pointA); }
+	/**
+	* @brief Creates the line between two points of this line.
+	* @param from Start point.
+	* @param to End point.
+	* @return New LineSegment2D.
+	*/
+	std::unique_ptr<Segment2D> subSegment(const MyPoint& from, const MyPoint& to) const final {
+		return std::make_unique<LineSegment2D>(from, to);
+	}
+	/**
+	* @brief Returns the point of the segment from a to b nearest to p.
+	* @param a Start point.
+	* @param b End point.
+	* @param p Query point.
+	* @return Nearest point; a if the segment has zero length.
+	*/
+	static MyPoint closestPointOf(const MyPoint& a, const MyPoint& b, const MyPoint& p) {
+		const double ex = b.getX() - a.getX();
+		const double ey = b.getY() - a.getY();
+		const double lengthSq = ex * ex + ey * ey;
+		if (!(lengthSq > 0)) {
+			return a;
+		}
+		double t = ((p.getX() - a.getX()) * ex + (p.getY() - a.getY()) * ey) / lengthSq;
+		t = t < 0 ? 0 : (t > 1 ? 1 : t);
+		return MyPoint(a.getX() + t * ex, a.getY() + t * ey);
+	}
 };
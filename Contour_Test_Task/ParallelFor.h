@@ -0,0 +1,130 @@
+/**
+ * @file ParallelFor.h
+ * @brief Defines a minimal executor that spreads index ranges over worker threads.
+ */
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+ /**
+ * @class ParallelExecutor
+ * @brief Runs chunks of an index range on a fixed number of threads.
+ *
+ * Work is split into chunks of grainSize indices. Threads repeatedly claim the next
+ * unclaimed chunk from a shared atomic counter, so a thread that finishes early keeps
+ * taking work and uneven chunks balance out. The calling thread takes part as a worker.
+ * The first exception thrown by a chunk is rethrown once all threads have stopped.
+ */
+class ParallelExecutor {
+private:
+	unsigned threadCount;
+
+public:
+	/**
+	* @brief Creates an executor.
+	* @param threads Number of threads to use; 0 means one per hardware thread.
+	*/
+	explicit ParallelExecutor(unsigned threads = 0)
+		: threadCount(threads != 0 ? threads : std::thread::hardware_concurrency()) {
+		if (threadCount == 0) {
+			threadCount = 1;
+		}
+	}
+	/**
+	* @brief Returns the number of threads used by forChunks().
+	* @return Thread count, at least 1.
+	*/
+	unsigned getThreadCount() const { return threadCount; }
+	/**
+	* @brief Returns the number of chunks forChunks() splits count indices into.
+	* @param count Number of indices.
+	* @param grainSize Indices per chunk.
+	* @return Chunk count.
+	*/
+	static std::size_t chunkCount(std::size_t count, std::size_t grainSize) {
+		return grainSize == 0 ? 0 : (count + grainSize - 1) / grainSize;
+	}
+	/**
+	* @brief Picks a grain size that gives each thread several chunks to balance with.
+	* @param count Number of indices.
+	* @return Suggested grain size, at least 1.
+	*/
+	std::size_t defaultGrainSize(std::size_t count) const {
+		const std::size_t chunks = static_cast<std::size_t>(threadCount) * 8;
+		const std::size_t grain = count / chunks;
+		return grain > 0 ? grain : 1;
+	}
+
+	/**
+	* @brief Calls body(chunk, begin, end) for every chunk of [0, count).
+	*
+	* Chunk c covers [c * grainSize, min(count, (c + 1) * grainSize)). Chunks run
+	* concurrently and in no particular order; body must only write to state owned by
+	* its chunk.
+	*
+	* @param count Number of indices.
+	* @param grainSize Indices per chunk, at least 1.
+	* @param body Callable taking (std::size_t chunk, std::size_t begin, std::size_t end).
+	*/
+	template <class Body>
+	void forChunks(std::size_t count, std::size_t grainSize, Body&& body) const {
+		const std::size_t chunks = chunkCount(count, grainSize);
+		if (chunks == 0) {
+			return;
+		}
+
+		std::atomic<std::size_t> nextChunk{ 0 };
+		std::exception_ptr failure;
+		std::mutex failureMutex;
+
+		auto worker = [&]() {
+			for (;;) {
+				const std::size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+				if (chunk >= chunks) {
+					return;
+				}
+				const std::size_t begin = chunk * grainSize;
+				const std::size_t end = (count - begin < grainSize) ? count : begin + grainSize;
+				try {
+					body(chunk, begin, end);
+				}
+				catch (...) {
+					std::lock_guard<std::mutex> lock(failureMutex);
+					if (!failure) {
+						failure = std::current_exception();
+					}
+					// Stop handing out work; chunks already running finish normally
+					nextChunk.store(chunks, std::memory_order_relaxed);
+				}
+			}
+		};
+
+		const std::size_t helpers = (chunks < threadCount ? chunks : threadCount) - 1;
+		std::vector<std::thread> threads;
+		threads.reserve(helpers);
+		try {
+			for (std::size_t t = 0; t < helpers; ++t) {
+				threads.emplace_back(worker);
+			}
+		}
+		catch (...) {
+			// A thread could not be started; stop the ones that were before they are destroyed
+			nextChunk.store(chunks, std::memory_order_relaxed);
+			for (auto& thread : threads) {
+				thread.join();
+			}
+			throw;
+		}
+		worker();
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		if (failure) {
+			std::rethrow_exception(failure);
+		}
+	}
+};
@@ -0,0 +1,295 @@
+/**
+ * @file PocketGenerator.cpp
+ * @brief Implements pass-by-pass pocket offsetting.
+ */
+#include "PocketGenerator.h"
+#include "ContourOffset.h"
+#include "ContourPieces.h"
+#include "ContourIntersection.h"
+#include "ContourDistance.h"
+#include "PreparedContour2D.h"
+#include "PointContainment.h"
+#include <stdexcept>
+#include <algorithm>
+
+namespace {
+
+	Contour2D oriented(const Contour2D& contour, Orientation orientation) {
+		Contour2D copy(contour);
+		if (copy.orientation() != orientation) {
+			copy.reverse();
+		}
+		return copy;
+	}
+
+	/**
+	 * @brief Index of the source loop nearest to a point.
+	 */
+	std::size_t nearestSource(const std::vector<SegmentTree2D>& trees, const MyPoint& p) {
+		std::size_t best = 0;
+		double bestDistance = trees[0].distanceTo(p);
+		for (std::size_t j = 1; j < trees.size(); ++j) {
+			const double distance = trees[j].distanceTo(p);
+			if (distance < bestDistance) {
+				best = j;
+				bestDistance = distance;
+			}
+		}
+		return best;
+	}
+
+}
+
+PocketGenerator::PocketGenerator(const Contour2D& boundary_, double toolRadius_, double stepOver_, std::size_t maxLevels_,
+	const ParallelExecutor& executor_, double epsilon_)
+	: PocketGenerator(boundary_, std::vector<Contour2D>(), toolRadius_, stepOver_, maxLevels_, executor_, epsilon_) {
+}
+
+PocketGenerator::PocketGenerator(const Contour2D& boundary_, const std::vector<Contour2D>& islands_, double toolRadius_, double stepOver_,
+	std::size_t maxLevels_, const ParallelExecutor& executor_, double epsilon_)
+	: boundary(boundary_), islands(islands_), toolRadius(toolRadius_), stepOver(stepOver_), maxLevels(maxLevels_), epsilon(epsilon_), executor(executor_) {
+
+	if (!(stepOver > 0)) {
+		throw std::invalid_argument("Step-over must be positive in PocketGenerator()");
+	}
+	if (toolRadius < 0) {
+		throw std::invalid_argument("Tool radius must not be negative in PocketGenerator()");
+	}
+	if (!isClosedContour(boundary, epsilon)) {
+		throw std::invalid_argument("Boundary must be closed in PocketGenerator()");
+	}
+	for (std::size_t i = 0; i < islands.size(); ++i) {
+		if (!isClosedContour(islands[i], epsilon)) {
+			throw std::invalid_argument("Islands must be closed in PocketGenerator()");
+		}
+		if (outlinesIntersect(boundary, islands[i], epsilon) || !containsPoint(boundary, islands[i].getSegmentAt(0).getPointA())) {
+			throw std::invalid_argument("Islands must lie strictly inside the boundary in PocketGenerator()");
+		}
+		for (std::size_t j = 0; j < i; ++j) {
+			if (overlaps(islands[j], islands[i], epsilon)) {
+				throw std::invalid_argument("Islands must not overlap in PocketGenerator()");
+			}
+		}
+	}
+}
+
+PocketGenerator::Pass PocketGenerator::offsetLoops(const Pass& previous, double distance) const {
+	// Pocket area lies left of every source loop: counter-clockwise loops shrink, clockwise ones grow
+	const std::vector<Contour2D>& sources = previous.level.loops;
+	std::vector<std::vector<Contour2D>> offsets(sources.size());
+	bool hasIslands = false;
+	for (const Contour2D& source : sources) {
+		hasIslands = hasIslands || source.orientation() == Orientation::Clockwise;
+	}
+	executor.forChunks(sources.size(), 1, [&](std::size_t, std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i) {
+			const bool island = sources[i].orientation() == Orientation::Clockwise;
+			offsets[i] = offsetContour(sources[i], island ? distance : -distance, epsilon);
+			if (island) {
+				for (auto& loop : offsets[i]) {
+					loop.reverse();
+				}
+			}
+		}
+	});
+
+	Pass pass;
+	PocketLevel& level = pass.level;
+	level.distance = distance;
+	// Separate pocket areas without islands cannot reach each other's offsets
+	if (!hasIslands || distance == 0) {
+		for (std::size_t i = 0; i < offsets.size(); ++i) {
+			for (auto& loop : offsets[i]) {
+				level.loops.push_back(std::move(loop));
+				level.parents.push_back(i);
+			}
+		}
+		return pass;
+	}
+
+	std::vector<Contour2D*> candidates;
+	std::vector<std::size_t> candidateSource;
+	std::vector<std::vector<std::size_t>> bySource(sources.size());
+	for (std::size_t i = 0; i < offsets.size(); ++i) {
+		for (auto& loop : offsets[i]) {
+			bySource[i].push_back(candidates.size());
+			candidates.push_back(&loop);
+			candidateSource.push_back(i);
+		}
+	}
+	std::vector<SegmentTree2D> candidateTrees;
+	candidateTrees.reserve(candidates.size());
+	for (const Contour2D* candidate : candidates) {
+		candidateTrees.emplace_back(*candidate);
+	}
+	std::vector<std::vector<std::vector<MyPoint>>> cuts(candidates.size());
+	for (std::size_t a = 0; a < candidates.size(); ++a) {
+		cuts[a].resize(candidates[a]->getSegmentCount());
+	}
+	auto cutPair = [&](std::size_t a, std::size_t b) {
+		if (!candidates[a]->boundingBox().inflated(epsilon).intersects(candidates[b]->boundingBox())) {
+			return;
+		}
+		for (const IntersectionPoint& hit : intersections(*candidates[a], candidateTrees[a], *candidates[b], candidateTrees[b], epsilon)) {
+			cuts[a][hit.first].push_back(hit.point);
+			cuts[b][hit.second].push_back(hit.point);
+		}
+	};
+	// Offsets of one source may meet each other; offsets of two sources only if the previous pass paired them
+	for (const auto& group : bySource) {
+		for (std::size_t a = 0; a < group.size(); ++a) {
+			for (std::size_t b = a + 1; b < group.size(); ++b) {
+				cutPair(group[a], group[b]);
+			}
+		}
+	}
+	for (const auto& pair : previous.neighbours) {
+		for (std::size_t a : bySource[pair.first]) {
+			for (std::size_t b : bySource[pair.second]) {
+				cutPair(a, b);
+			}
+		}
+	}
+
+	const std::vector<SegmentTree2D>& sourceTrees = previous.trees;
+	const std::vector<PreparedContour2D>& sourceGrids = previous.grids;
+	const double reach = distance - epsilon;
+	auto atFullDistance = [&](const MyPoint& p) {
+		int winding = 0;
+		for (std::size_t j = 0; j < sources.size(); ++j) {
+			if (!sources[j].boundingBox().inflated(reach).contains(p)) {
+				continue;
+			}
+			if (sourceTrees[j].distanceTo(p) < reach) {
+				return false;
+			}
+			winding += sourceGrids[j].windingNumber(p);
+		}
+		return winding != 0;
+	};
+
+	std::vector<unsigned char> whole(candidates.size(), 0);
+	std::vector<std::vector<std::unique_ptr<Segment2D>>> keptPerCandidate(candidates.size());
+	executor.forChunks(candidates.size(), 1, [&](std::size_t, std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i) {
+			bool uncut = true;
+			for (const auto& segmentCuts : cuts[i]) {
+				uncut = uncut && segmentCuts.empty();
+			}
+			if (uncut) {
+				bool kept = true;
+				for (const Segment2D& seg : *candidates[i]) {
+					if (!atFullDistance(seg.pointAtLength(0.5 * seg.getLength()))) {
+						kept = false;
+						break;
+					}
+				}
+				if (kept) {
+					whole[i] = 1;
+					continue;
+				}
+			}
+			for (auto& piece : splitSegments(*candidates[i], cuts[i], epsilon)) {
+				if (atFullDistance(piece->pointAtLength(0.5 * piece->getLength()))) {
+					keptPerCandidate[i].push_back(std::move(piece));
+				}
+			}
+		}
+	});
+
+	// Whole offsets keep their tree; indexLoops() builds the trees of the chained loops after them
+	std::vector<std::unique_ptr<Segment2D>> kept;
+	for (std::size_t i = 0; i < candidates.size(); ++i) {
+		if (whole[i]) {
+			level.loops.push_back(std::move(*candidates[i]));
+			level.parents.push_back(candidateSource[i]);
+			pass.trees.push_back(std::move(candidateTrees[i]));
+		}
+		for (auto& piece : keptPerCandidate[i]) {
+			kept.push_back(std::move(piece));
+		}
+	}
+	for (Contour2D& loop : chainLoops(kept, epsilon)) {
+		level.parents.push_back(nearestSource(sourceTrees, loop.getSegmentAt(0).getPointA()));
+		level.loops.push_back(std::move(loop));
+	}
+	return pass;
+}
+
+/**
+ * @brief Builds the indexes the next pass reads, if it has islands to measure against.
+ *
+ * Trees already present, in loop order, are kept. Two loops are paired if their boxes,
+ * each grown by nextDistance, overlap: offsets by nextDistance stay inside those boxes,
+ * so loops that are not paired cannot produce offsets that meet.
+ *
+ * @param pass Pass whose loops are indexed.
+ * @param nextDistance Offset distance of the following pass.
+ */
+void PocketGenerator::indexLoops(Pass& pass, double nextDistance) const {
+	const std::vector<Contour2D>& loops = pass.level.loops;
+	bool hasIslands = false;
+	for (const Contour2D& loop : loops) {
+		hasIslands = hasIslands || loop.orientation() == Orientation::Clockwise;
+	}
+	if (!hasIslands) {
+		pass.trees.clear();
+		return;
+	}
+	pass.trees.reserve(loops.size());
+	for (std::size_t i = pass.trees.size(); i < loops.size(); ++i) {
+		pass.trees.emplace_back(loops[i]);
+	}
+	pass.grids.reserve(loops.size());
+	for (const Contour2D& loop : loops) {
+		pass.grids.emplace_back(loop, epsilon);
+	}
+
+	// Sweep the grown boxes along X so only loops that overlap in X are compared
+	const double margin = nextDistance + epsilon;
+	std::vector<BoundingBox2D> boxes;
+	std::vector<std::size_t> order(loops.size());
+	boxes.reserve(loops.size());
+	for (std::size_t i = 0; i < loops.size(); ++i) {
+		boxes.push_back(loops[i].boundingBox().inflated(margin));
+		order[i] = i;
+	}
+	std::sort(order.begin(), order.end(), [&boxes](std::size_t a, std::size_t b) { return boxes[a].getMinX() < boxes[b].getMinX(); });
+	for (std::size_t a = 0; a < order.size(); ++a) {
+		for (std::size_t b = a + 1; b < order.size() && boxes[order[b]].getMinX() <= boxes[order[a]].getMaxX(); ++b) {
+			if (boxes[order[a]].intersects(boxes[order[b]])) {
+				pass.neighbours.emplace_back(std::min(order[a], order[b]), std::max(order[a], order[b]));
+			}
+		}
+	}
+}
+
+PocketGenerator::Pass PocketGenerator::firstPass() const {
+	Pass sources;
+	sources.level.loops.reserve(1 + islands.size());
+	sources.level.loops.push_back(oriented(boundary, Orientation::CounterClockwise));
+	for (const Contour2D& island : islands) {
+		sources.level.loops.push_back(oriented(island, Orientation::Clockwise));
+	}
+	indexLoops(sources, toolRadius);
+	Pass pass = offsetLoops(sources, toolRadius);
+	indexLoops(pass, stepOver);
+	return pass;
+}
+
+PocketGenerator::Pass PocketGenerator::nextPass(const Pass& current) const {
+	Pass pass = offsetLoops(current, stepOver);
+	pass.level.index = current.level.index + 1;
+	pass.level.distance = current.level.distance + stepOver;
+	indexLoops(pass, stepOver);
+	return pass;
+}
+
+std::vector<PocketLevel> PocketGenerator::generateAll() const {
+	std::vector<PocketLevel> levels;
+	forEachLevel([&levels](const PocketLevel& level) {
+		levels.push_back(level);
+		return true;
+	});
+	return levels;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file PocketGenerator.h
+ * @brief Nested inward offsets for pocket-clearing toolpaths.
+ */
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include "Contour2D.h"
+#include "ContourDistance.h"
+#include "PreparedContour2D.h"
+#include "ParallelFor.h"
+
+ /**
+ * @struct PocketLevel
+ * @brief One pass of a pocket: all loops at the same inward distance.
+ */
+struct PocketLevel {
+	std::size_t index = 0;				///< 0 for the first pass.
+	double distance = 0.0;				///< Distance from the pocket boundary and from every island.
+	std::vector<Contour2D> loops;		///< Loops of this pass: counter-clockwise around pocket area, clockwise around islands.
+	std::vector<std::size_t> parents;	///< For each loop, the loop of the previous pass it was offset from; in the first pass, 0 for the boundary and 1 + i for island i.
+};
+
+ /**
+ * @class PocketGenerator
+ * @brief Produces the stack of offsets that clears a pocket, one pass at a time.
+ *
+ * The pocket is the area inside a boundary and outside any islands, the bosses the tool
+ * has to leave standing. The first pass offsets the boundary inwards and the islands
+ * outwards by the tool radius; every further pass offsets the loops of the previous pass
+ * by the step-over, until nothing is left. Offsets by discs compose, so each pass equals
+ * a single offset of the pocket by its total distance.
+ *
+ * Loops of a pass are offset independently and in parallel. Where a grown island meets
+ * the shrunk boundary or another island, the offsets are split at their intersections
+ * and only pieces at the full step from every loop of the previous pass, inside the
+ * previous pass's area, are chained into the new loops.
+ *
+ * While a pass still contains an island, it is handed to the next pass together with
+ * the segment tree and grid of each of its loops and the pairs of loops close enough
+ * for their next offsets to meet. The next pass measures distances against those trees
+ * instead of rebuilding them, and only intersects offsets of the same loop or of such a
+ * pair. An offset that nothing cuts and that is kept whole becomes a loop of the new pass
+ * together with the tree built to intersect it. Passes without islands need no indexes
+ * and build none.
+ *
+ * forEachLevel() keeps only the current pass and its indexes in memory, so deep pockets
+ * cost the memory of their largest pass rather than of the whole stack.
+ */
+class PocketGenerator {
+private:
+	Contour2D boundary;
+	std::vector<Contour2D> islands;
+	double toolRadius;
+	double stepOver;
+	std::size_t maxLevels;
+	double epsilon;
+	ParallelExecutor executor;
+
+	/**
+	* @brief A pass together with the indexes that the following pass reuses.
+	*
+	* trees, grids and neighbours are filled only if the pass contains a clockwise loop,
+	* since only passes with islands measure distances to the loops of the pass before.
+	*/
+	struct Pass {
+		PocketLevel level;
+		std::vector<SegmentTree2D> trees;								///< Segment tree of each loop.
+		std::vector<PreparedContour2D> grids;							///< Point-location grid of each loop.
+		std::vector<std::pair<std::size_t, std::size_t>> neighbours;	///< Loop pairs, first < second, whose next offsets may meet.
+	};
+
+	Pass offsetLoops(const Pass& previous, double distance) const;
+	void indexLoops(Pass& pass, double nextDistance) const;
+	Pass firstPass() const;
+	Pass nextPass(const Pass& current) const;
+
+public:
+	/**
+	* @brief Prepares a pocket without islands.
+	* @param boundary_ Closed, simple pocket outline; its orientation does not matter.
+	* @param toolRadius_ Distance of the first pass from the boundary; 0 starts on the boundary.
+	* @param stepOver_ Distance between successive passes.
+	* @param maxLevels_ Upper limit on the number of passes.
+	* @param executor_ Executor that offsets the loops of a pass.
+	* @param epsilon_ Distance tolerance passed to offsetContour().
+	* @throws std::invalid_argument If stepOver_ is not positive, toolRadius_ is negative or
+	*         the boundary is not closed.
+	*/
+	PocketGenerator(const Contour2D& boundary_, double toolRadius_, double stepOver_, std::size_t maxLevels_ = 10000,
+		const ParallelExecutor& executor_ = ParallelExecutor(), double epsilon_ = Contour2D::defaultEpsilon);
+	/**
+	* @brief Prepares a pocket with islands.
+	* @param boundary_ Closed, simple pocket outline; its orientation does not matter.
+	* @param islands_ Closed, simple outlines of the islands; their orientation does not matter.
+	* @param toolRadius_ Distance of the first pass from the boundary and the islands; 0 starts on them.
+	* @param stepOver_ Distance between successive passes.
+	* @param maxLevels_ Upper limit on the number of passes.
+	* @param executor_ Executor that offsets the loops of a pass.
+	* @param epsilon_ Distance tolerance passed to offsetContour().
+	* @throws std::invalid_argument If stepOver_ is not positive, toolRadius_ is negative, an
+	*         outline is not closed, or an island is not strictly inside the boundary or
+	*         overlaps another island.
+	*/
+	PocketGenerator(const Contour2D& boundary_, const std::vector<Contour2D>& islands_, double toolRadius_, double stepOver_,
+		std::size_t maxLevels_ = 10000, const ParallelExecutor& executor_ = ParallelExecutor(), double epsilon_ = Contour2D::defaultEpsilon);
+
+	/**
+	* @brief Generates the passes in order and hands each one to a callback.
+	*
+	* The pass is discarded when the callback returns, unless the callback keeps a copy.
+	*
+	* @param visit Called as visit(const PocketLevel&); returning false stops generation.
+	* @return Number of passes handed to visit.
+	*/
+	template <class Visit>
+	std::size_t forEachLevel(Visit visit) const {
+		Pass pass = firstPass();
+		std::size_t count = 0;
+		while (!pass.level.loops.empty() && count < maxLevels) {
+			++count;
+			if (!visit(static_cast<const PocketLevel&>(pass.level))) {
+				break;
+			}
+			pass = nextPass(pass);
+		}
+		return count;
+	}
+
+	/**
+	* @brief Generates all passes at once.
+	*
+	* Convenient for small pockets; prefer forEachLevel() when memory matters.
+	*
+	* @return Passes from the outermost inwards.
+	*/
+	std::vector<PocketLevel> generateAll() const;
+};
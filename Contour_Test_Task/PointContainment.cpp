@@ -0,0 +1,201 @@
+/**
+ * @file PointContainment.cpp
+ * @brief Implements winding-number containment for line/arc contours.
+ */
+#include "PointContainment.h"
+#include "ArcSegment2D.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POINT_CONTAINMENT_SSE2 1
+#endif
+
+namespace {
+
+	/**
+	 * @brief Winding contribution of one edge: chord crossing plus arc region correction.
+	 *
+	 * The chord follows the usual upward/downward crossing rule. isLeft is the cross product
+	 * of the chord with the vector to the point, so the arc region test reuses it: a
+	 * counter-clockwise arc bulges to the right of its chord and a clockwise one to the left.
+	 */
+	inline int edgeWinding(double ax, double ay, double bx, double by, double cx, double cy,
+		double radiusSq, double direction, double px, double py) {
+
+		const double isLeft = (bx - ax) * (py - ay) - (px - ax) * (by - ay);
+		int winding = 0;
+		if (ay <= py) {
+			winding += (by > py && isLeft > 0) ? 1 : 0;
+		}
+		else {
+			winding -= (by <= py && isLeft < 0) ? 1 : 0;
+		}
+		const double dx = px - cx;
+		const double dy = py - cy;
+		if (dx * dx + dy * dy < radiusSq && direction * isLeft < 0) {
+			winding += direction > 0 ? 1 : -1;
+		}
+		return winding;
+	}
+
+}
+
+void ContourEdges2D::addLine(double x1, double y1, double x2, double y2) {
+	ax.push_back(x1); ay.push_back(y1);
+	bx.push_back(x2); by.push_back(y2);
+	cx.push_back(0.0); cy.push_back(0.0);
+	radiusSq.push_back(0.0);
+	direction.push_back(1.0);
+	bounds.expand(x1, y1);
+	bounds.expand(x2, y2);
+}
+
+void ContourEdges2D::addArc(const MyPoint& a, const MyPoint& b, const MyPoint& c, double r, bool counterClockwise) {
+	ax.push_back(a.getX()); ay.push_back(a.getY());
+	bx.push_back(b.getX()); by.push_back(b.getY());
+	cx.push_back(c.getX()); cy.push_back(c.getY());
+	radiusSq.push_back(r * r);
+	direction.push_back(counterClockwise ? 1.0 : -1.0);
+}
+
+void ContourEdges2D::close() {
+	if (!ax.empty() && (bx.back() != ax.front() || by.back() != ay.front())) {
+		addLine(bx.back(), by.back(), ax.front(), ay.front());
+	}
+}
+
+ContourEdges2D::ContourEdges2D(const Contour2D& contour) {
+	const std::size_t count = contour.getSegmentCount() + 1;
+	ax.reserve(count); ay.reserve(count); bx.reserve(count); by.reserve(count);
+	cx.reserve(count); cy.reserve(count); radiusSq.reserve(count); direction.reserve(count);
+
+	for (const auto& seg : contour) {
+		if (seg.getKind() == SegmentKind::Arc) {
+			const ArcSegment2D& arc = static_cast<const ArcSegment2D&>(seg);
+			addArc(arc.getPointA(), arc.getPointB(), arc.getCenter(), arc.getRadius(), arc.isCounterClockwise());
+			bounds.expand(arc.getBoundingBox());
+		}
+		else {
+			addLine(seg.getPointA().getX(), seg.getPointA().getY(), seg.getPointB().getX(), seg.getPointB().getY());
+		}
+	}
+	close();
+}
+
+ContourEdges2D::ContourEdges2D(const SegmentArrays2D& arrays, std::size_t first, std::size_t last) {
+	for (std::size_t i = first; i < last; ++i) {
+		if (arrays.kinds[i] == SegmentKind::Arc) {
+			addArc(arrays.getPointA(i), arrays.getPointB(i), MyPoint(arrays.cx[i], arrays.cy[i]),
+				arrays.radius[i], arrays.counterClockwise[i] != 0);
+			bounds.expand(arrays.getBoundingBox(i));
+		}
+		else {
+			addLine(arrays.ax[i], arrays.ay[i], arrays.bx[i], arrays.by[i]);
+		}
+	}
+	close();
+}
+
+int ContourEdges2D::windingNumber(const MyPoint& p) const {
+	if (!bounds.contains(p)) {
+		return 0;
+	}
+	const double px = p.getX();
+	const double py = p.getY();
+	const std::size_t count = ax.size();
+	std::size_t i = 0;
+	int winding = 0;
+
+#ifdef POINT_CONTAINMENT_SSE2
+	// Every condition becomes an all-ones mask; masked +1/-1 values are summed per lane
+	const __m128d vpx = _mm_set1_pd(px);
+	const __m128d vpy = _mm_set1_pd(py);
+	const __m128d zero = _mm_setzero_pd();
+	const __m128d one = _mm_set1_pd(1.0);
+	__m128d sum = _mm_setzero_pd();
+	for (; i + 2 <= count; i += 2) {
+		const __m128d vax = _mm_loadu_pd(&ax[i]);
+		const __m128d vay = _mm_loadu_pd(&ay[i]);
+		const __m128d vbx = _mm_loadu_pd(&bx[i]);
+		const __m128d vby = _mm_loadu_pd(&by[i]);
+		const __m128d isLeft = _mm_sub_pd(_mm_mul_pd(_mm_sub_pd(vbx, vax), _mm_sub_pd(vpy, vay)),
+			_mm_mul_pd(_mm_sub_pd(vpx, vax), _mm_sub_pd(vby, vay)));
+
+		const __m128d startBelow = _mm_cmple_pd(vay, vpy);
+		const __m128d endBelow = _mm_cmple_pd(vby, vpy);
+		const __m128d up = _mm_and_pd(_mm_andnot_pd(endBelow, startBelow), _mm_cmpgt_pd(isLeft, zero));
+		const __m128d down = _mm_and_pd(_mm_andnot_pd(startBelow, endBelow), _mm_cmplt_pd(isLeft, zero));
+		sum = _mm_add_pd(sum, _mm_sub_pd(_mm_and_pd(up, one), _mm_and_pd(down, one)));
+
+		const __m128d dx = _mm_sub_pd(vpx, _mm_loadu_pd(&cx[i]));
+		const __m128d dy = _mm_sub_pd(vpy, _mm_loadu_pd(&cy[i]));
+		const __m128d inDisk = _mm_cmplt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)), _mm_loadu_pd(&radiusSq[i]));
+		const __m128d dir = _mm_loadu_pd(&direction[i]);
+		const __m128d bulgeSide = _mm_cmplt_pd(_mm_mul_pd(dir, isLeft), zero);
+		sum = _mm_add_pd(sum, _mm_and_pd(_mm_and_pd(inDisk, bulgeSide), dir));
+	}
+	double lanes[2];
+	_mm_storeu_pd(lanes, sum);
+	winding = static_cast<int>(lanes[0] + lanes[1]);
+#endif
+
+	for (; i < count; ++i) {
+		winding += edgeWinding(ax[i], ay[i], bx[i], by[i], cx[i], cy[i], radiusSq[i], direction[i], px, py);
+	}
+	return winding;
+}
+
+int windingNumber(const Contour2D& contour, const MyPoint& p) {
+	if (contour.getSegmentCount() == 0 || !contour.boundingBox().contains(p)) {
+		return 0;
+	}
+	const double px = p.getX();
+	const double py = p.getY();
+	int winding = 0;
+	for (const auto& seg : contour) {
+		const MyPoint& a = seg.getPointA();
+		const MyPoint& b = seg.getPointB();
+		if (seg.getKind() == SegmentKind::Arc) {
+			const ArcSegment2D& arc = static_cast<const ArcSegment2D&>(seg);
+			const double r = arc.getRadius();
+			winding += edgeWinding(a.getX(), a.getY(), b.getX(), b.getY(), arc.getCenter().getX(), arc.getCenter().getY(),
+				r * r, arc.isCounterClockwise() ? 1.0 : -1.0, px, py);
+		}
+		else {
+			winding += edgeWinding(a.getX(), a.getY(), b.getX(), b.getY(), 0.0, 0.0, 0.0, 1.0, px, py);
+		}
+	}
+	// Closing chord, as in ContourEdges2D
+	const MyPoint& end = contour.getSegmentAt(contour.getSegmentCount() - 1).getPointB();
+	const MyPoint& start = contour.getSegmentAt(0).getPointA();
+	if (end.getX() != start.getX() || end.getY() != start.getY()) {
+		winding += edgeWinding(end.getX(), end.getY(), start.getX(), start.getY(), 0.0, 0.0, 0.0, 1.0, px, py);
+	}
+	return winding;
+}
+
+bool containsPoint(const Contour2D& contour, const MyPoint& p) {
+	return windingNumber(contour, p) != 0;
+}
+
+std::vector<int> windingNumbers(const Contour2D& contour, const std::vector<MyPoint>& points, const ParallelExecutor& executor) {
+	const ContourEdges2D edges(contour);
+	std::vector<int> result(points.size());
+	executor.forChunks(points.size(), executor.defaultGrainSize(points.size()), [&](std::size_t, std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i) {
+			result[i] = edges.windingNumber(points[i]);
+		}
+	});
+	return result;
+}
+
+std::vector<unsigned char> containsPoints(const Contour2D& contour, const std::vector<MyPoint>& points, const ParallelExecutor& executor) {
+	const ContourEdges2D edges(contour);
+	std::vector<unsigned char> result(points.size());
+	executor.forChunks(points.size(), executor.defaultGrainSize(points.size()), [&](std::size_t, std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i) {
+			result[i] = static_cast<unsigned char>(edges.windingNumber(points[i]) != 0);
+		}
+	});
+	return result;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file PointContainment.h
+ * @brief Winding-number point-in-contour tests for contours of lines and arcs.
+ *
+ * The winding number of a contour around a point is computed as the winding number of its
+ * chord polygon plus one correction per arc: the region between an arc and its chord is
+ * wound once more, positively for counter-clockwise arcs and negatively for clockwise ones.
+ * Open contours are treated as closed by a straight line from their end back to their start.
+ */
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "Contour2D.h"
+#include "SegmentArrays2D.h"
+#include "BoundingBox2D.h"
+#include "ParallelFor.h"
+
+ /**
+ * @class ContourEdges2D
+ * @brief Contour geometry flattened for repeated winding-number queries.
+ *
+ * Stores chord endpoints and arc circles in parallel arrays, so one query is a single
+ * branch-free pass that handles two edges per SSE2 step. Build it once and query it from
+ * any number of threads.
+ */
+class ContourEdges2D {
+private:
+	std::vector<double> ax, ay, bx, by;		// chord endpoints, including the closing chord
+	std::vector<double> cx, cy;				// arc centers (0 for lines)
+	std::vector<double> radiusSq;			// squared arc radii (0 for lines, which disables the correction)
+	std::vector<double> direction;			// +1 for counter-clockwise arcs, -1 for clockwise ones
+	BoundingBox2D bounds;
+
+	void addLine(double x1, double y1, double x2, double y2);
+	void addArc(const MyPoint& a, const MyPoint& b, const MyPoint& c, double r, bool counterClockwise);
+	void close();
+
+public:
+	/**
+	* @brief Flattens a contour.
+	* @param contour Contour to flatten.
+	*/
+	explicit ContourEdges2D(const Contour2D& contour);
+	/**
+	* @brief Flattens segments [first, last) of a SegmentArrays2D.
+	* @param arrays Segment arrays.
+	* @param first Index of the first segment.
+	* @param last One past the index of the last segment.
+	*/
+	ContourEdges2D(const SegmentArrays2D& arrays, std::size_t first, std::size_t last);
+
+	/**
+	* @brief Computes the winding number around a point.
+	*
+	* Points outside the bounding box return 0 without touching the edges. Points on the
+	* contour itself get either neighbouring value.
+	*
+	* @param p Query point; Z is ignored.
+	* @return Winding number, positive for counter-clockwise windings.
+	*/
+	int windingNumber(const MyPoint& p) const;
+	/**
+	* @brief Returns the bounding box of the flattened contour.
+	* @return Bounding box including arc extremes.
+	*/
+	const BoundingBox2D& getBoundingBox() const { return bounds; }
+	/**
+	* @brief Returns the number of stored edges.
+	* @return Segment count, plus one if a closing chord was added.
+	*/
+	std::size_t size() const { return ax.size(); }
+};
+
+/**
+* @brief Computes the winding number of a contour around a point.
+*
+* Rejects points outside the cached Contour2D::boundingBox() first, then walks the
+* segments once without building any temporary storage.
+*
+* @param contour Contour to test.
+* @param p Query point.
+* @return Winding number, positive for counter-clockwise windings.
+*/
+int windingNumber(const Contour2D& contour, const MyPoint& p);
+
+/**
+* @brief Tells whether a point lies inside a contour under the non-zero winding rule.
+* @param contour Contour to test.
+* @param p Query point.
+* @return True if the winding number is not zero.
+*/
+bool containsPoint(const Contour2D& contour, const MyPoint& p);
+
+/**
+* @brief Computes winding numbers for many points against one contour.
+*
+* Flattens the contour once into a ContourEdges2D and spreads the points over the
+* executor's threads.
+*
+* @param contour Contour to test.
+* @param points Query points.
+* @param executor Executor that runs the queries.
+* @return One winding number per point.
+*/
+std::vector<int> windingNumbers(const Contour2D& contour, const std::vector<MyPoint>& points,
+	const ParallelExecutor& executor = ParallelExecutor());
+
+/**
+* @brief Classifies many points against one contour under the non-zero winding rule.
+* @param contour Contour to test.
+* @param points Query points.
+* @param executor Executor that runs the queries.
+* @return One flag per point, 1 if inside; bytes rather than std::vector<bool> so that
+*         threads can write neighbouring results.
+*/
+std::vector<unsigned char> containsPoints(const Contour2D& contour, const std::vector<MyPoint>& points,
+	const ParallelExecutor& executor = ParallelExecutor());
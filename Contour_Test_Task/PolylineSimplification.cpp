@@ -0,0 +1,319 @@
+/**
+ * @file PolylineSimplification.cpp
+ * @brief Implements Douglas-Peucker and heap-based Visvalingam-Whyatt simplification.
+ */
+#include "PolylineSimplification.h"
+#include "LineSegment2D.h"
+#include <queue>
+#include <algorithm>
+#include <utility>
+#include <functional>
+#include <stdexcept>
+
+namespace {
+
+	// Spans longer than this search their farthest point in parallel
+	const std::size_t parallelSearchSize = std::size_t(1) << 15;
+	// Visvalingam-Whyatt block length; fixed so the result does not depend on the thread count
+	const std::size_t blockSize = std::size_t(1) << 16;
+
+	struct Span {
+		std::size_t first;
+		std::size_t last;
+	};
+
+	struct Farthest {
+		std::size_t index = 0;
+		double distanceSq = -1;
+	};
+
+	// Squared XY distance from p to the segment ab; a point if a and b coincide
+	double squaredDistanceToSegment(const MyPoint& p, const MyPoint& a, const MyPoint& b) {
+		const double dx = b.getX() - a.getX();
+		const double dy = b.getY() - a.getY();
+		double px = p.getX() - a.getX();
+		double py = p.getY() - a.getY();
+		const double lengthSq = dx * dx + dy * dy;
+		if (lengthSq > 0) {
+			double t = (px * dx + py * dy) / lengthSq;
+			t = t < 0 ? 0 : (t > 1 ? 1 : t);
+			px -= t * dx;
+			py -= t * dy;
+		}
+		return px * px + py * py;
+	}
+
+	Farthest farthestInRange(const std::vector<MyPoint>& points, std::size_t first, std::size_t last, std::size_t begin, std::size_t end) {
+		Farthest best;
+		for (std::size_t i = begin; i < end; ++i) {
+			const double d = squaredDistanceToSegment(points[i], points[first], points[last]);
+			if (d > best.distanceSq) {
+				best.distanceSq = d;
+				best.index = i;
+			}
+		}
+		return best;
+	}
+
+	Farthest farthestPoint(const std::vector<MyPoint>& points, const Span& span, const ParallelExecutor& executor) {
+		const std::size_t count = span.last - span.first - 1;
+		if (count < parallelSearchSize || executor.getThreadCount() < 2) {
+			return farthestInRange(points, span.first, span.last, span.first + 1, span.last);
+		}
+		const std::size_t grain = executor.defaultGrainSize(count);
+		std::vector<Farthest> chunkBest(ParallelExecutor::chunkCount(count, grain));
+		executor.forChunks(count, grain, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+			chunkBest[chunk] = farthestInRange(points, span.first, span.last, span.first + 1 + begin, span.first + 1 + end);
+		});
+		// Chunks are reduced in order, so ties resolve as in the serial scan
+		Farthest best;
+		for (const auto& candidate : chunkBest) {
+			if (candidate.distanceSq > best.distanceSq) {
+				best = candidate;
+			}
+		}
+		return best;
+	}
+
+	void douglasPeuckerSerial(const std::vector<MyPoint>& points, Span root, double toleranceSq, std::vector<unsigned char>& keep) {
+		std::vector<Span> stack(1, root);
+		while (!stack.empty()) {
+			const Span span = stack.back();
+			stack.pop_back();
+			if (span.last - span.first < 2) {
+				continue;
+			}
+			const Farthest f = farthestInRange(points, span.first, span.last, span.first + 1, span.last);
+			if (f.distanceSq > toleranceSq) {
+				keep[f.index] = 1;
+				stack.push_back(Span{ span.first, f.index });
+				stack.push_back(Span{ f.index, span.last });
+			}
+		}
+	}
+
+	void douglasPeucker(const std::vector<MyPoint>& points, double toleranceSq, std::vector<unsigned char>& keep, const ParallelExecutor& executor) {
+		std::vector<Span> frontier(1, Span{ 0, points.size() - 1 });
+		const std::size_t target = 4 * static_cast<std::size_t>(executor.getThreadCount());
+
+		// Split breadth-first until every thread has spans of its own
+		while (executor.getThreadCount() > 1 && !frontier.empty() && frontier.size() < target) {
+			std::vector<Span> next;
+			for (const auto& span : frontier) {
+				if (span.last - span.first < 2) {
+					continue;
+				}
+				const Farthest f = farthestPoint(points, span, executor);
+				if (f.distanceSq > toleranceSq) {
+					keep[f.index] = 1;
+					next.push_back(Span{ span.first, f.index });
+					next.push_back(Span{ f.index, span.last });
+				}
+			}
+			frontier.swap(next);
+		}
+		// Spans are disjoint, so every keep flag has a single writer
+		executor.forChunks(frontier.size(), 1, [&](std::size_t, std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i) {
+				douglasPeuckerSerial(points, frontier[i], toleranceSq, keep);
+			}
+		});
+	}
+
+	void visvalingamBlock(const std::vector<MyPoint>& points, Span block, double toleranceSq, std::size_t minimumKept,
+		std::vector<unsigned char>& keep) {
+
+		const std::size_t count = block.last - block.first + 1;
+		std::vector<std::size_t> prev(count), next(count);
+		std::vector<double> cost(count);
+		typedef std::pair<double, std::size_t> Entry;
+		std::vector<Entry> entries;
+		entries.reserve(count);
+		for (std::size_t i = 1; i + 1 < count; ++i) {
+			prev[i] = i - 1;
+			next[i] = i + 1;
+			cost[i] = squaredDistanceToSegment(points[block.first + i], points[block.first + i - 1], points[block.first + i + 1]);
+			entries.push_back(Entry(cost[i], i));
+		}
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap(std::greater<Entry>(), std::move(entries));
+
+		// Entries are never updated in place; stale ones are skipped when their cost no longer matches
+		std::size_t kept = count;
+		auto refresh = [&](std::size_t i) {
+			if (i == 0 || i + 1 == count) {
+				return;
+			}
+			cost[i] = squaredDistanceToSegment(points[block.first + i], points[block.first + prev[i]], points[block.first + next[i]]);
+			heap.push(Entry(cost[i], i));
+		};
+		while (!heap.empty() && kept > minimumKept) {
+			const Entry top = heap.top();
+			heap.pop();
+			const std::size_t i = top.second;
+			if (!keep[block.first + i] || top.first != cost[i]) {
+				continue;
+			}
+			if (top.first > toleranceSq) {
+				break;
+			}
+			keep[block.first + i] = 0;
+			--kept;
+			next[prev[i]] = next[i];
+			prev[next[i]] = prev[i];
+			refresh(prev[i]);
+			refresh(next[i]);
+		}
+	}
+
+	void visvalingamWhyatt(const std::vector<MyPoint>& points, double toleranceSq, std::size_t minimumKept,
+		std::vector<unsigned char>& keep, const ParallelExecutor& executor) {
+
+		std::fill(keep.begin(), keep.end(), static_cast<unsigned char>(1));
+		const std::size_t edges = points.size() - 1;
+		const std::size_t blocks = ParallelExecutor::chunkCount(edges, blockSize);
+		executor.forChunks(edges, blockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+			visvalingamBlock(points, Span{ begin, end }, toleranceSq, blocks == 1 ? minimumKept : 2, keep);
+		});
+	}
+
+	// Keeps a third vertex if a closed polyline collapsed to its start and one other point
+	void keepTriangle(const std::vector<MyPoint>& points, std::vector<unsigned char>& keep) {
+		const std::size_t last = points.size() - 1;
+		std::size_t kept = 0;
+		std::size_t other = 0;
+		for (std::size_t i = 1; i < last; ++i) {
+			if (keep[i]) {
+				++kept;
+				other = i;
+			}
+		}
+		if (kept >= 2 || last < 3) {
+			return;
+		}
+		if (kept == 0) {
+			other = farthestInRange(points, 0, 0, 1, last).index;
+			keep[other] = 1;
+		}
+		Farthest best = farthestInRange(points, 0, other, 1, other);
+		const Farthest after = farthestInRange(points, other, last, other + 1, last);
+		if (after.distanceSq > best.distanceSq) {
+			best = after;
+		}
+		keep[best.index] = 1;
+	}
+
+	void flushRun(Contour2D& result, const std::vector<MyPoint>& run, double tolerance, SimplificationMethod method,
+		const ParallelExecutor& executor) {
+
+		if (run.size() < 2) {
+			return;
+		}
+		const std::vector<MyPoint> kept = simplifyPolyline(run, tolerance, false, method, executor);
+		for (std::size_t i = 0; i + 1 < kept.size(); ++i) {
+			result.addSegment(std::make_unique<LineSegment2D>(kept[i], kept[i + 1]));
+		}
+	}
+
+}
+
+std::vector<MyPoint> simplifyPolyline(const std::vector<MyPoint>& points, double tolerance, bool closed,
+	SimplificationMethod method, const ParallelExecutor& executor) {
+
+	if (tolerance < 0) {
+		throw std::invalid_argument("Negative tolerance in simplifyPolyline()");
+	}
+	const std::size_t minimumKept = closed ? 4 : 2;
+	if (points.size() < minimumKept) {
+		return points;
+	}
+	// A closed polyline is handled as an open one that returns to its start
+	std::vector<MyPoint> closedCopy;
+	if (closed) {
+		closedCopy.reserve(points.size() + 1);
+		closedCopy.assign(points.begin(), points.end());
+		closedCopy.push_back(points.front());
+	}
+	const std::vector<MyPoint>& path = closed ? closedCopy : points;
+
+	std::vector<unsigned char> keep(path.size(), 0);
+	const double toleranceSq = tolerance * tolerance;
+	if (method == SimplificationMethod::DouglasPeucker) {
+		keep.front() = 1;
+		keep.back() = 1;
+		douglasPeucker(path, toleranceSq, keep, executor);
+	}
+	else {
+		visvalingamWhyatt(path, toleranceSq, minimumKept, keep, executor);
+	}
+	if (closed) {
+		keepTriangle(path, keep);
+	}
+
+	std::vector<MyPoint> result;
+	for (std::size_t i = 0; i < points.size(); ++i) {
+		if (keep[i]) {
+			result.push_back(points[i]);
+		}
+	}
+	return result;
+}
+
+Contour2D simplifyContour(const Contour2D& contour, double tolerance, SimplificationMethod method, const ParallelExecutor& executor) {
+	if (tolerance < 0) {
+		throw std::invalid_argument("Negative tolerance in simplifyContour()");
+	}
+	Contour2D result;
+	const std::size_t count = contour.getSegmentCount();
+	if (count == 0) {
+		return result;
+	}
+	bool allLines = true;
+	for (const auto& seg : contour) {
+		allLines = allLines && seg.getKind() == SegmentKind::Line;
+	}
+	if (allLines && count >= 3 && contour.isClosedShape()) {
+		std::vector<MyPoint> ring;
+		ring.reserve(count);
+		for (const auto& seg : contour) {
+			ring.push_back(seg.getPointA());
+		}
+		const std::vector<MyPoint> kept = simplifyPolyline(ring, tolerance, true, method, executor);
+		for (std::size_t i = 0; i < kept.size(); ++i) {
+			result.addSegment(std::make_unique<LineSegment2D>(kept[i], i + 1 < kept.size() ? kept[i + 1] : contour.getSegmentAt(count - 1).getPointB()));
+		}
+		return result;
+	}
+
+	std::vector<MyPoint> run;
+	for (const auto& seg : contour) {
+		if (seg.getKind() == SegmentKind::Line) {
+			if (run.empty()) {
+				run.push_back(seg.getPointA());
+			}
+			run.push_back(seg.getPointB());
+		}
+		else {
+			flushRun(result, run, tolerance, method, executor);
+			run.clear();
+			result.addSegment(seg.clone());
+		}
+	}
+	flushRun(result, run, tolerance, method, executor);
+	return result;
+}
+
+std::vector<Contour2D> simplifyContours(const std::vector<Contour2D>& contours, double tolerance, SimplificationMethod method,
+	const ParallelExecutor& executor) {
+
+	if (tolerance < 0) {
+		throw std::invalid_argument("Negative tolerance in simplifyContours()");
+	}
+	std::vector<Contour2D> result(contours.size());
+	const ParallelExecutor serial(1);
+	executor.forChunks(contours.size(), 1, [&](std::size_t, std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i) {
+			result[i] = simplifyContour(contours[i], tolerance, method, serial);
+		}
+	});
+	return result;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file PolylineSimplification.h
+ * @brief Douglas-Peucker and Visvalingam-Whyatt simplification of polylines and contours.
+ */
+#pragma once
+#include <vector>
+#include "Contour2D.h"
+#include "ParallelFor.h"
+
+ /**
+ * @enum SimplificationMethod
+ * @brief Vertex-removal strategy used by the simplification functions.
+ */
+enum class SimplificationMethod : unsigned char {
+	DouglasPeucker,		///< Keeps the farthest point of every span until all points are within tolerance.
+	VisvalingamWhyatt	///< Repeatedly removes the vertex closest to the chord of its neighbours.
+};
+
+/**
+* @brief Removes polyline vertices that deviate less than a tolerance.
+*
+* Douglas-Peucker keeps a subset of the input whose polyline stays within tolerance of
+* every removed point. Large spans are split breadth-first, with the farthest-point search
+* spread over the executor, until there are enough independent spans to hand one to each
+* thread; the result does not depend on the thread count. Every split rescans the points of
+* its span, so Douglas-Peucker does NOT have an O(n log n) bound: it is O(n^2) in the worst
+* case, when each farthest point lies next to an end of its span (for example a tightly
+* wound spiral with a small tolerance), and only reaches O(n log n) when the farthest
+* points split spans roughly evenly.
+*
+* Visvalingam-Whyatt is the only method with an O(n log n) worst case; use it for large
+* inputs whose shape is not known in advance. It keeps its candidates in a heap keyed by
+* the distance of each vertex to the chord of its neighbours. The tolerance bounds each single
+* removal, so the accumulated deviation can exceed it slightly. Inputs longer than 65536
+* points are cut into blocks of that size whose joints are kept, and the blocks are
+* simplified in parallel.
+*
+* A closed polyline keeps its first point and at least three vertices, so it still
+* encloses an area.
+*
+* @param points Polyline vertices, as accepted by polylineContourFromPoints().
+* @param tolerance Largest allowed distance, in the XY plane, of a removed point.
+* @param closed True if the last point connects back to the first.
+* @param method Simplification strategy.
+* @param executor Executor that runs the parallel parts.
+* @return The kept vertices in their original order.
+* @throws std::invalid_argument If tolerance is negative.
+*/
+std::vector<MyPoint> simplifyPolyline(const std::vector<MyPoint>& points, double tolerance, bool closed,
+	SimplificationMethod method = SimplificationMethod::DouglasPeucker, const ParallelExecutor& executor = ParallelExecutor());
+
+/**
+* @brief Simplifies the runs of line segments of a contour.
+*
+* Every maximal run of consecutive lines is simplified as an open polyline whose ends stay
+* fixed; arcs are copied unchanged. A contour made only of lines that closes on itself is
+* simplified as a closed polyline. Kept vertices are original segment endpoints, so the
+* result stays connected and closed wherever the input was.
+*
+* @param contour Contour to simplify.
+* @param tolerance Largest allowed distance of a removed point.
+* @param method Simplification strategy.
+* @param executor Executor that runs the parallel parts.
+* @return Simplified contour with the same start point.
+* @throws std::invalid_argument If tolerance is negative.
+*/
+Contour2D simplifyContour(const Contour2D& contour, double tolerance,
+	SimplificationMethod method = SimplificationMethod::DouglasPeucker, const ParallelExecutor& executor = ParallelExecutor());
+
+/**
+* @brief Simplifies many contours, one contour per task.
+* @param contours Contours to simplify.
+* @param tolerance Largest allowed distance of a removed point.
+* @param method Simplification strategy.
+* @param executor Executor that runs the contours.
+* @return One simplified contour per input, in the same order.
+* @throws std::invalid_argument If tolerance is negative.
+*/
+std::vector<Contour2D> simplifyContours(const std::vector<Contour2D>& contours, double tolerance,
+	SimplificationMethod method = SimplificationMethod::DouglasPeucker, const ParallelExecutor& executor = ParallelExecutor());
@@ -0,0 +1,321 @@
+/**
+ * @file PreparedContour2D.cpp
+ * @brief Implements grid construction and point location for PreparedContour2D.
+ */
+#include "PreparedContour2D.h"
+#include "ArcSegment2D.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+	const std::size_t maxCellsPerAxis = 1024;
+
+	inline double isLeft(double ax, double ay, double bx, double by, double px, double py) {
+		return (bx - ax) * (py - ay) - (px - ax) * (by - ay);
+	}
+
+	double squaredDistanceToChord(double ax, double ay, double bx, double by, double px, double py) {
+		const double ex = bx - ax;
+		const double ey = by - ay;
+		const double lengthSq = ex * ex + ey * ey;
+		double t = lengthSq > 0 ? ((px - ax) * ex + (py - ay) * ey) / lengthSq : 0.0;
+		t = std::min(std::max(t, 0.0), 1.0);
+		const double qx = ax + t * ex - px;
+		const double qy = ay + t * ey - py;
+		return qx * qx + qy * qy;
+	}
+
+}
+
+PreparedContour2D::PreparedContour2D(const Contour2D& contour, double tolerance_) : tolerance(tolerance_) {
+	const std::size_t count = contour.getSegmentCount() + 1;
+	ax.reserve(count); ay.reserve(count); bx.reserve(count); by.reserve(count);
+	cx.reserve(count); cy.reserve(count); radius.reserve(count);
+	direction.reserve(count); ccwStart.reserve(count); sweep.reserve(count);
+
+	for (const auto& seg : contour) {
+		if (seg.getKind() == SegmentKind::Arc) {
+			const ArcSegment2D& arc = static_cast<const ArcSegment2D&>(seg);
+			const bool ccw = arc.isCounterClockwise();
+			addArc(arc.getPointA(), arc.getPointB(), arc.getCenter(), arc.getRadius(),
+				ccw ? arc.getStartAngle() : arc.getEndAngle(), arc.getSweepAngle(), ccw);
+		}
+		else {
+			addEdge(seg.getPointA(), seg.getPointB());
+		}
+	}
+	if (!ax.empty() && (bx.back() != ax.front() || by.back() != ay.front())) {
+		addEdge(MyPoint(bx.back(), by.back()), MyPoint(ax.front(), ay.front()));
+	}
+
+	for (std::size_t e = 0; e < ax.size(); ++e) {
+		bounds.expand(edgeBounds(e));
+	}
+	if (!bounds.isEmpty()) {
+		bounds = bounds.inflated(tolerance);
+	}
+	buildGrid();
+}
+
+void PreparedContour2D::addEdge(const MyPoint& a, const MyPoint& b) {
+	ax.push_back(a.getX()); ay.push_back(a.getY());
+	bx.push_back(b.getX()); by.push_back(b.getY());
+	cx.push_back(0.0); cy.push_back(0.0);
+	radius.push_back(0.0);
+	direction.push_back(0.0);
+	ccwStart.push_back(0.0);
+	sweep.push_back(0.0);
+}
+
+void PreparedContour2D::addArc(const MyPoint& a, const MyPoint& b, const MyPoint& c, double r, double start, double span, bool counterClockwise) {
+	ax.push_back(a.getX()); ay.push_back(a.getY());
+	bx.push_back(b.getX()); by.push_back(b.getY());
+	cx.push_back(c.getX()); cy.push_back(c.getY());
+	radius.push_back(r);
+	direction.push_back(counterClockwise ? 1.0 : -1.0);
+	ccwStart.push_back(start);
+	sweep.push_back(span);
+}
+
+/**
+ * @brief Returns the box covering an edge and, for arcs, the region between arc and chord.
+ * @param edge Edge index.
+ * @return Edge bounding box.
+ */
+BoundingBox2D PreparedContour2D::edgeBounds(std::size_t edge) const {
+	const MyPoint a(ax[edge], ay[edge]);
+	const MyPoint b(bx[edge], by[edge]);
+	if (direction[edge] != 0.0) {
+		return ArcSegment2D::boundingBoxOf(a, b, MyPoint(cx[edge], cy[edge]), radius[edge], ccwStart[edge], sweep[edge]);
+	}
+	return BoundingBox2D(a, b);
+}
+
+std::size_t PreparedContour2D::cellOf(double x, double y) const {
+	const double fx = (x - bounds.getMinX()) / cellWidth;
+	const double fy = (y - bounds.getMinY()) / cellHeight;
+	const std::size_t ix = fx <= 0 ? 0 : std::min(static_cast<std::size_t>(fx), cellsX - 1);
+	const std::size_t iy = fy <= 0 ? 0 : std::min(static_cast<std::size_t>(fy), cellsY - 1);
+	return iy * cellsX + ix;
+}
+
+/**
+ * @brief Picks the reference point of a cell: its center, unless a chord passes through it.
+ *
+ * The winding number at a point on a chord depends on the direction of the ray used to
+ * count it, so such a point cannot serve as a reference. The center is then moved along
+ * a fixed low-discrepancy sequence that stays well inside the cell.
+ */
+MyPoint PreparedContour2D::cellAnchor(std::size_t ix, std::size_t iy) const {
+	const std::size_t cell = iy * cellsX + ix;
+	const double margin = 1e-9 * (cellWidth + cellHeight);
+	MyPoint anchor;
+	for (int attempt = 0; attempt < 16; ++attempt) {
+		const double fx = attempt == 0 ? 0.5 : 0.1 + 0.8 * std::fmod(attempt * 0.6180339887, 1.0);
+		const double fy = attempt == 0 ? 0.5 : 0.1 + 0.8 * std::fmod(attempt * 0.7548776662, 1.0);
+		anchor = MyPoint(bounds.getMinX() + (ix + fx) * cellWidth, bounds.getMinY() + (iy + fy) * cellHeight);
+		bool clear = true;
+		for (std::size_t k = cellStart[cell]; k < cellStart[cell + 1] && clear; ++k) {
+			const std::size_t e = cellEdges[k];
+			clear = squaredDistanceToChord(ax[e], ay[e], bx[e], by[e], anchor.getX(), anchor.getY()) > margin * margin;
+		}
+		if (clear) {
+			break;
+		}
+	}
+	return anchor;
+}
+
+/**
+ * @brief Lays out the grid, buckets the edges and stores the chord winding at every anchor.
+ *
+ * The first anchor of each row is evaluated against all chords; the others follow from
+ * their left neighbour by counting the crossings between the two anchors. Two neighbouring
+ * cells form a rectangle, so the path between their anchors only meets their own edges.
+ */
+void PreparedContour2D::buildGrid() {
+	const std::size_t edgeCount = ax.size();
+	if (edgeCount > 0 && bounds.getWidth() > 0 && bounds.getHeight() > 0) {
+		// About one cell per edge, shaped to the aspect ratio of the contour
+		const double aspect = bounds.getWidth() / bounds.getHeight();
+		const double columns = std::ceil(std::sqrt(static_cast<double>(edgeCount) * aspect));
+		cellsX = static_cast<std::size_t>(std::min(std::max(columns, 1.0), static_cast<double>(maxCellsPerAxis)));
+		cellsY = std::min(std::max<std::size_t>((edgeCount + cellsX - 1) / cellsX, 1), maxCellsPerAxis);
+		cellWidth = bounds.getWidth() / cellsX;
+		cellHeight = bounds.getHeight() / cellsY;
+	}
+	const std::size_t cellCount = cellsX * cellsY;
+
+	// Two passes over the edge boxes: count per cell, then fill the compact lists
+	cellStart.assign(cellCount + 1, 0);
+	auto forEachCell = [this](std::size_t edge, auto&& visit) {
+		const BoundingBox2D box = edgeBounds(edge).inflated(tolerance);
+		const std::size_t low = cellOf(box.getMinX(), box.getMinY());
+		const std::size_t high = cellOf(box.getMaxX(), box.getMaxY());
+		for (std::size_t iy = low / cellsX; iy <= high / cellsX; ++iy) {
+			for (std::size_t ix = low % cellsX; ix <= high % cellsX; ++ix) {
+				visit(iy * cellsX + ix);
+			}
+		}
+	};
+	for (std::size_t e = 0; e < edgeCount; ++e) {
+		forEachCell(e, [this](std::size_t cell) { ++cellStart[cell + 1]; });
+	}
+	for (std::size_t c = 0; c < cellCount; ++c) {
+		cellStart[c + 1] += cellStart[c];
+	}
+	cellEdges.resize(cellStart[cellCount]);
+	std::vector<std::size_t> fill(cellStart.begin(), cellStart.end() - 1);
+	for (std::size_t e = 0; e < edgeCount; ++e) {
+		forEachCell(e, [this, &fill, e](std::size_t cell) { cellEdges[fill[cell]++] = e; });
+	}
+
+	anchors.resize(cellCount);
+	for (std::size_t c = 0; c < cellCount; ++c) {
+		anchors[c] = cellAnchor(c % cellsX, c / cellsX);
+	}
+	anchorWinding.assign(cellCount, 0);
+	if (edgeCount == 0) {
+		return;
+	}
+	std::vector<std::size_t> seen(edgeCount, static_cast<std::size_t>(-1));
+	for (std::size_t iy = 0; iy < cellsY; ++iy) {
+		int winding = chordWindingDirect(anchors[iy * cellsX]);
+		anchorWinding[iy * cellsX] = winding;
+		for (std::size_t ix = 1; ix < cellsX; ++ix) {
+			const std::size_t stamp = iy * cellsX + ix;
+			for (std::size_t cell = stamp - 1; cell <= stamp; ++cell) {
+				for (std::size_t k = cellStart[cell]; k < cellStart[cell + 1]; ++k) {
+					const std::size_t e = cellEdges[k];
+					if (seen[e] != stamp) {
+						seen[e] = stamp;
+						winding -= crossingsBetween(e, anchors[stamp - 1], anchors[stamp]);
+					}
+				}
+			}
+			anchorWinding[stamp] = winding;
+		}
+	}
+}
+
+/**
+ * @brief Winding number of the chord polygon by a full pass over all chords.
+ * @param p Query point.
+ * @return Chord polygon winding number.
+ */
+int PreparedContour2D::chordWindingDirect(const MyPoint& p) const {
+	const double px = p.getX();
+	const double py = p.getY();
+	int winding = 0;
+	for (std::size_t e = 0; e < ax.size(); ++e) {
+		const double side = isLeft(ax[e], ay[e], bx[e], by[e], px, py);
+		if (ay[e] <= py) {
+			winding += (by[e] > py && side > 0) ? 1 : 0;
+		}
+		else {
+			winding -= (by[e] <= py && side < 0) ? 1 : 0;
+		}
+	}
+	return winding;
+}
+
+/**
+ * @brief Change in one chord's winding contribution between two points.
+ *
+ * Applies the crossing rule with the ray pointing from "from" through "to". Both points
+ * lie on that ray, so their contributions differ only if the chord crosses the ray between
+ * them; the winding number of the chord polygon at "to" is the one at "from" minus the
+ * sum of these values.
+ *
+ * @param edge Chord index.
+ * @param from Start of the path.
+ * @param to End of the path.
+ * @return Contribution at "from" minus contribution at "to": -1, 0 or +1.
+ */
+int PreparedContour2D::crossingsBetween(std::size_t edge, const MyPoint& from, const MyPoint& to) const {
+	const double dx = to.getX() - from.getX();
+	const double dy = to.getY() - from.getY();
+	// Signed distances of the chord endpoints from the line through both points
+	const double ya = dx * (ay[edge] - from.getY()) - dy * (ax[edge] - from.getX());
+	const double yb = dx * (by[edge] - from.getY()) - dy * (bx[edge] - from.getX());
+	const double sideFrom = isLeft(ax[edge], ay[edge], bx[edge], by[edge], from.getX(), from.getY());
+	const double sideTo = isLeft(ax[edge], ay[edge], bx[edge], by[edge], to.getX(), to.getY());
+	if (ya <= 0 && yb > 0) {
+		return (sideFrom > 0 ? 1 : 0) - (sideTo > 0 ? 1 : 0);
+	}
+	if (ya > 0 && yb <= 0) {
+		return (sideTo < 0 ? 1 : 0) - (sideFrom < 0 ? 1 : 0);
+	}
+	return 0;
+}
+
+bool PreparedContour2D::isOnEdge(std::size_t edge, const MyPoint& p) const {
+	const double px = p.getX();
+	const double py = p.getY();
+	if (direction[edge] == 0.0) {
+		const double ex = bx[edge] - ax[edge];
+		const double ey = by[edge] - ay[edge];
+		const double lengthSq = ex * ex + ey * ey;
+		double t = lengthSq > 0 ? ((px - ax[edge]) * ex + (py - ay[edge]) * ey) / lengthSq : 0.0;
+		t = std::min(std::max(t, 0.0), 1.0);
+		const double qx = ax[edge] + t * ex - px;
+		const double qy = ay[edge] + t * ey - py;
+		return qx * qx + qy * qy <= tolerance * tolerance;
+	}
+	const double dx = px - cx[edge];
+	const double dy = py - cy[edge];
+	const double r = radius[edge];
+	if (std::abs(std::sqrt(dx * dx + dy * dy) - r) > tolerance) {
+		return false;
+	}
+	double offset = std::atan2(dy, dx) - ccwStart[edge];
+	offset -= 2 * M_PI * std::floor(offset / (2 * M_PI));
+	const double slack = r > 0 ? tolerance / r : 0.0;
+	return offset <= sweep[edge] + slack || offset >= 2 * M_PI - slack;
+}
+
+int PreparedContour2D::windingNumber(const MyPoint& p) const {
+	if (!bounds.contains(p)) {
+		return 0;
+	}
+	const std::size_t cell = cellOf(p.getX(), p.getY());
+	int winding = anchorWinding[cell];
+	for (std::size_t k = cellStart[cell]; k < cellStart[cell + 1]; ++k) {
+		const std::size_t e = cellEdges[k];
+		winding -= crossingsBetween(e, anchors[cell], p);
+		// Arc region correction, as in ::windingNumber(); the region lies inside the arc's box
+		if (direction[e] != 0.0) {
+			const double dx = p.getX() - cx[e];
+			const double dy = p.getY() - cy[e];
+			if (dx * dx + dy * dy < radius[e] * radius[e]
+				&& direction[e] * isLeft(ax[e], ay[e], bx[e], by[e], p.getX(), p.getY()) < 0) {
+				winding += direction[e] > 0 ? 1 : -1;
+			}
+		}
+	}
+	return winding;
+}
+
+PointLocation PreparedContour2D::locate(const MyPoint& p) const {
+	if (!bounds.contains(p)) {
+		return PointLocation::Outside;
+	}
+	const std::size_t cell = cellOf(p.getX(), p.getY());
+	for (std::size_t k = cellStart[cell]; k < cellStart[cell + 1]; ++k) {
+		if (isOnEdge(cellEdges[k], p)) {
+			return PointLocation::Boundary;
+		}
+	}
+	return windingNumber(p) != 0 ? PointLocation::Inside : PointLocation::Outside;
+}
+
+std::vector<PointLocation> PreparedContour2D::locate(const std::vector<MyPoint>& points, const ParallelExecutor& executor) const {
+	std::vector<PointLocation> result(points.size());
+	executor.forChunks(points.size(), executor.defaultGrainSize(points.size()), [&](std::size_t, std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i) {
+			result[i] = locate(points[i]);
+		}
+	});
+	return result;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file PreparedContour2D.h
+ * @brief Defines a point-location structure for repeated containment queries on one contour.
+ */
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "Contour2D.h"
+#include "BoundingBox2D.h"
+#include "ParallelFor.h"
+
+ /**
+ * @enum PointLocation
+ * @brief Position of a point relative to a closed contour.
+ */
+enum class PointLocation : unsigned char {
+	Outside,	///< Winding number zero.
+	Inside,		///< Non-zero winding number.
+	Boundary	///< Within tolerance of the contour itself.
+};
+
+ /**
+ * @class PreparedContour2D
+ * @brief Uniform grid over a contour that answers containment queries in near O(1).
+ *
+ * Every grid cell lists the edges whose bounding box overlaps it, and stores the winding
+ * number of the chord polygon (arcs replaced by their chords) at an anchor point: its
+ * center, or a point nearby if a chord passes through the center. A query starts from the
+ * anchor of the cell holding the point and only counts chord crossings along the short
+ * path from the anchor to the point, which can only involve edges listed in that cell.
+ * Arcs of the cell then add their region correction as in windingNumber().
+ *
+ * Building costs O(n + cells) plus one full winding test per grid row. The
+ * PreparedContourBreakEven test measures when that is repaid against the direct O(n)
+ * test; for star polygons of 100 to 10000 segments it took roughly 60 to 600 queries.
+ * Open contours are closed by a chord from their end to their start.
+ */
+class PreparedContour2D {
+private:
+	// Edge i is the chord from (ax, ay) to (bx, by); arcs also carry their circle and sweep
+	std::vector<double> ax, ay, bx, by;
+	std::vector<double> cx, cy, radius;
+	std::vector<double> direction;		// +1 counter-clockwise arc, -1 clockwise arc, 0 line
+	std::vector<double> ccwStart, sweep;
+
+	BoundingBox2D bounds;
+	double tolerance;
+	std::size_t cellsX = 1;
+	std::size_t cellsY = 1;
+	double cellWidth = 1.0;
+	double cellHeight = 1.0;
+	std::vector<std::size_t> cellStart;		// cell c lists cellEdges[cellStart[c] .. cellStart[c + 1])
+	std::vector<std::size_t> cellEdges;
+	std::vector<MyPoint> anchors;			// reference point of each cell, off every chord
+	std::vector<int> anchorWinding;			// chord polygon winding at each anchor
+
+	void addEdge(const MyPoint& a, const MyPoint& b);
+	void addArc(const MyPoint& a, const MyPoint& b, const MyPoint& c, double r, double start, double span, bool counterClockwise);
+	BoundingBox2D edgeBounds(std::size_t edge) const;
+	void buildGrid();
+	std::size_t cellOf(double x, double y) const;
+	MyPoint cellAnchor(std::size_t cx_, std::size_t cy_) const;
+	int chordWindingDirect(const MyPoint& p) const;
+	int crossingsBetween(std::size_t edge, const MyPoint& from, const MyPoint& to) const;
+	bool isOnEdge(std::size_t edge, const MyPoint& p) const;
+
+public:
+	/**
+	* @brief Prepares a contour for point location.
+	* @param contour Contour to prepare; it is copied, so it may change afterwards.
+	* @param tolerance Distance within which a point counts as on the boundary.
+	*/
+	explicit PreparedContour2D(const Contour2D& contour, double tolerance = Contour2D::defaultEpsilon);
+
+	/**
+	* @brief Classifies a point as inside, outside or on the boundary.
+	* @param p Query point; Z is ignored.
+	* @return Location under the non-zero winding rule.
+	*/
+	PointLocation locate(const MyPoint& p) const;
+	/**
+	* @brief Computes the winding number around a point.
+	*
+	* Matches ::windingNumber() for points that are not on the contour.
+	*
+	* @param p Query point.
+	* @return Winding number, positive for counter-clockwise windings.
+	*/
+	int windingNumber(const MyPoint& p) const;
+	/**
+	* @brief Tells whether a point lies inside, boundary excluded.
+	* @param p Query point.
+	* @return True if locate() returns Inside.
+	*/
+	bool contains(const MyPoint& p) const { return locate(p) == PointLocation::Inside; }
+	/**
+	* @brief Classifies many points, spread over the executor's threads.
+	* @param points Query points.
+	* @param executor Executor that runs the queries.
+	* @return One location per point.
+	*/
+	std::vector<PointLocation> locate(const std::vector<MyPoint>& points, const ParallelExecutor& executor = ParallelExecutor()) const;
+
+	/**
+	* @brief Returns the grid resolution along X.
+	* @return Number of cell columns.
+	*/
+	std::size_t getCellCountX() const { return cellsX; }
+	/**
+	* @brief Returns the grid resolution along Y.
+	* @return Number of cell rows.
+	*/
+	std::size_t getCellCountY() const { return cellsY; }
+	/**
+	* @brief Returns the bounding box covered by the grid.
+	* @return Contour bounding box grown by the tolerance.
+	*/
+	const BoundingBox2D& getBoundingBox() const { return bounds; }
+};
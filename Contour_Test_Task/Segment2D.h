@@ -9,6 +9,26 @@
 #define _USE_MATH_DEFINES 
 #include <math.h>
 #include "MyPoint.h"
+#include "BoundingBox2D.h"
+
+ /**
+  * @enum SegmentKind
+  * @brief Identifies the concrete geometry behind a Segment2D.
+  */
+enum class SegmentKind : unsigned char {
+	Line,	///< Straight segment (LineSegment2D).
+	Arc		///< Circular arc (ArcSegment2D).
+};
+
+ /**
+  * @enum Orientation
+  * @brief Winding direction of a closed contour.
+  */
+enum class Orientation : unsigned char {
+	CounterClockwise,	///< Positive signed area.
+	Clockwise,			///< Negative signed area.
+	Degenerate			///< Area within tolerance of zero.
+};
 
  /**
   * @class Segment2D
@@ -18,10 +38,6 @@
   * and point access. Used as a polymorphic base for concrete types such as LineSegment2D and ArcSegment2D.
   */
 class Segment2D {
-private:
-	MyPoint pointA, pointB;
-	double myLength;
-
 public:
 	/**
 	* @brief Virtual destructor.
@@ -33,6 +49,11 @@ public:
 	*/
 	virtual std::unique_ptr<Segment2D> clone() const = 0;  // Cloning for copying
 	/**
+	* @brief Returns the concrete kind of the segment.
+	* @return SegmentKind::Line or SegmentKind::Arc.
+	*/
+	virtual SegmentKind getKind() const = 0;
+	/**
 	* @brief Returns a reference to the starting point of the segment.
 	* @return Const reference to point A.
 	*/
@@ -49,10 +70,69 @@ public:
 	*/
 	virtual void move(double dx, double dy) = 0;
 	/**
+	* @brief Reverses the direction of travel; point A and point B swap roles.
+	*
+	* The set of points covered by the segment does not change.
+	*/
+	virtual void reverse() = 0;
+	/**
 	* @brief Calculates and updates the segment's length.
 	*/
 	virtual void length() = 0;
 	/**
+	* @brief Returns the stored length of the segment.
+	* @return Length along the segment.
+	*/
+	virtual double getLength() const = 0;
+	/**
+	* @brief Returns the smallest axis-aligned box containing the whole segment.
+	* @return Bounding box in the XY plane.
+	*/
+	virtual BoundingBox2D getBoundingBox() const = 0;
+	/**
+	* @brief Returns the segment's share of the signed area of a closed contour.
+	*
+	* This is the integral of (x dy - y dx) / 2 along the segment from point A to point B.
+	* Summed over a closed contour it gives the enclosed area, positive if counter-clockwise.
+	*
+	* @return Signed area term.
+	*/
+	virtual double getSignedAreaTerm() const = 0;
+	/**
+	* @brief Returns the point at a given distance along the segment from point A.
+	* @param distance Distance along the segment, expected in [0, getLength()].
+	* @return Point on the segment.
+	*/
+	virtual MyPoint pointAtLength(double distance) const = 0;
+	/**
+	* @brief Returns the unit direction of travel at a given distance from point A.
+	* @param distance Distance along the segment, expected in [0, getLength()].
+	* @return Unit tangent vector stored as a point (Z = 0).
+	*/
+	virtual MyPoint tangentAtLength(double distance) const = 0;
+	/**
+	* @brief Returns the point of the segment nearest to a given point.
+	* @param p Query point; Z is ignored.
+	* @return Nearest point on the segment.
+	*/
+	virtual MyPoint closestPoint(const MyPoint& p) const = 0;
+	/**
+	* @brief Returns the distance along the segment from point A to the projection of a point.
+	*
+	* The inverse of pointAtLength() for points on the segment.
+	*
+	* @param p Point on or near the segment.
+	* @return Distance in [0, getLength()].
+	*/
+	virtual double lengthAtPoint(const MyPoint& p) const = 0;
+	/**
+	* @brief Creates the part of the segment between two of its points.
+	* @param from Start of the part; should lie on the segment.
+	* @param to End of the part, further along the direction of travel than from.
+	* @return New segment of the same kind, running from from to to.
+	*/
+	virtual std::unique_ptr<Segment2D> subSegment(const MyPoint& from, const MyPoint& to) const = 0;
+	/**
 	* @brief Checks if the segment length exceeds a given threshold.
 	* @param epsilon Minimum non-zero threshold.
 	* @return True if length is greater than epsilon.
@@ -0,0 +1,57 @@
+/**
+ * @file SegmentArena.cpp
+ * @brief Implements the SegmentArena block allocator.
+ */
+#include "SegmentArena.h"
+#include "LineSegment2D.h"
+#include "ArcSegment2D.h"
+#include <new>
+#include <algorithm>
+
+void SegmentArena::addBlock(std::size_t minSize) {
+	const std::size_t payload = std::max(blockSize, minSize);
+	const std::size_t headerSize = (sizeof(Block) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+	char* raw = static_cast<char*>(::operator new(headerSize + payload));
+	Block* block = reinterpret_cast<Block*>(raw);
+	block->next = blocks;
+	block->size = headerSize + payload;
+	blocks = block;
+	cursor = raw + headerSize;
+	limit = cursor + payload;
+	++upstreamAllocations;
+}
+
+void* SegmentArena::allocate(std::size_t size, std::size_t alignment) {
+	std::size_t misalign = reinterpret_cast<std::size_t>(cursor) & (alignment - 1);
+	std::size_t padding = misalign ? alignment - misalign : 0;
+	if (cursor == nullptr || padding + size > static_cast<std::size_t>(limit - cursor)) {
+		addBlock(size + alignment);
+		misalign = reinterpret_cast<std::size_t>(cursor) & (alignment - 1);
+		padding = misalign ? alignment - misalign : 0;
+	}
+	char* result = cursor + padding;
+	cursor = result + size;
+	++allocations;
+	bytesInUse += size;
+	return result;
+}
+
+void SegmentArena::release() {
+	while (blocks) {
+		Block* next = blocks->next;
+		::operator delete(blocks);
+		blocks = next;
+	}
+	cursor = nullptr;
+	limit = nullptr;
+	upstreamAllocations = 0;
+	allocations = 0;
+	bytesInUse = 0;
+}
+
+std::unique_ptr<Segment2D> SegmentArena::copy(const Segment2D& segment) {
+	if (segment.getKind() == SegmentKind::Arc) {
+		return std::unique_ptr<Segment2D>(new (*this) ArenaSegment<ArcSegment2D>(static_cast<const ArcSegment2D&>(segment)));
+	}
+	return std::unique_ptr<Segment2D>(new (*this) ArenaSegment<LineSegment2D>(static_cast<const LineSegment2D&>(segment)));
+}
@@ -0,0 +1,145 @@
+/**
+ * @file SegmentArena.h
+ * @brief Defines a monotonic arena that Segment2D objects can be allocated from.
+ *
+ * Segments are placed in an arena only when created through SegmentArena::make() or
+ * SegmentArena::copy(); everything else, including clone() and the clones made when a
+ * copy-on-write Contour2D detaches, goes to the heap as usual. Deleting an arena segment
+ * is a no-op; the memory is returned in one step by release().
+ */
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include "Segment2D.h"
+
+ /**
+  * @class SegmentArena
+  * @brief Monotonic bump allocator for contour segments.
+  *
+  * Memory is taken from the heap in large blocks and handed out sequentially. Individual
+  * deallocations are ignored; release() (or the destructor) frees all blocks at once.
+  * The arena must outlive every segment allocated from it. An arena is not thread-safe,
+  * but separate threads may each use their own arena.
+  */
+class SegmentArena {
+private:
+	struct Block {
+		Block* next;
+		std::size_t size;
+	};
+
+	Block* blocks = nullptr;
+	char* cursor = nullptr;
+	char* limit = nullptr;
+	std::size_t blockSize;
+	std::size_t upstreamAllocations = 0;
+	std::size_t allocations = 0;
+	std::size_t bytesInUse = 0;
+
+	void addBlock(std::size_t minSize);
+
+public:
+
+	static constexpr std::size_t defaultBlockSize = 64 * 1024;
+	/**
+	* @brief Creates an empty arena.
+	* @param blockSize_ Size in bytes of each block requested from the heap.
+	*/
+	explicit SegmentArena(std::size_t blockSize_ = defaultBlockSize) : blockSize(blockSize_) {}
+	/**
+	* @brief Destructor. Releases all blocks.
+	*/
+	~SegmentArena() { release(); }
+	SegmentArena(const SegmentArena&) = delete;
+	SegmentArena& operator=(const SegmentArena&) = delete;
+
+	/**
+	* @brief Allocates memory from the arena.
+	* @param size Number of bytes.
+	* @param alignment Required alignment, a power of two.
+	* @return Pointer to the allocated memory.
+	*/
+	void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+	/**
+	* @brief Frees every block at once. All memory handed out becomes invalid.
+	*/
+	void release();
+
+	/**
+	* @brief Returns how many blocks were requested from the heap since the last release().
+	* @return Number of upstream allocations.
+	*/
+	std::size_t getUpstreamAllocationCount() const { return upstreamAllocations; }
+	/**
+	* @brief Returns how many allocations were served since the last release().
+	* @return Number of arena allocations.
+	*/
+	std::size_t getAllocationCount() const { return allocations; }
+	/**
+	* @brief Returns how many bytes were handed out since the last release().
+	* @return Bytes in use.
+	*/
+	std::size_t getBytesInUse() const { return bytesInUse; }
+
+	/**
+	* @brief Constructs a segment in the arena.
+	*
+	* The segment is owned through a std::unique_ptr like any other, but deleting it does
+	* not free anything, so the arena must outlive it.
+	*
+	* @tparam T LineSegment2D or ArcSegment2D.
+	* @param args Constructor arguments of T.
+	* @return The new segment.
+	*/
+	template <class T, class... Args>
+	std::unique_ptr<Segment2D> make(Args&&... args);
+	/**
+	* @brief Copies a segment into the arena.
+	* @param segment Segment to copy; it may live anywhere.
+	* @return Arena-allocated copy of the same kind.
+	*/
+	std::unique_ptr<Segment2D> copy(const Segment2D& segment);
+};
+
+ /**
+  * @class ArenaSegment
+  * @brief A segment type whose storage belongs to a SegmentArena.
+  *
+  * Deleting it through a Segment2D pointer runs the destructor and leaves the memory to
+  * SegmentArena::release(); the class-specific operator delete is picked by the virtual
+  * destructor, so ordinary heap segments pay nothing for this.
+  *
+  * @tparam T Concrete segment type.
+  */
+template <class T>
+class ArenaSegment : public T {
+public:
+	using T::T;
+	/**
+	* @brief Copies a segment of the wrapped type.
+	* @param other Segment to copy.
+	*/
+	explicit ArenaSegment(const T& other) : T(other) {}
+
+	/**
+	* @brief Allocates storage from an arena.
+	* @param size Size of the object.
+	* @param arena Arena that owns the storage.
+	* @return Pointer to the storage.
+	*/
+	static void* operator new(std::size_t size, SegmentArena& arena) { return arena.allocate(size, alignof(ArenaSegment)); }
+	/**
+	* @brief Called if the constructor throws; the storage stays with the arena.
+	*/
+	static void operator delete(void*, SegmentArena&) noexcept {}
+	/**
+	* @brief Does nothing; the storage is freed by SegmentArena::release().
+	*/
+	static void operator delete(void*) noexcept {}
+};
+
+template <class T, class... Args>
+std::unique_ptr<Segment2D> SegmentArena::make(Args&&... args) {
+	return std::unique_ptr<Segment2D>(new (*this) ArenaSegment<T>(std::forward<Args>(args)...));
+}
@@ -0,0 +1,247 @@
+/**
+ * @file SegmentArrays2D.cpp
+ * @brief Implements conversion, editing and bulk operations on SegmentArrays2D.
+ */
+#include "SegmentArrays2D.h"
+#include "LineSegment2D.h"
+#include "ArcSegment2D.h"
+#include <algorithm>
+
+void SegmentArrays2D::reserve(std::size_t count) {
+	kinds.reserve(count);
+	ax.reserve(count); ay.reserve(count); az.reserve(count);
+	bx.reserve(count); by.reserve(count); bz.reserve(count);
+	radius.reserve(count);
+	cx.reserve(count); cy.reserve(count); cz.reserve(count);
+	startAngle.reserve(count);
+	endAngle.reserve(count);
+	clockwise.reserve(count);
+	counterClockwise.reserve(count);
+}
+
+void SegmentArrays2D::clear() {
+	kinds.clear();
+	ax.clear(); ay.clear(); az.clear();
+	bx.clear(); by.clear(); bz.clear();
+	radius.clear();
+	cx.clear(); cy.clear(); cz.clear();
+	startAngle.clear();
+	endAngle.clear();
+	clockwise.clear();
+	counterClockwise.clear();
+}
+
+void SegmentArrays2D::append(const Segment2D& segment) {
+	insert(size(), segment);
+}
+
+void SegmentArrays2D::appendLine(const MyPoint& a, const MyPoint& b) {
+	kinds.push_back(SegmentKind::Line);
+	ax.push_back(a.getX()); ay.push_back(a.getY()); az.push_back(a.getZ());
+	bx.push_back(b.getX()); by.push_back(b.getY()); bz.push_back(b.getZ());
+	radius.push_back(0.0);
+	cx.push_back(0.0); cy.push_back(0.0); cz.push_back(0.0);
+	startAngle.push_back(0.0);
+	endAngle.push_back(0.0);
+	clockwise.push_back(0);
+	counterClockwise.push_back(1);
+}
+
+void SegmentArrays2D::insert(std::size_t index, const Segment2D& segment) {
+	auto put = [index](auto& arr, auto value) {
+		arr.insert(arr.begin() + index, value);
+	};
+
+	const MyPoint& a = segment.getPointA();
+	const MyPoint& b = segment.getPointB();
+	put(kinds, segment.getKind());
+	put(ax, a.getX()); put(ay, a.getY()); put(az, a.getZ());
+	put(bx, b.getX()); put(by, b.getY()); put(bz, b.getZ());
+
+	if (segment.getKind() == SegmentKind::Arc) {
+		const ArcSegment2D& arc = static_cast<const ArcSegment2D&>(segment);
+		put(radius, arc.getRadius());
+		put(cx, arc.getCenter().getX()); put(cy, arc.getCenter().getY()); put(cz, arc.getCenter().getZ());
+		put(startAngle, arc.getStartAngle());
+		put(endAngle, arc.getEndAngle());
+		put(clockwise, static_cast<unsigned char>(arc.isClockwise()));
+		put(counterClockwise, static_cast<unsigned char>(arc.isCounterClockwise()));
+	}
+	else {
+		put(radius, 0.0);
+		put(cx, 0.0); put(cy, 0.0); put(cz, 0.0);
+		put(startAngle, 0.0);
+		put(endAngle, 0.0);
+		put(clockwise, static_cast<unsigned char>(0));
+		put(counterClockwise, static_cast<unsigned char>(1));
+	}
+}
+
+void SegmentArrays2D::erase(std::size_t index) {
+	auto drop = [index](auto& arr) {
+		arr.erase(arr.begin() + index);
+	};
+
+	drop(kinds);
+	drop(ax); drop(ay); drop(az);
+	drop(bx); drop(by); drop(bz);
+	drop(radius);
+	drop(cx); drop(cy); drop(cz);
+	drop(startAngle);
+	drop(endAngle);
+	drop(clockwise);
+	drop(counterClockwise);
+}
+
+void SegmentArrays2D::appendRange(const SegmentArrays2D& other, std::size_t first, std::size_t last) {
+	auto copy = [&other, first, last](auto& dst, const auto& src) {
+		dst.insert(dst.end(), src.begin() + first, src.begin() + last);
+	};
+
+	copy(kinds, other.kinds);
+	copy(ax, other.ax); copy(ay, other.ay); copy(az, other.az);
+	copy(bx, other.bx); copy(by, other.by); copy(bz, other.bz);
+	copy(radius, other.radius);
+	copy(cx, other.cx); copy(cy, other.cy); copy(cz, other.cz);
+	copy(startAngle, other.startAngle);
+	copy(endAngle, other.endAngle);
+	copy(clockwise, other.clockwise);
+	copy(counterClockwise, other.counterClockwise);
+}
+
+std::unique_ptr<Segment2D> SegmentArrays2D::makeSegment(std::size_t index) const {
+	if (kinds[index] == SegmentKind::Arc) {
+		return std::make_unique<ArcSegment2D>(getPointA(index), getPointB(index),
+			MyPoint(cx[index], cy[index], cz[index]), radius[index],
+			startAngle[index], endAngle[index], clockwise[index] != 0, counterClockwise[index] != 0);
+	}
+	return std::make_unique<LineSegment2D>(getPointA(index), getPointB(index));
+}
+
+double SegmentArrays2D::getLength(std::size_t index) const {
+	if (kinds[index] == SegmentKind::Arc) {
+		double sweep = counterClockwise[index] ? endAngle[index] - startAngle[index] : startAngle[index] - endAngle[index];
+		if (sweep < 0) {
+			sweep += 2 * M_PI;
+		}
+		return radius[index] * sweep;
+	}
+	return getPointA(index).distanceTo_2D(getPointB(index));
+}
+
+BoundingBox2D SegmentArrays2D::getBoundingBox(std::size_t index) const {
+	if (kinds[index] == SegmentKind::Arc) {
+		const bool ccw = counterClockwise[index] != 0;
+		double sweep = ccw ? endAngle[index] - startAngle[index] : startAngle[index] - endAngle[index];
+		if (sweep < 0) {
+			sweep += 2 * M_PI;
+		}
+		return ArcSegment2D::boundingBoxOf(getPointA(index), getPointB(index), MyPoint(cx[index], cy[index], cz[index]),
+			radius[index], ccw ? startAngle[index] : endAngle[index], sweep);
+	}
+	return BoundingBox2D(getPointA(index), getPointB(index));
+}
+
+BoundingBox2D SegmentArrays2D::getBoundingBox(std::size_t first, std::size_t last) const {
+	BoundingBox2D box;
+	for (std::size_t i = first; i < last; ++i) {
+		// Lines only need their endpoints; arcs also check their axis extremes
+		if (kinds[i] == SegmentKind::Arc) {
+			box.expand(getBoundingBox(i));
+		}
+		else {
+			box.expand(ax[i], ay[i]);
+			box.expand(bx[i], by[i]);
+		}
+	}
+	return box;
+}
+
+bool SegmentArrays2D::isContinuous(std::size_t first, std::size_t last, double epsilon) const {
+	// Compare squared gaps so the loop stays free of sqrt and of early exits
+	const double epsilonSq = epsilon * epsilon;
+	std::size_t gaps = 0;
+	for (std::size_t i = first; i + 1 < last; ++i) {
+		const double dx = ax[i + 1] - bx[i];
+		const double dy = ay[i + 1] - by[i];
+		gaps += (dx * dx + dy * dy > epsilonSq);
+	}
+	return gaps == 0;
+}
+
+bool SegmentArrays2D::isClosed(std::size_t first, std::size_t last, double epsilon) const {
+	if (last - first == 1) {
+		if (getLength(first) > epsilon) {
+			return getPointA(first).distanceTo_2D(getPointB(first)) < epsilon;
+		}
+	}
+	else if (last - first > 1) {
+		return getPointB(last - 1).distanceTo_2D(getPointA(first)) < epsilon;
+	}
+	return false;
+}
+
+void SegmentArrays2D::move(std::size_t first, std::size_t last, double dx, double dy) {
+	for (std::size_t i = first; i < last; ++i) {
+		ax[i] += dx; ay[i] += dy;
+		bx[i] += dx; by[i] += dy;
+	}
+
+	// Arcs re-derive center and angles from the moved endpoints, as ArcSegment2D::move() does
+	for (std::size_t i = first; i < last; ++i) {
+		if (kinds[i] != SegmentKind::Arc) {
+			continue;
+		}
+		ArcSegment2D arc(getPointA(i), getPointB(i), radius[i], clockwise[i] != 0);
+		radius[i] = arc.getRadius();
+		cx[i] = arc.getCenter().getX();
+		cy[i] = arc.getCenter().getY();
+		cz[i] = arc.getCenter().getZ();
+		startAngle[i] = arc.getStartAngle();
+		endAngle[i] = arc.getEndAngle();
+	}
+}
+
+double SegmentArrays2D::signedArea(std::size_t first, std::size_t last) const {
+	if (last <= first) {
+		return 0.0;
+	}
+	double area = 0.0;
+	for (std::size_t i = first; i < last; ++i) {
+		const double chord = ax[i] * by[i] - bx[i] * ay[i];
+		// Direction as +1 / -1 and the sweep wrapped into [0, 2*PI) without branches
+		const double direction = 2.0 * counterClockwise[i] - 1.0;
+		double sweep = direction * (endAngle[i] - startAngle[i]);
+		sweep += 2 * M_PI * (sweep < 0);
+		area += chord + direction * radius[i] * radius[i] * (sweep - sin(sweep));
+	}
+	// Closing chord from the end back to the start; zero for closed contours
+	area += bx[last - 1] * ay[first] - ax[first] * by[last - 1];
+	return 0.5 * area;
+}
+
+void SegmentArrays2D::reverse(std::size_t first, std::size_t last) {
+	auto flip = [first, last](auto& arr) {
+		std::reverse(arr.begin() + first, arr.begin() + last);
+	};
+
+	flip(kinds);
+	flip(ax); flip(ay); flip(az);
+	flip(bx); flip(by); flip(bz);
+	flip(radius);
+	flip(cx); flip(cy); flip(cz);
+	flip(startAngle);
+	flip(endAngle);
+	flip(clockwise);
+	flip(counterClockwise);
+
+	// Each segment now runs the other way: endpoints and angles swap, arc flags toggle
+	for (std::size_t i = first; i < last; ++i) {
+		std::swap(ax[i], bx[i]); std::swap(ay[i], by[i]); std::swap(az[i], bz[i]);
+		std::swap(startAngle[i], endAngle[i]);
+		if (kinds[i] == SegmentKind::Arc) {
+			clockwise[i] = !clockwise[i];
+			counterClockwise[i] = !counterClockwise[i];
+		}
+	}
+}
@@ -0,0 +1,167 @@
+/**
+ * @file SegmentArrays2D.h
+ * @brief Defines a structure-of-arrays storage for line and arc segments.
+ *
+ * Keeps endpoints, segment kinds and arc parameters in contiguous parallel arrays,
+ * so that bulk passes over many segments do not chase pointers or dispatch virtually.
+ */
+#pragma once
+#include <vector>
+#include <memory>
+#include "Segment2D.h"
+#include "MyPoint.h"
+#include "BoundingBox2D.h"
+
+ /**
+  * @struct SegmentArrays2D
+  * @brief Parallel arrays describing an ordered sequence of segments.
+  *
+  * Element i of every array belongs to segment i. Arc parameters are stored for every
+  * segment so that all arrays share the same indexing; for line segments they are zero.
+  * The arrays are public so that batch kernels can iterate over them directly.
+  */
+struct SegmentArrays2D {
+	std::vector<SegmentKind> kinds;			///< Kind of each segment.
+	std::vector<double> ax, ay, az;			///< Start point (point A) coordinates.
+	std::vector<double> bx, by, bz;			///< End point (point B) coordinates.
+	std::vector<double> radius;				///< Arc radius (0 for lines).
+	std::vector<double> cx, cy, cz;			///< Arc center (0 for lines).
+	std::vector<double> startAngle;			///< Arc start angle in radians (0 for lines).
+	std::vector<double> endAngle;			///< Arc end angle in radians (0 for lines).
+	std::vector<unsigned char> clockwise;	///< Arc center-side flag, see ArcSegment2D::isClockwise() (0 for lines).
+	std::vector<unsigned char> counterClockwise;	///< Arc traversal direction, 1 if counter-clockwise (1 for lines).
+
+	/**
+	* @brief Returns the number of stored segments.
+	* @return Segment count.
+	*/
+	std::size_t size() const { return kinds.size(); }
+	/**
+	* @brief Reserves capacity in every array.
+	* @param count Number of segments to reserve for.
+	*/
+	void reserve(std::size_t count);
+	/**
+	* @brief Removes all segments.
+	*/
+	void clear();
+	/**
+	* @brief Appends a copy of the given segment.
+	* @param segment Segment to store.
+	*/
+	void append(const Segment2D& segment);
+	/**
+	* @brief Appends a line without creating a LineSegment2D.
+	* @param a Start point.
+	* @param b End point.
+	*/
+	void appendLine(const MyPoint& a, const MyPoint& b);
+	/**
+	* @brief Inserts a copy of the given segment before the given index.
+	* @param index Insertion position, in range [0, size()].
+	* @param segment Segment to store.
+	*/
+	void insert(std::size_t index, const Segment2D& segment);
+	/**
+	* @brief Removes the segment at the given index.
+	* @param index Index of the segment to remove.
+	*/
+	void erase(std::size_t index);
+	/**
+	* @brief Appends a range of segments copied from another set of arrays.
+	* @param other Source arrays.
+	* @param first Index of the first segment to copy.
+	* @param last One past the index of the last segment to copy.
+	*/
+	void appendRange(const SegmentArrays2D& other, std::size_t first, std::size_t last);
+	/**
+	* @brief Rebuilds the segment at the given index as a standalone object.
+	* @param index Index of the segment.
+	* @return A unique_ptr to an equivalent LineSegment2D or ArcSegment2D.
+	*/
+	std::unique_ptr<Segment2D> makeSegment(std::size_t index) const;
+	/**
+	* @brief Returns point A of the segment at the given index.
+	* @param index Index of the segment.
+	* @return Start point.
+	*/
+	MyPoint getPointA(std::size_t index) const { return MyPoint(ax[index], ay[index], az[index]); }
+	/**
+	* @brief Returns point B of the segment at the given index.
+	* @param index Index of the segment.
+	* @return End point.
+	*/
+	MyPoint getPointB(std::size_t index) const { return MyPoint(bx[index], by[index], bz[index]); }
+	/**
+	* @brief Returns the length of the segment at the given index.
+	*
+	* Matches LineSegment2D::length() and ArcSegment2D::length().
+	*
+	* @param index Index of the segment.
+	* @return Segment length.
+	*/
+	double getLength(std::size_t index) const;
+	/**
+	* @brief Returns the exact bounding box of a segment, including arc extremes.
+	* @param index Index of the segment.
+	* @return Segment bounding box.
+	*/
+	BoundingBox2D getBoundingBox(std::size_t index) const;
+	/**
+	* @brief Returns the bounding box of segments [first, last).
+	* @param first Index of the first segment.
+	* @param last One past the index of the last segment.
+	* @return Union of the segment boxes; empty for an empty range.
+	*/
+	BoundingBox2D getBoundingBox(std::size_t first, std::size_t last) const;
+	/**
+	* @brief Checks that segments in [first, last) are connected end-to-end.
+	* @param first Index of the first segment.
+	* @param last One past the index of the last segment.
+	* @param epsilon Maximum allowed gap at each joint.
+	* @return True if every joint gap is within epsilon.
+	*/
+	bool isContinuous(std::size_t first, std::size_t last, double epsilon) const;
+	/**
+	* @brief Checks whether the ends of segments in [first, last) meet.
+	*
+	* Follows the end-point rules of Contour2D::isClosedShape(); continuity of the
+	* range is not checked here, see isContinuous().
+	*
+	* @param first Index of the first segment.
+	* @param last One past the index of the last segment.
+	* @param epsilon Tolerance.
+	* @return True if the start of the range and its end meet within epsilon.
+	*/
+	bool isClosed(std::size_t first, std::size_t last, double epsilon) const;
+	/**
+	* @brief Translates segments in [first, last) by the given delta.
+	*
+	* Arcs are recalculated from their endpoints exactly as ArcSegment2D::move() does.
+	*
+	* @param first Index of the first segment.
+	* @param last One past the index of the last segment.
+	* @param dx Offset along the X axis.
+	* @param dy Offset along the Y axis.
+	*/
+	void move(std::size_t first, std::size_t last, double dx, double dy);
+	/**
+	* @brief Computes the signed area enclosed by segments [first, last).
+	*
+	* Same definition as Contour2D::signedArea(): shoelace terms for every segment, the
+	* circular segment of every arc, and a closing chord from the end back to the start.
+	* Runs as one branch-free pass over the arrays; lines have radius 0, so their arc term
+	* vanishes without a kind check and the loop can be vectorized by the compiler.
+	*
+	* @param first Index of the first segment.
+	* @param last One past the index of the last segment.
+	* @return Signed area, positive for counter-clockwise contours.
+	*/
+	double signedArea(std::size_t first, std::size_t last) const;
+	/**
+	* @brief Reverses segments [first, last) in place, as Contour2D::reverse() does.
+	* @param first Index of the first segment.
+	* @param last One past the index of the last segment.
+	*/
+	void reverse(std::size_t first, std::size_t last);
+};
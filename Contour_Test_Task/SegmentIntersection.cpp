@@ -0,0 +1,173 @@
+/**
+ * @file SegmentIntersection.cpp
+ * @brief Implements line/arc intersection kernels.
+ */
+#include "SegmentIntersection.h"
+#include "LineSegment2D.h"
+#include "ArcSegment2D.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+	/**
+	 * @brief Arc parameters in counter-clockwise form.
+	 */
+	struct ArcShape {
+		MyPoint a, b, c;
+		double r;
+		double ccwStart;
+		double sweep;
+
+		explicit ArcShape(const ArcSegment2D& arc) : a(arc.getPointA()), b(arc.getPointB()), c(arc.getCenter()),
+			r(arc.getRadius()), ccwStart(arc.isCounterClockwise() ? arc.getStartAngle() : arc.getEndAngle()),
+			sweep(arc.getSweepAngle()) {
+		}
+
+		/**
+		 * @brief Tells whether a point on the circle lies within the sweep, with slack at both ends.
+		 */
+		bool coversDirection(const MyPoint& p, double epsilon) const {
+			double offset = std::atan2(p.getY() - c.getY(), p.getX() - c.getX()) - ccwStart;
+			offset -= 2 * M_PI * std::floor(offset / (2 * M_PI));
+			const double slack = r > 0 ? epsilon / r : 0.0;
+			return offset <= sweep + slack || offset >= 2 * M_PI - slack;
+		}
+
+		bool contains(const MyPoint& p, double epsilon) const {
+			return std::abs(p.distanceTo_2D(c) - r) <= epsilon && coversDirection(p, epsilon);
+		}
+	};
+
+	inline double cross(double ux, double uy, double vx, double vy) {
+		return ux * vy - uy * vx;
+	}
+
+	bool lineContains(const MyPoint& a, const MyPoint& b, const MyPoint& p, double epsilon) {
+		return LineSegment2D::closestPointOf(a, b, p).distanceTo_2D(p) <= epsilon;
+	}
+
+	void intersectLines(const MyPoint& p, const MyPoint& p2, const MyPoint& q, const MyPoint& q2, double epsilon, SegmentHits& hits) {
+		const double rx = p2.getX() - p.getX();
+		const double ry = p2.getY() - p.getY();
+		const double sx = q2.getX() - q.getX();
+		const double sy = q2.getY() - q.getY();
+		const double lengthR = std::sqrt(rx * rx + ry * ry);
+		const double lengthS = std::sqrt(sx * sx + sy * sy);
+		const double denominator = cross(rx, ry, sx, sy);
+		const double qpx = q.getX() - p.getX();
+		const double qpy = q.getY() - p.getY();
+
+		if (std::abs(denominator) > epsilon * std::max(lengthR, lengthS)) {
+			// Proper crossing of the two supporting lines
+			double t = cross(qpx, qpy, sx, sy) / denominator;
+			const double u = cross(qpx, qpy, rx, ry) / denominator;
+			const double slackT = lengthR > 0 ? epsilon / lengthR : 0.0;
+			const double slackU = lengthS > 0 ? epsilon / lengthS : 0.0;
+			if (t >= -slackT && t <= 1 + slackT && u >= -slackU && u <= 1 + slackU) {
+				t = std::min(std::max(t, 0.0), 1.0);
+				hits.add(MyPoint(p.getX() + t * rx, p.getY() + t * ry), epsilon);
+			}
+			return;
+		}
+		// Parallel or degenerate: any endpoint lying on the other segment bounds the overlap
+		if (lineContains(q, q2, p, epsilon)) { hits.add(p, epsilon); }
+		if (lineContains(q, q2, p2, epsilon)) { hits.add(p2, epsilon); }
+		if (lineContains(p, p2, q, epsilon)) { hits.add(q, epsilon); }
+		if (lineContains(p, p2, q2, epsilon)) { hits.add(q2, epsilon); }
+	}
+
+	void intersectLineArc(const MyPoint& p, const MyPoint& p2, const ArcShape& arc, double epsilon, SegmentHits& hits) {
+		const double rx = p2.getX() - p.getX();
+		const double ry = p2.getY() - p.getY();
+		const double lengthSq = rx * rx + ry * ry;
+		if (!(lengthSq > 0)) {
+			if (arc.contains(p, epsilon)) { hits.add(p, epsilon); }
+			return;
+		}
+		// Foot of the perpendicular from the center onto the supporting line
+		const double t0 = ((arc.c.getX() - p.getX()) * rx + (arc.c.getY() - p.getY()) * ry) / lengthSq;
+		const MyPoint foot(p.getX() + t0 * rx, p.getY() + t0 * ry);
+		const double h = foot.distanceTo_2D(arc.c);
+		if (h > arc.r + epsilon) {
+			return;
+		}
+		const double length = std::sqrt(lengthSq);
+		const double half = h >= arc.r - epsilon ? 0.0 : std::sqrt(arc.r * arc.r - h * h) / length;
+		const double slack = epsilon / length;
+		for (int side = -1; side <= 1; side += 2) {
+			const double t = t0 + side * half;
+			if (t < -slack || t > 1 + slack) {
+				continue;
+			}
+			const MyPoint hit(p.getX() + t * rx, p.getY() + t * ry);
+			if (arc.coversDirection(hit, epsilon)) {
+				hits.add(hit, epsilon);
+			}
+		}
+		// Endpoints touching the arc within tolerance, e.g. a line ending on an arc's end
+		if (arc.contains(p, epsilon)) { hits.add(p, epsilon); }
+		if (arc.contains(p2, epsilon)) { hits.add(p2, epsilon); }
+	}
+
+	void intersectArcs(const ArcShape& first, const ArcShape& second, double epsilon, SegmentHits& hits) {
+		const double dx = second.c.getX() - first.c.getX();
+		const double dy = second.c.getY() - first.c.getY();
+		const double d = std::sqrt(dx * dx + dy * dy);
+		if (d <= epsilon && std::abs(first.r - second.r) <= epsilon) {
+			// Same circle: the overlap is bounded by endpoints lying on the other arc
+			if (second.contains(first.a, epsilon)) { hits.add(first.a, epsilon); }
+			if (second.contains(first.b, epsilon)) { hits.add(first.b, epsilon); }
+			if (first.contains(second.a, epsilon)) { hits.add(second.a, epsilon); }
+			if (first.contains(second.b, epsilon)) { hits.add(second.b, epsilon); }
+			return;
+		}
+		if (d > first.r + second.r + epsilon || d < std::abs(first.r - second.r) - epsilon || !(d > 0)) {
+			return;
+		}
+		// Distance from the first center to the radical line, and half the common chord
+		const double along = (first.r * first.r - second.r * second.r + d * d) / (2 * d);
+		const double heightSq = first.r * first.r - along * along;
+		const double height = heightSq > epsilon * epsilon ? std::sqrt(heightSq) : 0.0;
+		const double ux = dx / d;
+		const double uy = dy / d;
+		const MyPoint base(first.c.getX() + along * ux, first.c.getY() + along * uy);
+		for (int side = -1; side <= 1; side += 2) {
+			const MyPoint hit(base.getX() - side * height * uy, base.getY() + side * height * ux);
+			if (first.coversDirection(hit, epsilon) && second.coversDirection(hit, epsilon)) {
+				hits.add(hit, epsilon);
+			}
+		}
+	}
+
+}
+
+void SegmentHits::add(const MyPoint& p, double epsilon) {
+	for (std::size_t i = 0; i < count; ++i) {
+		if (points[i].distanceTo_2D(p) <= epsilon) {
+			return;
+		}
+	}
+	if (count < 4) {
+		points[count++] = p;
+	}
+}
+
+SegmentHits intersectSegments(const Segment2D& a, const Segment2D& b, double epsilon) {
+	SegmentHits hits;
+	const bool arcA = a.getKind() == SegmentKind::Arc;
+	const bool arcB = b.getKind() == SegmentKind::Arc;
+	if (arcA && arcB) {
+		intersectArcs(ArcShape(static_cast<const ArcSegment2D&>(a)), ArcShape(static_cast<const ArcSegment2D&>(b)), epsilon, hits);
+	}
+	else if (arcA) {
+		intersectLineArc(b.getPointA(), b.getPointB(), ArcShape(static_cast<const ArcSegment2D&>(a)), epsilon, hits);
+	}
+	else if (arcB) {
+		intersectLineArc(a.getPointA(), a.getPointB(), ArcShape(static_cast<const ArcSegment2D&>(b)), epsilon, hits);
+	}
+	else {
+		intersectLines(a.getPointA(), a.getPointB(), b.getPointA(), b.getPointB(), epsilon, hits);
+	}
+	return hits;
+}
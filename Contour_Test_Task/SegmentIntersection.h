@@ -0,0 +1,40 @@
+/**
+ * @file SegmentIntersection.h
+ * @brief Exact intersection kernels for pairs of line and arc segments.
+ */
+#pragma once
+#include <cstddef>
+#include "Segment2D.h"
+
+ /**
+ * @struct SegmentHits
+ * @brief Points where two segments meet.
+ *
+ * Crossing and touching segments give one or two points. Overlapping collinear lines and
+ * overlapping arcs of the same circle give the ends of the shared pieces instead, which is
+ * at most four points for two arcs that overlap at both ends.
+ */
+struct SegmentHits {
+	std::size_t count = 0;	///< Number of valid entries in points.
+	MyPoint points[4];		///< Intersection points, in no particular order.
+
+	/**
+	* @brief Adds a point unless it lies within epsilon of one already stored.
+	* @param p Point to add.
+	* @param epsilon Merge distance.
+	*/
+	void add(const MyPoint& p, double epsilon);
+};
+
+/**
+* @brief Computes where two segments intersect.
+*
+* Handles line-line, line-arc and arc-arc pairs. Points within epsilon of both segments
+* count, so segments that touch at an endpoint or are tangent report the contact point.
+*
+* @param a First segment.
+* @param b Second segment.
+* @param epsilon Distance tolerance.
+* @return Intersection points; count is 0 if the segments are disjoint.
+*/
+SegmentHits intersectSegments(const Segment2D& a, const Segment2D& b, double epsilon);
@@ -0,0 +1,76 @@
+/**
+ * @file SegmentVariant2D.cpp
+ * @brief Implements construction, copying and type access for SegmentVariant2D.
+ */
+#include "SegmentVariant2D.h"
+#include <new>
+#include <stdexcept>
+
+SegmentVariant2D::SegmentVariant2D(const Segment2D& segment) : kind(segment.getKind()) {
+	if (kind == SegmentKind::Arc) {
+		::new (&arc) ArcSegment2D(static_cast<const ArcSegment2D&>(segment));
+	}
+	else {
+		::new (&line) LineSegment2D(static_cast<const LineSegment2D&>(segment));
+	}
+}
+
+SegmentVariant2D::SegmentVariant2D(const SegmentVariant2D& other) : kind(other.kind) {
+	copyFrom(other);
+}
+
+SegmentVariant2D& SegmentVariant2D::operator=(const SegmentVariant2D& other) {
+	if (this != &other) {
+		destroy();
+		kind = other.kind;
+		copyFrom(other);
+	}
+	return *this;
+}
+
+void SegmentVariant2D::destroy() {
+	if (kind == SegmentKind::Arc) {
+		arc.~ArcSegment2D();
+	}
+	else {
+		line.~LineSegment2D();
+	}
+}
+
+void SegmentVariant2D::copyFrom(const SegmentVariant2D& other) {
+	// kind has already been set to other.kind; the union member is still unconstructed.
+	if (kind == SegmentKind::Arc) {
+		::new (&arc) ArcSegment2D(other.arc);
+	}
+	else {
+		::new (&line) LineSegment2D(other.line);
+	}
+}
+
+const Segment2D& SegmentVariant2D::getSegment() const {
+	if (kind == SegmentKind::Arc) {
+		return arc;
+	}
+	return line;
+}
+
+const LineSegment2D& SegmentVariant2D::asLine() const {
+	if (kind != SegmentKind::Line) {
+		throw std::logic_error("Segment is not a line in asLine()");
+	}
+	return line;
+}
+
+const ArcSegment2D& SegmentVariant2D::asArc() const {
+	if (kind != SegmentKind::Arc) {
+		throw std::logic_error("Segment is not an arc in asArc()");
+	}
+	return arc;
+}
+
+std::unique_ptr<Segment2D> SegmentVariant2D::clone() const {
+	if (kind == SegmentKind::Arc) {
+		return arc.clone();
+	}
+	return line.clone();
+}
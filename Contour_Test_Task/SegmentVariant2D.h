@@ -0,0 +1,151 @@
+/**
+ * @file SegmentVariant2D.h
+ * @brief Defines a value-type segment holding either a LineSegment2D or an ArcSegment2D.
+ *
+ * The closed set of segment types is stored inline in a tagged union, so containers of
+ * SegmentVariant2D need no per-segment heap allocation and dispatch with a switch
+ * instead of a virtual call.
+ */
+#pragma once
+#include <memory>
+#include "Segment2D.h"
+#include "LineSegment2D.h"
+#include "ArcSegment2D.h"
+
+ /**
+  * @class SegmentVariant2D
+  * @brief Tagged union over the concrete segment types.
+  *
+  * visit() calls the visitor with the concrete LineSegment2D or ArcSegment2D, letting the
+  * compiler inline the segment methods. The common accessors below are implemented the
+  * same way.
+  */
+class SegmentVariant2D {
+private:
+	SegmentKind kind;
+	union {
+		LineSegment2D line;
+		ArcSegment2D arc;
+	};
+
+	void destroy();
+	void copyFrom(const SegmentVariant2D& other);
+
+public:
+	/**
+	* @brief Stores a copy of a line segment.
+	* @param segment Line segment to copy.
+	*/
+	SegmentVariant2D(const LineSegment2D& segment) : kind(SegmentKind::Line), line(segment) {}
+	/**
+	* @brief Stores a copy of an arc segment.
+	* @param segment Arc segment to copy.
+	*/
+	SegmentVariant2D(const ArcSegment2D& segment) : kind(SegmentKind::Arc), arc(segment) {}
+	/**
+	* @brief Stores a copy of any Segment2D, dispatching on its kind.
+	* @param segment Segment to copy.
+	*/
+	explicit SegmentVariant2D(const Segment2D& segment);
+	/**
+	* @brief Copy constructor.
+	* @param other SegmentVariant2D to copy from.
+	*/
+	SegmentVariant2D(const SegmentVariant2D& other);
+	/**
+	* @brief Copy assignment operator.
+	* @param other SegmentVariant2D to copy from.
+	* @return Reference to this.
+	*/
+	SegmentVariant2D& operator=(const SegmentVariant2D& other);
+	/**
+	* @brief Destructor.
+	*/
+	~SegmentVariant2D() { destroy(); }
+
+	/**
+	* @brief Calls the visitor with the concrete segment.
+	* @param visitor Callable accepting LineSegment2D& and ArcSegment2D&.
+	* @return Whatever the visitor returns.
+	*/
+	template <class Visitor>
+	decltype(auto) visit(Visitor&& visitor) {
+		if (kind == SegmentKind::Arc) {
+			return visitor(arc);
+		}
+		return visitor(line);
+	}
+	/**
+	* @brief Calls the visitor with the concrete segment (const overload).
+	* @param visitor Callable accepting const LineSegment2D& and const ArcSegment2D&.
+	* @return Whatever the visitor returns.
+	*/
+	template <class Visitor>
+	decltype(auto) visit(Visitor&& visitor) const {
+		if (kind == SegmentKind::Arc) {
+			return visitor(arc);
+		}
+		return visitor(line);
+	}
+
+	/**
+	* @brief Returns the kind of the stored segment.
+	* @return SegmentKind::Line or SegmentKind::Arc.
+	*/
+	SegmentKind getKind() const { return kind; }
+	/**
+	* @brief Returns the stored segment through its common interface.
+	* @return Const reference to the stored Segment2D.
+	*/
+	const Segment2D& getSegment() const;
+	/**
+	* @brief Returns the stored line segment.
+	* @return Const reference to the line; throws std::logic_error if the kind is not Line.
+	*/
+	const LineSegment2D& asLine() const;
+	/**
+	* @brief Returns the stored arc segment.
+	* @return Const reference to the arc; throws std::logic_error if the kind is not Arc.
+	*/
+	const ArcSegment2D& asArc() const;
+	/**
+	* @brief Returns a reference to the starting point of the segment.
+	* @return Const reference to point A.
+	*/
+	const MyPoint& getPointA() const {
+		return kind == SegmentKind::Arc ? arc.getPointA() : line.getPointA();
+	}
+	/**
+	* @brief Returns a reference to the ending point of the segment.
+	* @return Const reference to point B.
+	*/
+	const MyPoint& getPointB() const {
+		return kind == SegmentKind::Arc ? arc.getPointB() : line.getPointB();
+	}
+	/**
+	* @brief Translates the segment by a given delta in x and y.
+	* @param dx Offset in the X direction.
+	* @param dy Offset in the Y direction.
+	*/
+	void move(double dx, double dy) {
+		if (kind == SegmentKind::Arc) {
+			arc.move(dx, dy);
+		}
+		else {
+			line.move(dx, dy);
+		}
+	}
+	/**
+	* @brief Checks if the segment length exceeds a given threshold.
+	* @param epsilon Minimum non-zero threshold.
+	* @return True if length is greater than epsilon.
+	*/
+	bool isNonZeroLength(double epsilon) const {
+		return kind == SegmentKind::Arc ? arc.isNonZeroLength(epsilon) : line.isNonZeroLength(epsilon);
+	}
+	/**
+	* @brief Creates a heap copy of the stored segment.
+	* @return A unique_ptr to a cloned Segment2D object.
+	*/
+	std::unique_ptr<Segment2D> clone() const;
+};
@@ -0,0 +1,64 @@
+/**
+ * @file ValidityCache.h
+ * @brief Defines a lock-free cache for a lazily computed validity flag.
+ */
+#pragma once
+#include <atomic>
+
+ /**
+  * @class ValidityCache
+  * @brief Caches a boolean result so that concurrent const queries are race-free.
+  *
+  * The state is a single atomic byte: unknown, invalid or valid. Readers that find it known
+  * return with one acquire load. Readers that find it unknown compute the value and publish
+  * it; if several do so at once they store the same result, so no lock is needed.
+  * invalidate() must only be called while the owner is being modified, which already
+  * requires exclusive access.
+  */
+class ValidityCache {
+private:
+	static constexpr unsigned char unknown = 0;
+	static constexpr unsigned char invalid = 1;
+	static constexpr unsigned char valid = 2;
+
+	mutable std::atomic<unsigned char> state{ unknown };
+
+public:
+	/**
+	* @brief Creates an empty (unknown) cache.
+	*/
+	ValidityCache() = default;
+	/**
+	* @brief Copies the cached state of another cache.
+	* @param other Cache to copy from.
+	*/
+	ValidityCache(const ValidityCache& other) noexcept : state(other.state.load(std::memory_order_acquire)) {}
+	/**
+	* @brief Copies the cached state of another cache.
+	* @param other Cache to copy from.
+	* @return Reference to this.
+	*/
+	ValidityCache& operator=(const ValidityCache& other) noexcept {
+		state.store(other.state.load(std::memory_order_acquire), std::memory_order_release);
+		return *this;
+	}
+
+	/**
+	* @brief Returns the cached value, computing and publishing it first if unknown.
+	* @param compute Callable returning the current validity.
+	* @return Cached validity.
+	*/
+	template <class Compute>
+	bool get(Compute&& compute) const {
+		unsigned char current = state.load(std::memory_order_acquire);
+		if (current == unknown) {
+			current = compute() ? valid : invalid;
+			state.store(current, std::memory_order_release);
+		}
+		return current == valid;
+	}
+	/**
+	* @brief Marks the cached value as unknown.
+	*/
+	void invalidate() noexcept { state.store(unknown, std::memory_order_relaxed); }
+};
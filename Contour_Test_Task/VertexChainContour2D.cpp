@@ -0,0 +1,211 @@
+/**
+ * @file VertexChainContour2D.cpp
+ * @brief Implements the VertexChainContour2D class: conversion, editing and queries.
+ */
+#include "VertexChainContour2D.h"
+#include "LineSegment2D.h"
+#include "ArcSegment2D.h"
+
+VertexChainContour2D::VertexChainContour2D(const Contour2D& contour) {
+	if (!contour.isValid()) {
+		throw std::invalid_argument("Contour is not continuous in VertexChainContour2D()");
+	}
+	vx.reserve(contour.getSegmentCount() + 1);
+	vy.reserve(contour.getSegmentCount() + 1);
+	for (const auto& seg : contour) {
+		addSegment(seg);
+	}
+	if (contour.isClosedShape() && getSegmentCount() > 1) {
+		close();
+	}
+}
+
+Contour2D VertexChainContour2D::toContour2D() const {
+	Contour2D contour;
+	for (std::size_t i = 0; i < kinds.size(); ++i) {
+		contour.addSegment(getSegmentCopyAt(i));
+	}
+	return contour;
+}
+
+bool VertexChainContour2D::matchesVertex(const MyPoint& point, std::size_t vertex) const {
+	return point.distanceTo_2D(MyPoint(vx[vertex], vy[vertex])) <= defaultEpsilon;
+}
+
+void VertexChainContour2D::insertSegmentData(std::size_t index, const Segment2D& segment) {
+	double r = 0.0;
+	unsigned char left = 0;
+	unsigned char ccw = 1;
+	if (segment.getKind() == SegmentKind::Arc) {
+		const ArcSegment2D& arc = static_cast<const ArcSegment2D&>(segment);
+		const MyPoint& a = arc.getPointA();
+		const MyPoint& b = arc.getPointB();
+		const MyPoint& c = arc.getCenter();
+		double cross = (b.getX() - a.getX()) * (c.getY() - a.getY()) - (b.getY() - a.getY()) * (c.getX() - a.getX());
+		r = arc.getRadius();
+		left = static_cast<unsigned char>(cross > 0);
+		ccw = static_cast<unsigned char>(arc.isCounterClockwise());
+	}
+	kinds.insert(kinds.begin() + index, segment.getKind());
+	radius.insert(radius.begin() + index, r);
+	centerOnLeft.insert(centerOnLeft.begin() + index, left);
+	counterClockwise.insert(counterClockwise.begin() + index, ccw);
+}
+
+void VertexChainContour2D::addSegment(const Segment2D& segment) {
+	if (closed) {
+		throw std::logic_error("Cannot append to a closed chain in addSegment()");
+	}
+	const MyPoint& a = segment.getPointA();
+	const MyPoint& b = segment.getPointB();
+	if (vx.empty()) {
+		vx.push_back(a.getX());
+		vy.push_back(a.getY());
+	}
+	else if (!matchesVertex(a, vx.size() - 1)) {
+		throw std::invalid_argument("Segment does not start at the last vertex in addSegment()");
+	}
+	insertSegmentData(kinds.size(), segment);
+	vx.push_back(b.getX());
+	vy.push_back(b.getY());
+}
+
+void VertexChainContour2D::insertSegment(std::unique_ptr<Segment2D> segment, int position) {
+	const int count = static_cast<int>(kinds.size());
+	const int maxPosition = closed ? count - 1 : count;
+	if (position < 0 || position > maxPosition) {
+		throw std::out_of_range("Invalid position in insertSegment()");
+	}
+	if (position == count) {
+		addSegment(*segment);
+		return;
+	}
+
+	const std::size_t index = static_cast<std::size_t>(position);
+	if (!matchesVertex(segment->getPointA(), index)) {
+		throw std::invalid_argument("Segment does not start at the chain vertex in insertSegment()");
+	}
+	vx.insert(vx.begin() + index + 1, segment->getPointB().getX());
+	vy.insert(vy.begin() + index + 1, segment->getPointB().getY());
+	insertSegmentData(index, *segment);
+}
+
+void VertexChainContour2D::removeSegment(int position) {
+	const int count = static_cast<int>(kinds.size());
+	if (position < 0 || position >= count) {
+		throw std::out_of_range("Invalid position in removeSegment()");
+	}
+
+	if (count == 1) {
+		vx.clear();
+		vy.clear();
+		kinds.clear();
+		radius.clear();
+		centerOnLeft.clear();
+		counterClockwise.clear();
+		closed = false;
+		return;
+	}
+
+	const std::size_t index = static_cast<std::size_t>(position);
+	std::size_t droppedVertex;
+	if (closed) {
+		// Keep vertex 0 when the removed segment closes the loop
+		droppedVertex = (position == count - 1) ? index : index + 1;
+	}
+	else if (position == 0) {
+		droppedVertex = 0;
+	}
+	else {
+		droppedVertex = index + 1;
+	}
+
+	vx.erase(vx.begin() + droppedVertex);
+	vy.erase(vy.begin() + droppedVertex);
+	kinds.erase(kinds.begin() + index);
+	radius.erase(radius.begin() + index);
+	centerOnLeft.erase(centerOnLeft.begin() + index);
+	counterClockwise.erase(counterClockwise.begin() + index);
+
+	if (closed && kinds.size() == 1) {
+		// A single segment cannot share its own end vertex, reopen it
+		vx.push_back(vx.front());
+		vy.push_back(vy.front());
+		closed = false;
+	}
+}
+
+void VertexChainContour2D::close() {
+	if (closed) {
+		return;
+	}
+	if (kinds.size() < 2) {
+		throw std::logic_error("At least two segments are needed in close()");
+	}
+	if (!matchesVertex(MyPoint(vx.front(), vy.front()), vx.size() - 1)) {
+		throw std::logic_error("Chain ends do not meet in close()");
+	}
+	vx.pop_back();
+	vy.pop_back();
+	closed = true;
+}
+
+bool VertexChainContour2D::isClosedShape() const {
+	if (closed) {
+		return true;
+	}
+	if (kinds.size() == 1) {
+		if (getSegmentCopyAt(0)->isNonZeroLength(defaultEpsilon)) {
+			return getPointAAt(0).distanceTo_2D(getPointBAt(0)) < defaultEpsilon;
+		}
+	}
+	else if (kinds.size() > 1) {
+		return getPointBAt(kinds.size() - 1).distanceTo_2D(getPointAAt(0)) < defaultEpsilon;
+	}
+	return false;
+}
+
+void VertexChainContour2D::move(double dx, double dy) {
+	for (std::size_t i = 0; i < vx.size(); ++i) {
+		vx[i] += dx;
+		vy[i] += dy;
+	}
+}
+
+MyPoint VertexChainContour2D::getPointAAt(std::size_t index) const {
+	if (index >= kinds.size()) {
+		throw std::out_of_range("Invalid index in getPointAAt()");
+	}
+	return MyPoint(vx[index], vy[index]);
+}
+
+MyPoint VertexChainContour2D::getPointBAt(std::size_t index) const {
+	if (index >= kinds.size()) {
+		throw std::out_of_range("Invalid index in getPointBAt()");
+	}
+	const std::size_t end = endVertex(index);
+	return MyPoint(vx[end], vy[end]);
+}
+
+SegmentKind VertexChainContour2D::getKindAt(std::size_t index) const {
+	if (index >= kinds.size()) {
+		throw std::out_of_range("Invalid index in getKindAt()");
+	}
+	return kinds[index];
+}
+
+std::unique_ptr<Segment2D> VertexChainContour2D::getSegmentCopyAt(std::size_t index) const {
+	const MyPoint a = getPointAAt(index);
+	const MyPoint b = getPointBAt(index);
+	if (kinds[index] == SegmentKind::Arc) {
+		// ArcSegment2D places the center on the left of the chord when its flag is set
+		if (counterClockwise[index]) {
+			return std::make_unique<ArcSegment2D>(a, b, radius[index], centerOnLeft[index] != 0);
+		}
+		// A clockwise arc is the counter-clockwise arc from b to a, reversed
+		auto arc = std::make_unique<ArcSegment2D>(b, a, radius[index], centerOnLeft[index] == 0);
+		arc->reverse();
+		return std::unique_ptr<Segment2D>(std::move(arc));
+	}
+	return std::make_unique<LineSegment2D>(a, b);
+}
@@ -0,0 +1,152 @@
+/**
+ * @file VertexChainContour2D.h
+ * @brief Defines a 2D contour in which consecutive segments share their joint vertex.
+ *
+ * N segments are stored as N+1 vertices (N once the chain is closed) plus per-segment kind
+ * and arc data, so continuity holds by construction and every joint point is stored once.
+ */
+#pragma once
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include "Segment2D.h"
+#include "MyPoint.h"
+#include "Contour2D.h"
+
+ /**
+ * @class VertexChainContour2D
+ * @brief Contour stored as a chain of shared vertices.
+ *
+ * Segment i runs from vertex i to vertex i+1 (wrapping to vertex 0 on a closed chain).
+ * Arcs keep only their radius, their direction of travel and on which side of the chord
+ * their center lies; center and
+ * angles are re-derived from the vertices when the arc is materialized, which is also how
+ * ArcSegment2D::move() updates an arc. Coordinates are stored in the XY plane.
+ */
+class VertexChainContour2D {
+private:
+	std::vector<double> vx, vy;
+	std::vector<SegmentKind> kinds;
+	std::vector<double> radius;
+	std::vector<unsigned char> centerOnLeft;
+	std::vector<unsigned char> counterClockwise;
+	bool closed = false;
+
+	std::size_t endVertex(std::size_t index) const { return (closed && index + 1 == kinds.size()) ? 0 : index + 1; }
+	bool matchesVertex(const MyPoint& point, std::size_t vertex) const;
+	void insertSegmentData(std::size_t index, const Segment2D& segment);
+
+public:
+
+	static constexpr double defaultEpsilon = Contour2D::defaultEpsilon;
+	/**
+	* @brief Default constructor.
+	*/
+	VertexChainContour2D() = default;
+	/**
+	* @brief Builds a vertex chain from a continuous contour.
+	*
+	* A closed contour produces a closed chain.
+	*
+	* @param contour Contour2D to copy from; throws std::invalid_argument if it is not valid.
+	*/
+	explicit VertexChainContour2D(const Contour2D& contour);
+	/**
+	* @brief Converts the chain back into a Contour2D.
+	* @return A Contour2D holding equivalent segments.
+	*/
+	Contour2D toContour2D() const;
+
+	/**
+	* @brief Appends a segment to the end of an open chain.
+	*
+	* The segment must start at the current last vertex within epsilon; its start point
+	* is snapped onto that vertex. Throws std::invalid_argument otherwise and
+	* std::logic_error if the chain is closed.
+	*
+	* @param segment The Segment2D to copy.
+	*/
+	void addSegment(const Segment2D& segment);
+	/**
+	* @brief Appends a segment to the end of an open chain.
+	* @param segment A unique_ptr to a Segment2D.
+	*/
+	void addSegment(std::unique_ptr<Segment2D> segment) { addSegment(*segment); }
+	/**
+	* @brief Inserts a segment before the given position.
+	*
+	* The segment must start at the start vertex of the segment currently at position
+	* (or at the last vertex when appending). Its end point becomes a new vertex, and the
+	* segment that previously started at position now starts there.
+	*
+	* @param segment A unique_ptr to a Segment2D.
+	* @param position Index at which to insert the segment.
+	*/
+	void insertSegment(std::unique_ptr<Segment2D> segment, int position);
+	/**
+	* @brief Removes a segment at the given position.
+	*
+	* Removing an end segment of an open chain drops its outer vertex; otherwise the two
+	* vertices of the removed segment are merged into one.
+	*
+	* @param position Index of the segment to remove.
+	*/
+	void removeSegment(const int position);
+	/**
+	* @brief Merges the last vertex into the first, turning the chain into a closed loop.
+	*
+	* Throws std::logic_error if the chain ends are further apart than epsilon.
+	*/
+	void close();
+	/**
+	* @brief Checks whether the contour is valid (continuous).
+	* @return Always true; continuity is structural.
+	*/
+	bool isValid() const { return true; }
+	/**
+	* @brief Determines whether the contour forms a closed shape.
+	* @return True if the chain is closed or its first and last vertices meet within epsilon.
+	*/
+	bool isClosedShape() const;
+	/**
+	* @brief Translates the contour by moving every vertex once.
+	* @param dx Offset along the X axis.
+	* @param dy Offset along the Y axis.
+	*/
+	void move(double dx, double dy);
+	/**
+	* @brief Returns the start point of the segment at the given index.
+	* @param index Index of the segment.
+	* @return Point A of the segment.
+	*/
+	MyPoint getPointAAt(std::size_t index) const;
+	/**
+	* @brief Returns the end point of the segment at the given index.
+	* @param index Index of the segment.
+	* @return Point B of the segment.
+	*/
+	MyPoint getPointBAt(std::size_t index) const;
+	/**
+	* @brief Returns the kind of the segment at the given index.
+	* @param index Index of the segment.
+	* @return Segment kind.
+	*/
+	SegmentKind getKindAt(std::size_t index) const;
+	/**
+	* @brief Returns a standalone copy of the segment at the given index.
+	* @param index Index of the segment.
+	* @return A unique_ptr to the rebuilt segment.
+	*/
+	std::unique_ptr<Segment2D> getSegmentCopyAt(std::size_t index) const;
+	/**
+	* @brief Returns the number of segments in the contour.
+	* @return Number of segments.
+	*/
+	size_t getSegmentCount() const { return kinds.size(); }
+	/**
+	* @brief Returns the number of stored vertices.
+	* @return N+1 for an open chain of N segments, N for a closed one.
+	*/
+	size_t getVertexCount() const { return vx.size(); }
+
+};
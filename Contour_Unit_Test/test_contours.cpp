@@ -7,10 +7,27 @@
 #include <vector>
 #include <thread>
 #include <future>
+#include <type_traits>
+#include <chrono>
 #include "Contour2D.h"
 #include "LineSegment2D.h"
 #include "ArcSegment2D.h"
 #include "ContourUtils.h"
+#include "FlatContour2D.h"
+#include "InlineContour2D.h"
+#include "VertexChainContour2D.h"
+#include "ContourSet.h"
+#include "ContourBatch.h"
+#include "PointContainment.h"
+#include "PreparedContour2D.h"
+#include "ContourDistance.h"
+#include "ContourIntersection.h"
+#include "ContourBoolean.h"
+#include "ContourOffset.h"
+#include "PocketGenerator.h"
+#include "ContourTessellation.h"
+#include "PolylineSimplification.h"
+#include "ArcFitting.h"
 #include "MyPoint.h"
 
  /**
@@ -189,6 +206,51 @@ std::vector<Contour2D*> findInvalidContours_test(std::vector<Contour2D>& contour
 	return result;
 }
 
+/**
+ * @brief			Helper building a 2 x 2 square with a half disc on top and a dent in its left side.
+ *
+ * The dent is a half circle of radius 0.5 around (0, 1), added as a reversed (clockwise) arc.
+ *
+ * @return			Closed, counter-clockwise contour of six segments; the dent is segment 4.
+ */
+static Contour2D makeDentedSquare() {
+	Contour2D shape;
+	shape.addSegment(std::make_unique<LineSegment2D>(MyPoint(0, 0), MyPoint(2, 0)));
+	shape.addSegment(std::make_unique<LineSegment2D>(MyPoint(2, 0), MyPoint(2, 2)));
+	shape.addSegment(std::make_unique<ArcSegment2D>(MyPoint(1, 2), 1, 0, M_PI));
+	shape.addSegment(std::make_unique<LineSegment2D>(MyPoint(0, 2), MyPoint(0, 1.5)));
+	auto dent = std::make_unique<ArcSegment2D>(MyPoint(0, 1), 0.5, -M_PI / 2, M_PI / 2);
+	dent->reverse();
+	shape.addSegment(std::move(dent));
+	shape.addSegment(std::make_unique<LineSegment2D>(MyPoint(0, 0.5), MyPoint(0, 0)));
+	return shape;
+}
+
+/**
+ * @brief			Helper building a Pac-Man: a unit-circle major arc from 45 to 315 degrees, closed through the origin.
+ * @return			Closed contour of the arc and two lines.
+ */
+static Contour2D makePacman() {
+	Contour2D pacman;
+	pacman.addSegment(std::make_unique<ArcSegment2D>(MyPoint(0, 0), 1, M_PI / 4, 7 * M_PI / 4));
+	pacman.addSegment(std::make_unique<LineSegment2D>(pacman.getSegmentAt(0).getPointB(), MyPoint(0, 0)));
+	pacman.addSegment(std::make_unique<LineSegment2D>(MyPoint(0, 0), pacman.getSegmentAt(0).getPointA()));
+	return pacman;
+}
+
+/**
+ * @brief			Helper summing the signed areas of boundary loops.
+ * @param loops		Loops with outer boundaries counter-clockwise and holes clockwise.
+ * @return			Net enclosed area.
+ */
+static double totalArea(const std::vector<Contour2D>& loops) {
+	double area = 0;
+	for (const auto& loop : loops) {
+		area += loop.signedArea();
+	}
+	return area;
+}
+
 /**
  * @test	ValidInvalidContourSearch
  * @brief	Tests parallel filtering of valid/invalid contours and checks no duplicates are found.
@@ -292,8 +354,8 @@ TEST(ContourTest, MoveContour) {
 		std::cout << "A - Old X: " << x1 << " Old Y: " << y1 << " B - Old X: " << x2 << " Old Y: " << y2 << std::endl;
 	}
 	auto it1 = validPolylineContour.begin();
-	double fx1 = it1->get()->getPointA().getX();
-	double fy1 = it1->get()->getPointA().getY();
+	double fx1 = it1->getPointA().getX();
+	double fy1 = it1->getPointA().getY();
 
 	validPolylineContour.move(deltax, deltay);
 	for (size_t i = 0; i < validPolylineContour.getSegmentCount(); i++) {
@@ -306,11 +368,1687 @@ TEST(ContourTest, MoveContour) {
 		std::cout << "A - New X: " << x1 << " New Y: " << y1 << " B - New X: " << x2 << " New Y: " << y2 << std::endl;
 	}
 	auto it2 = validPolylineContour.begin();
-	double fx2 = it2->get()->getPointA().getX();
-	double fy2 = it2->get()->getPointA().getY();
+	double fx2 = it2->getPointA().getX();
+	double fy2 = it2->getPointA().getY();
 
 	EXPECT_TRUE((fx1 + deltax) == fx2);
 	EXPECT_TRUE((fy1 + deltay) == fy2);
 	EXPECT_TRUE(validPolylineContour.isValid());
 }
 
+/**
+ * @test	MovePolarArc
+ * @brief	Moving an arc built from center and angles keeps its center and endpoints.
+ */
+TEST(ContourTest, MovePolarArc) {
+
+	//Quarter circle: the center lies left of the chord, so the center-side flag is set
+	ArcSegment2D minor(MyPoint(2, 3), 2, 0, M_PI / 2);
+	EXPECT_TRUE(minor.isClockwise());
+	minor.move(1, -1);
+	EXPECT_NEAR(minor.getCenter().getX(), 3, 1e-9);
+	EXPECT_NEAR(minor.getCenter().getY(), 2, 1e-9);
+	EXPECT_NEAR(minor.getPointA().getX(), 5, 1e-9);
+	EXPECT_NEAR(minor.getPointA().getY(), 2, 1e-9);
+	EXPECT_NEAR(minor.getPointB().getX(), 3, 1e-9);
+	EXPECT_NEAR(minor.getPointB().getY(), 4, 1e-9);
+	EXPECT_NEAR(minor.getLength(), M_PI, 1e-9);
+
+	//Three quarters of a circle: the center lies right of the chord
+	ArcSegment2D major(MyPoint(0, 0), 1, 0, 3 * M_PI / 2);
+	EXPECT_FALSE(major.isClockwise());
+	major.move(-2, 5);
+	EXPECT_NEAR(major.getCenter().getX(), -2, 1e-9);
+	EXPECT_NEAR(major.getCenter().getY(), 5, 1e-9);
+	EXPECT_NEAR(major.getPointA().getX(), -1, 1e-9);
+	EXPECT_NEAR(major.getPointA().getY(), 5, 1e-9);
+	EXPECT_NEAR(major.getPointB().getX(), -2, 1e-9);
+	EXPECT_NEAR(major.getPointB().getY(), 4, 1e-9);
+	EXPECT_NEAR(major.getLength(), 3 * M_PI / 2, 1e-9);
+}
+
+
+/**
+ * @test	FlatContourRoundTrip
+ * @brief	Converts a mixed arc/line contour to FlatContour2D and back without losing data.
+ */
+TEST(ContourTest, FlatContourRoundTrip) {
+
+	Contour2D c1;
+	c1.addSegment(std::make_unique<ArcSegment2D>(MyPoint(1, 1), MyPoint(1, 2), 5, false));
+	c1.addSegment(std::make_unique<ArcSegment2D>(MyPoint(1, 2), MyPoint(4, 2), 5, true));
+	c1.addSegment(std::make_unique<LineSegment2D>(MyPoint(4, 2), MyPoint(5, 5)));
+	c1.addSegment(std::make_unique<ArcSegment2D>(MyPoint(0, 0, 1), 2, 0.5, 2.0));
+
+	FlatContour2D flat(c1);
+	EXPECT_EQ(flat.getSegmentCount(), 4);
+	EXPECT_EQ(flat.getKindAt(2), SegmentKind::Line);
+	EXPECT_EQ(flat.isValid(), c1.isValid());
+
+	Contour2D c2 = flat.toContour2D();
+	ASSERT_EQ(c2.getSegmentCount(), c1.getSegmentCount());
+	for (size_t i = 0; i < c1.getSegmentCount(); i++) {
+		const Segment2D& s1 = c1.getSegmentAt(i);
+		const Segment2D& s2 = c2.getSegmentAt(i);
+		EXPECT_EQ(s1.getKind(), s2.getKind());
+		EXPECT_EQ(s1.getPointA().getX(), s2.getPointA().getX());
+		EXPECT_EQ(s1.getPointA().getY(), s2.getPointA().getY());
+		EXPECT_EQ(s1.getPointB().getX(), s2.getPointB().getX());
+		EXPECT_EQ(s1.getPointB().getY(), s2.getPointB().getY());
+		if (s1.getKind() == SegmentKind::Arc) {
+			const ArcSegment2D& a1 = static_cast<const ArcSegment2D&>(s1);
+			const ArcSegment2D& a2 = static_cast<const ArcSegment2D&>(s2);
+			EXPECT_EQ(a1.getCenter().getX(), a2.getCenter().getX());
+			EXPECT_EQ(a1.getCenter().getZ(), a2.getCenter().getZ());
+			EXPECT_EQ(a1.getStartAngle(), a2.getStartAngle());
+			EXPECT_EQ(a1.getEndAngle(), a2.getEndAngle());
+			EXPECT_EQ(a1.isClockwise(), a2.isClockwise());
+		}
+	}
+}
+
+/**
+ * @test	FlatContourEditAndMove
+ * @brief	FlatContour2D editing, validity, closedness and movement match Contour2D.
+ */
+TEST(ContourTest, FlatContourEditAndMove) {
+
+	std::vector<MyPoint> polyPoints;
+	polyPoints.push_back(MyPoint(0, 0));
+	polyPoints.push_back(MyPoint(1, 2));
+	polyPoints.push_back(MyPoint(2, 1));
+	polyPoints.push_back(MyPoint(4, 3));
+
+	Contour2D contour = polylineContourFromPoints(polyPoints, true);
+	contour.addSegment(std::make_unique<ArcSegment2D>(MyPoint(0, 0), MyPoint(0, 3), 5, true));
+	FlatContour2D flat(contour);
+	EXPECT_TRUE(flat.isValid());
+	EXPECT_FALSE(flat.isClosedShape());
+
+	flat.removeSegment(4);
+	EXPECT_TRUE(flat.isClosedShape());
+
+	flat.insertSegment(std::make_unique<LineSegment2D>(MyPoint(5, 7), MyPoint(6, 7)), 2);
+	EXPECT_FALSE(flat.isValid());
+	EXPECT_THROW(flat.removeSegment(10), std::out_of_range);
+	flat.removeSegment(2);
+	EXPECT_TRUE(flat.isValid());
+
+	contour.move(1, 2);
+	flat.addSegment(std::make_unique<ArcSegment2D>(MyPoint(0, 0), MyPoint(0, 3), 5, true));
+	flat.move(1, 2);
+	ASSERT_EQ(flat.getSegmentCount(), contour.getSegmentCount());
+	for (size_t i = 0; i < contour.getSegmentCount(); i++) {
+		EXPECT_DOUBLE_EQ(flat.getPointAAt(i).getX(), contour.getSegmentAt(i).getPointA().getX());
+		EXPECT_DOUBLE_EQ(flat.getPointBAt(i).getY(), contour.getSegmentAt(i).getPointB().getY());
+	}
+	const ArcSegment2D& movedArc = static_cast<const ArcSegment2D&>(contour.getSegmentAt(4));
+	const SegmentArrays2D& arrays = flat.getArrays();
+	EXPECT_DOUBLE_EQ(arrays.cx[4], movedArc.getCenter().getX());
+	EXPECT_DOUBLE_EQ(arrays.startAngle[4], movedArc.getStartAngle());
+}
+
+/**
+ * @test	InlineContourVisit
+ * @brief	InlineContour2D stores segments by value and dispatches through visit().
+ */
+TEST(ContourTest, InlineContourVisit) {
+
+	Contour2D c1;
+	c1.addSegment(std::make_unique<ArcSegment2D>(MyPoint(1, 1), MyPoint(1, 2), 5, false));
+	c1.addSegment(std::make_unique<LineSegment2D>(MyPoint(1, 2), MyPoint(4, 2)));
+	c1.addSegment(std::make_unique<ArcSegment2D>(MyPoint(4, 2), MyPoint(5, 5), 5, true));
+
+	InlineContour2D inlined(c1);
+	EXPECT_EQ(inlined.getSegmentCount(), 3);
+	EXPECT_TRUE(inlined.isValid());
+
+	int arcs = 0;
+	for (const auto& seg : inlined) {
+		arcs += seg.visit([](const auto& concrete) { return concrete.getKind() == SegmentKind::Arc ? 1 : 0; });
+	}
+	EXPECT_EQ(arcs, 2);
+	EXPECT_EQ(inlined.getSegmentAt(1).asLine().getPointB().getX(), 4);
+	EXPECT_THROW(inlined.getSegmentAt(1).asArc(), std::logic_error);
+
+	inlined.insertSegment(std::make_unique<LineSegment2D>(MyPoint(9, 9), MyPoint(1, 1)), 1);
+	EXPECT_FALSE(inlined.isValid());
+	inlined.removeSegment(1);
+	EXPECT_TRUE(inlined.isValid());
+
+	c1.move(2, -1);
+	inlined.move(2, -1);
+	Contour2D c2 = inlined.toContour2D();
+	ASSERT_EQ(c2.getSegmentCount(), c1.getSegmentCount());
+	for (size_t i = 0; i < c1.getSegmentCount(); i++) {
+		EXPECT_DOUBLE_EQ(c2.getSegmentAt(i).getPointA().getX(), c1.getSegmentAt(i).getPointA().getX());
+		EXPECT_DOUBLE_EQ(c2.getSegmentAt(i).getPointB().getY(), c1.getSegmentAt(i).getPointB().getY());
+	}
+	EXPECT_TRUE(c2.isValid());
+}
+
+/**
+ * @test	ArenaAllocatedContour
+ * @brief	Building and copying a contour inside a SegmentArena avoids per-segment heap allocations.
+ */
+TEST(ContourTest, ArenaAllocatedContour) {
+
+	std::vector<MyPoint> polyPoints;
+	for (int i = 0; i < 1000; i++) {
+		polyPoints.push_back(MyPoint(i, (i % 2) ? 1 : 0));
+	}
+
+	SegmentArena arena;
+	{
+		Contour2D arenaContour = polylineContourFromPoints(polyPoints, true, arena);
+		std::vector<Contour2D> batch;
+		for (int i = 0; i < 4; i++) {
+			batch.push_back(copyContour(arenaContour, arena));
+		}
+		//Copies own their segments; editing them allocates nothing further
+		for (auto& copy : batch) {
+			copy.move(0, 1);
+			EXPECT_FALSE(copy.sharesSegmentsWith(arenaContour));
+		}
+		EXPECT_EQ(arena.getAllocationCount(), 5 * arenaContour.getSegmentCount());
+		EXPECT_LT(arena.getUpstreamAllocationCount() * 100, arena.getAllocationCount());
+		std::cout << "Segments allocated: " << arena.getAllocationCount()
+			<< " Heap blocks used: " << arena.getUpstreamAllocationCount() << std::endl;
+
+		EXPECT_TRUE(batch.back().isClosedShape());
+		batch.back().move(1, 1);
+		EXPECT_TRUE(batch.back().isValid());
+	}
+	arena.release();
+	EXPECT_EQ(arena.getAllocationCount(), 0);
+}
+
+/**
+ * @test	VertexChainContour
+ * @brief	A closed contour stored as a vertex chain shares joint vertices and stays continuous when edited.
+ */
+TEST(ContourTest, VertexChainContour) {
+
+	Contour2D c1;
+	c1.addSegment(std::make_unique<LineSegment2D>(MyPoint(0, 0), MyPoint(4, 0)));
+	c1.addSegment(std::make_unique<ArcSegment2D>(MyPoint(4, 0), MyPoint(4, 4), 3, true));
+	c1.addSegment(std::make_unique<LineSegment2D>(MyPoint(4, 4), MyPoint(0, 4)));
+	c1.addSegment(std::make_unique<LineSegment2D>(MyPoint(0, 4), MyPoint(0, 0)));
+	ASSERT_TRUE(c1.isClosedShape());
+
+	VertexChainContour2D chain(c1);
+	EXPECT_EQ(chain.getSegmentCount(), 4);
+	EXPECT_EQ(chain.getVertexCount(), 4);
+	EXPECT_TRUE(chain.isValid());
+	EXPECT_TRUE(chain.isClosedShape());
+
+	const ArcSegment2D& arc = static_cast<const ArcSegment2D&>(c1.getSegmentAt(1));
+	std::unique_ptr<Segment2D> rebuilt = chain.getSegmentCopyAt(1);
+	const ArcSegment2D& rebuiltArc = static_cast<const ArcSegment2D&>(*rebuilt);
+	EXPECT_NEAR(rebuiltArc.getCenter().getX(), arc.getCenter().getX(), 1e-12);
+	EXPECT_NEAR(rebuiltArc.getCenter().getY(), arc.getCenter().getY(), 1e-12);
+
+	chain.move(1, 2);
+	EXPECT_DOUBLE_EQ(chain.getPointBAt(3).getX(), 1);
+	EXPECT_DOUBLE_EQ(chain.getPointBAt(3).getY(), 2);
+
+	//Splitting the first edge keeps the loop closed
+	chain.insertSegment(std::make_unique<LineSegment2D>(MyPoint(1, 2), MyPoint(3, 2)), 0);
+	EXPECT_EQ(chain.getSegmentCount(), 5);
+	EXPECT_DOUBLE_EQ(chain.getPointAAt(1).getX(), 3);
+	EXPECT_THROW(chain.insertSegment(std::make_unique<LineSegment2D>(MyPoint(9, 9), MyPoint(3, 2)), 0), std::invalid_argument);
+
+	chain.removeSegment(4);
+	EXPECT_TRUE(chain.isClosedShape());
+	EXPECT_TRUE(chain.toContour2D().isValid());
+
+	Contour2D broken;
+	broken.addSegment(std::make_unique<LineSegment2D>(MyPoint(0, 0), MyPoint(1, 0)));
+	broken.addSegment(std::make_unique<LineSegment2D>(MyPoint(2, 0), MyPoint(3, 0)));
+	EXPECT_THROW(VertexChainContour2D brokenChain(broken), std::invalid_argument);
+
+	VertexChainContour2D open;
+	open.addSegment(std::make_unique<LineSegment2D>(MyPoint(0, 0), MyPoint(1, 0)));
+	open.addSegment(std::make_unique<LineSegment2D>(MyPoint(1, 0), MyPoint(1, 1)));
+	EXPECT_EQ(open.getVertexCount(), 3);
+	EXPECT_FALSE(open.isClosedShape());
+	EXPECT_THROW(open.close(), std::logic_error);
+}
+
+/**
+ * @test	CopyOnWriteContour
+ * @brief	Copies share segment storage until one of them is modified.
+ */
+TEST(ContourTest, CopyOnWriteContour) {
+
+	Contour2D c1;
+	c1.addSegment(std::make_unique<LineSegment2D>(MyPoint(1, 1), MyPoint(1, 2)));
+	c1.addSegment(std::make_unique<LineSegment2D>(MyPoint(1, 2), MyPoint(4, 2)));
+	c1.addSegment(std::make_unique<ArcSegment2D>(MyPoint(4, 2), MyPoint(5, 5), 5, true));
+
+	const Contour2D& constC1 = c1;
+	Contour2D c2 = c1;
+	Contour2D c3;
+	c3 = c2;
+	const Contour2D& constC3 = c3;
+	EXPECT_TRUE(c2.sharesSegmentsWith(c1));
+	EXPECT_TRUE(c3.sharesSegmentsWith(c1));
+	EXPECT_EQ(&constC3.getSegmentAt(2), &constC1.getSegmentAt(2));
+
+	c2.move(1, 0);
+	EXPECT_FALSE(c2.sharesSegmentsWith(c1));
+	EXPECT_TRUE(c3.sharesSegmentsWith(c1));
+	EXPECT_DOUBLE_EQ(constC1.getSegmentAt(0).getPointA().getX(), 1);
+	EXPECT_DOUBLE_EQ(c2.begin()->getPointA().getX(), 2);
+
+	//Iterating hands out read-only segments and leaves the storage shared
+	static_assert(std::is_same<decltype(*c3.begin()), const Segment2D&>::value, "iteration must be read-only");
+	for (const Segment2D& seg : c3) {
+		EXPECT_GT(seg.getLength(), 0);
+	}
+	EXPECT_TRUE(c3.sharesSegmentsWith(c1));
+
+	c3.removeSegment(2);
+	EXPECT_EQ(c3.getSegmentCount(), 2);
+	EXPECT_EQ(c1.getSegmentCount(), 3);
+
+	//A mutable reference makes later copies deep
+	Segment2D& seg = c1.getSegmentAt(0);
+	Contour2D c4 = c1;
+	EXPECT_FALSE(c4.sharesSegmentsWith(c1));
+	seg.move(0, 5);
+	EXPECT_DOUBLE_EQ(c4.getSegmentAt(0).getPointA().getY(), 1);
+	EXPECT_FALSE(c1.isValid());
+	EXPECT_TRUE(c4.isValid());
+
+	//Writing to a large shared contour clones only the chunks it touches
+	std::vector<MyPoint> zigzag;
+	for (int i = 0; i <= 2000; i++) {
+		zigzag.push_back(MyPoint(i, i % 2));
+	}
+	const Contour2D large = polylineContourFromPoints(zigzag, false);
+	Contour2D edited = large;
+	const Contour2D& constEdited = edited;
+	edited.getSegmentAt(10).move(0, 0);
+	EXPECT_NE(&constEdited.getSegmentAt(10), &large.getSegmentAt(10));
+	EXPECT_EQ(&constEdited.getSegmentAt(1500), &large.getSegmentAt(1500));
+	EXPECT_TRUE(edited.sharesSegmentsWith(large));
+
+	//Inserting into a full chunk splits it and keeps every index in place
+	Contour2D grown = large;
+	const Contour2D& constGrown = grown;
+	for (int i = 0; i < 300; i++) {
+		grown.insertSegment(std::make_unique<LineSegment2D>(MyPoint(600, 0), MyPoint(600, 0)), 600);
+	}
+	EXPECT_EQ(grown.getSegmentCount(), 2300);
+	EXPECT_TRUE(grown.isValid());
+	EXPECT_EQ(&constGrown.getSegmentAt(100), &large.getSegmentAt(100));
+	EXPECT_EQ(&constGrown.getSegmentAt(1900), &large.getSegmentAt(1600));
+	EXPECT_DOUBLE_EQ(constGrown.getSegmentAt(900).getPointA().getX(), 600);
+	for (int i = 0; i < 300; i++) {
+		grown.removeSegment(600);
+	}
+	EXPECT_TRUE(grown.validate().isValid());
+	EXPECT_NEAR(grown.totalLength(), large.totalLength(), 1e-9);
+	size_t visited = 0;
+	for (const Segment2D& part : grown) {
+		EXPECT_DOUBLE_EQ(part.getPointB().getY(), large.getSegmentAt(visited).getPointB().getY());
+		visited++;
+	}
+	EXPECT_EQ(visited, 2000);
+}
+
+/**
+ * @test	ContourSetBatchQueries
+ * @brief	ContourSet packs several contours and answers batch validity, closedness and length queries.
+ */
+TEST(ContourTest, ContourSetBatchQueries) {
+
+	std::vector<MyPoint> square;
+	square.push_back(MyPoint(0, 0));
+	square.push_back(MyPoint(2, 0));
+	square.push_back(MyPoint(2, 2));
+	square.push_back(MyPoint(0, 2));
+
+	Contour2D broken;
+	broken.addSegment(std::make_unique<LineSegment2D>(MyPoint(1, 1), MyPoint(1, 2)));
+	broken.addSegment(std::make_unique<LineSegment2D>(MyPoint(5, 6), MyPoint(5, 5)));
+
+	Contour2D arcs;
+	arcs.addSegment(std::make_unique<ArcSegment2D>(MyPoint(1, 1), MyPoint(1, 2), 5, false));
+	arcs.addSegment(std::make_unique<ArcSegment2D>(MyPoint(1, 2), MyPoint(4, 2), 5, true));
+
+	ContourSet set;
+	set.addContour(polylineContourFromPoints(square, true));
+	set.addContour(broken);
+	EXPECT_EQ(set.addContour(FlatContour2D(arcs)), 2);
+	EXPECT_EQ(set.size(), 3);
+	EXPECT_EQ(set.getSegmentCount(), 8);
+
+	std::vector<bool> valid = set.areValid();
+	std::vector<bool> closed = set.areClosedShapes();
+	EXPECT_TRUE(valid[0]);
+	EXPECT_FALSE(valid[1]);
+	EXPECT_TRUE(valid[2]);
+	EXPECT_TRUE(closed[0]);
+	EXPECT_FALSE(closed[2]);
+
+	std::vector<double> lengths = set.getLengths();
+	EXPECT_DOUBLE_EQ(lengths[0], 8);
+	EXPECT_DOUBLE_EQ(lengths[1], 2);
+
+	set.move(1, 1);
+	set.move(0, 1, 0);
+	ContourView view = set.getContourAt(0);
+	EXPECT_EQ(view.getSegmentCount(), 4);
+	EXPECT_DOUBLE_EQ(view.getPointAAt(0).getX(), 2);
+	EXPECT_DOUBLE_EQ(view.getPointAAt(0).getY(), 1);
+	EXPECT_TRUE(view.isClosedShape());
+	EXPECT_THROW(set.getContourAt(3), std::out_of_range);
+
+	arcs.move(1, 1);
+	Contour2D restored = set[2].toContour2D();
+	EXPECT_TRUE(restored.isValid());
+	EXPECT_DOUBLE_EQ(restored.getSegmentAt(1).getPointB().getX(), arcs.getSegmentAt(1).getPointB().getX());
+}
+
+/**
+ * @test	ConcurrentValidityQueries
+ * @brief	Many threads query validity of a shared, uncached contour library at the same time.
+ */
+TEST(ContourTest, ConcurrentValidityQueries) {
+
+	std::vector<Contour2D> library;
+	for (int i = 0; i < 64; i++) {
+		Contour2D contour;
+		contour.addSegment(std::make_unique<LineSegment2D>(MyPoint(0, 0), MyPoint(1, 0)));
+		contour.addSegment(std::make_unique<LineSegment2D>(MyPoint(1, i % 2), MyPoint(1, 1)));
+		library.push_back(contour);
+	}
+
+	std::vector<std::future<size_t>> readers;
+	for (int t = 0; t < 8; t++) {
+		readers.push_back(std::async(std::launch::async, [&library]() {
+			size_t validCount = 0;
+			for (const auto& contour : library) {
+				validCount += contour.isValid() ? 1 : 0;
+			}
+			return validCount;
+		}));
+	}
+	for (auto& reader : readers) {
+		EXPECT_EQ(reader.get(), 32);
+	}
+
+	//Moving and assigning contours keeps their cached state
+	std::vector<Contour2D> moved;
+	moved.push_back(std::move(library[0]));
+	library[1] = std::move(moved[0]);
+	EXPECT_TRUE(library[1].isValid());
+}
+
+/**
+ * @test	IncrementalBrokenJointCount
+ * @brief	Edits keep the broken joint count equal to a full rescan.
+ */
+TEST(ContourTest, IncrementalBrokenJointCount) {
+
+	Contour2D contour;
+	for (int i = 0; i < 10; i++) {
+		contour.addSegment(std::make_unique<LineSegment2D>(MyPoint(i, 0), MyPoint(i + 1, 0)));
+	}
+	EXPECT_EQ(contour.getBrokenJointCount(), 0);
+
+	auto rescanned = [](const Contour2D& source) {
+		Contour2D copy(source);
+		copy.getSegmentAt(0);
+		return copy.getBrokenJointCount();
+	};
+
+	contour.insertSegment(std::make_unique<LineSegment2D>(MyPoint(5, 5), MyPoint(6, 5)), 3);
+	EXPECT_EQ(contour.getBrokenJointCount(), 2);
+	EXPECT_EQ(contour.getBrokenJointCount(), rescanned(contour));
+
+	contour.removeSegment(7);
+	EXPECT_EQ(contour.getBrokenJointCount(), 3);
+	EXPECT_EQ(contour.getBrokenJointCount(), rescanned(contour));
+
+	contour.removeSegment(3);
+	contour.removeSegment(0);
+	contour.insertSegment(std::make_unique<LineSegment2D>(MyPoint(0, 0), MyPoint(1, 0)), 0);
+	contour.insertSegment(std::make_unique<LineSegment2D>(MyPoint(10, 0), MyPoint(11, 0)), static_cast<int>(contour.getSegmentCount()));
+	EXPECT_EQ(contour.getBrokenJointCount(), 1);
+	EXPECT_EQ(contour.getBrokenJointCount(), rescanned(contour));
+
+	contour.insertSegment(std::make_unique<LineSegment2D>(MyPoint(6, 0), MyPoint(7, 0)), 6);
+	EXPECT_TRUE(contour.isValid());
+	contour.move(2.5, -1);
+	EXPECT_TRUE(contour.isValid());
+}
+
+/**
+ * @test	ReuseMovedFromContour
+ * @brief	A moved-from contour is empty and keeps no cached state from before the move.
+ */
+TEST(ContourTest, ReuseMovedFromContour) {
+
+	//Open contour with a gap, so the source has a broken joint to forget
+	std::vector<MyPoint> points = { MyPoint(0, 0), MyPoint(3, 0), MyPoint(3, 3) };
+	Contour2D source = polylineContourFromPoints(points, false);
+	source.addSegment(std::make_unique<LineSegment2D>(MyPoint(6, 3), MyPoint(6, 6)));
+	ASSERT_FALSE(source.isValid());
+	EXPECT_NEAR(source.totalLength(), 9, 1e-12);
+	EXPECT_NEAR(source.pointAtLength(9).getY(), 6, 1e-12);
+	ASSERT_EQ(source.segmentBoundingBoxes()->size(), 3);
+
+	Contour2D moved(std::move(source));
+	EXPECT_EQ(moved.getSegmentCount(), 3);
+	EXPECT_EQ(moved.getBrokenJointCount(), 1);
+	EXPECT_EQ(source.getSegmentCount(), 0);
+	EXPECT_EQ(source.getBrokenJointCount(), 0);
+
+	Contour2D assigned;
+	assigned = std::move(moved);
+	EXPECT_EQ(assigned.getBrokenJointCount(), 1);
+	EXPECT_EQ(moved.getSegmentCount(), 0);
+
+	//Both moved-from contours start again from scratch
+	for (Contour2D* reused : { &source, &moved }) {
+		reused->addSegment(std::make_unique<LineSegment2D>(MyPoint(0, 0), MyPoint(1, 0)));
+		EXPECT_EQ(reused->getSegmentCount(), 1);
+		EXPECT_TRUE(reused->isValid());
+		EXPECT_NEAR(reused->totalLength(), 1, 1e-12);
+		EXPECT_NEAR(reused->boundingBox().getMaxX(), 1, 1e-12);
+		EXPECT_NEAR(reused->boundingBox().getMaxY(), 0, 1e-12);
+		EXPECT_NEAR(reused->signedArea(), 0, 1e-12);
+		EXPECT_NEAR(reused->pointAtLength(5).getX(), 1, 1e-12);
+		ASSERT_EQ(reused->segmentBoundingBoxes()->size(), 1);
+		EXPECT_NEAR((*reused->segmentBoundingBoxes())[0].getMaxX(), 1, 1e-12);
+		EXPECT_TRUE(reused->findSegmentsIntersecting(BoundingBox2D(5, 2, 7, 7)).empty());
+		reused->addSegment(std::make_unique<LineSegment2D>(MyPoint(1, 0), MyPoint(1, 1)));
+		EXPECT_EQ(reused->getBrokenJointCount(), 0);
+		EXPECT_NEAR(reused->totalLength(), 2, 1e-12);
+		EXPECT_NEAR(reused->signedArea(), 0.5, 1e-12);
+		EXPECT_EQ(reused->segmentBoundingBoxes()->size(), 2);
+		EXPECT_EQ(reused->findSegmentsIntersecting(BoundingBox2D(0.5, 0.5, 2, 2)), std::vector<size_t>{ 1 });
+	}
+	EXPECT_NEAR(assigned.totalLength(), 9, 1e-12);
+	EXPECT_NEAR(assigned.boundingBox().getMaxX(), 6, 1e-12);
+}
+
+/**
+ * @test	ValidationReportJoints
+ * @brief	validate() lists each broken joint with its gap and reversal.
+ */
+TEST(ContourTest, ValidationReportJoints) {
+
+	//Same segments as InvalidContour_B: segment 3 is reversed
+	Contour2D reversed;
+	reversed.addSegment(std::make_unique<LineSegment2D>(MyPoint(1, 1), MyPoint(1, 2)));
+	reversed.addSegment(std::make_unique<LineSegment2D>(MyPoint(1, 2), MyPoint(4, 2)));
+	reversed.addSegment(std::make_unique<LineSegment2D>(MyPoint(4, 2), MyPoint(5, 5)));
+	reversed.addSegment(std::make_unique<LineSegment2D>(MyPoint(5, 6), MyPoint(5, 5)));
+	reversed.addSegment(std::make_unique<LineSegment2D>(MyPoint(5, 6), MyPoint(6, 7)));
+
+	ValidationReport report = reversed.validate();
+	EXPECT_FALSE(report.isValid());
+	EXPECT_EQ(report.jointCount, 4);
+	ASSERT_EQ(report.defects.size(), 2);
+	EXPECT_EQ(report.defects[0].joint, 2);
+	EXPECT_DOUBLE_EQ(report.defects[0].gap, 1.0);
+	EXPECT_EQ(report.defects[0].reversal, JointReversal::Next);
+	EXPECT_EQ(report.defects[1].joint, 3);
+	EXPECT_EQ(report.defects[1].reversal, JointReversal::Previous);
+
+	//A long contour with gaps at both SIMD lanes and in the scalar tail
+	std::vector<MyPoint> points;
+	for (int i = 0; i <= 102; i++) {
+		points.push_back(MyPoint(i, i % 3));
+	}
+	Contour2D polyline = polylineContourFromPoints(points, false);
+	EXPECT_TRUE(polyline.validate().isValid());
+	polyline.getSegmentAt(10).move(0, 2);
+	polyline.getSegmentAt(100).move(0, 2);
+	FlatContour2D flat(polyline);
+	std::vector<size_t> expected = { 9, 10, 99, 100 };
+	for (const ValidationReport& r : { polyline.validate(), flat.validate() }) {
+		ASSERT_EQ(r.defects.size(), expected.size());
+		for (size_t i = 0; i < expected.size(); i++) {
+			EXPECT_EQ(r.defects[i].joint, expected[i]);
+			EXPECT_DOUBLE_EQ(r.defects[i].gap, 2.0);
+			EXPECT_EQ(r.defects[i].reversal, JointReversal::None);
+		}
+	}
+	EXPECT_EQ(polyline.getBrokenJointCount(), expected.size());
+}
+
+/**
+ * @test	PartitionByValidity
+ * @brief	Single-pass parallel partition matches the sequential valid/invalid searches.
+ */
+TEST(ContourTest, PartitionByValidity) {
+
+	std::vector<Contour2D> contourVec;
+	for (int i = 0; i < 1000; i++) {
+		Contour2D contour;
+		contour.addSegment(std::make_unique<LineSegment2D>(MyPoint(0, 0), MyPoint(1, 0)));
+		contour.addSegment(std::make_unique<LineSegment2D>(MyPoint(1, (i % 7 == 0) ? 1 : 0), MyPoint(1, 1)));
+		contourVec.push_back(contour);
+	}
+
+	ValidityPartition partition = partitionByValidity(contourVec, ParallelExecutor(4));
+	auto valid = findValidContours_test(contourVec);
+	auto invalid = findInvalidContours_test(contourVec);
+
+	ASSERT_EQ(partition.valid.size(), valid.size());
+	ASSERT_EQ(partition.invalid.size(), invalid.size());
+	for (size_t i = 0; i < valid.size(); i++) {
+		EXPECT_EQ(&contourVec[partition.valid[i]], valid[i]);
+	}
+	for (size_t i = 0; i < invalid.size(); i++) {
+		EXPECT_EQ(&contourVec[partition.invalid[i]], invalid[i]);
+	}
+
+	EXPECT_TRUE(partitionByValidity(std::vector<Contour2D>()).valid.empty());
+}
+
+/**
+ * @test	DerivedProperties
+ * @brief	Cached length, bounding box and signed area follow edits and moves.
+ */
+TEST(ContourTest, DerivedProperties) {
+
+	//Unit square with its top edge replaced by a half circle bulging upwards
+	Contour2D shape;
+	shape.addSegment(std::make_unique<LineSegment2D>(MyPoint(0, 0), MyPoint(2, 0)));
+	shape.addSegment(std::make_unique<LineSegment2D>(MyPoint(2, 0), MyPoint(2, 2)));
+	shape.addSegment(std::make_unique<ArcSegment2D>(MyPoint(1, 2), 1, 0, M_PI));
+	shape.addSegment(std::make_unique<LineSegment2D>(MyPoint(0, 2), MyPoint(0, 0)));
+	ASSERT_TRUE(shape.isClosedShape());
+
+	EXPECT_NEAR(shape.totalLength(), 6 + M_PI, 1e-9);
+	EXPECT_NEAR(shape.signedArea(), 4 + M_PI / 2, 1e-9);
+	BoundingBox2D box = shape.boundingBox();
+	EXPECT_NEAR(box.getMinX(), 0, 1e-9);
+	EXPECT_NEAR(box.getMaxX(), 2, 1e-9);
+	EXPECT_NEAR(box.getMinY(), 0, 1e-9);
+	EXPECT_NEAR(box.getMaxY(), 3, 1e-9);
+
+	//Cached values are shifted, not recomputed, and must match a fresh computation
+	shape.move(3, -1);
+	Contour2D fresh(shape);
+	fresh.getSegmentAt(0);
+	EXPECT_NEAR(shape.signedArea(), fresh.signedArea(), 1e-9);
+	EXPECT_NEAR(shape.boundingBox().getMaxY(), 2, 1e-9);
+	EXPECT_NEAR(shape.boundingBox().getMinX(), fresh.boundingBox().getMinX(), 1e-9);
+	EXPECT_NEAR(shape.totalLength(), fresh.totalLength(), 1e-9);
+
+	//Removing the arc shrinks the box; a straight top edge restores the square
+	shape.removeSegment(2);
+	EXPECT_NEAR(shape.totalLength(), 6, 1e-9);
+	EXPECT_NEAR(shape.boundingBox().getMaxY(), 1, 1e-9);
+	shape.insertSegment(std::make_unique<LineSegment2D>(MyPoint(5, 1), MyPoint(3, 1)), 2);
+	EXPECT_NEAR(shape.signedArea(), 4, 1e-9);
+
+	//An open contour is closed by a chord from its end back to its start
+	shape.removeSegment(3);
+	EXPECT_NEAR(shape.signedArea(), 4, 1e-9);
+
+	//Clockwise square has negative area
+	std::vector<MyPoint> points = { MyPoint(0, 0), MyPoint(0, 1), MyPoint(1, 1), MyPoint(1, 0) };
+	EXPECT_NEAR(polylineContourFromPoints(points, true).signedArea(), -1, 1e-12);
+	EXPECT_TRUE(Contour2D().boundingBox().isEmpty());
+}
+
+/**
+ * @test	ArcLengthQueries
+ * @brief	Points and tangents at arc-length distances over lines and arcs.
+ */
+TEST(ContourTest, ArcLengthQueries) {
+
+	Contour2D path;
+	path.addSegment(std::make_unique<LineSegment2D>(MyPoint(0, 0), MyPoint(2, 0)));
+	path.addSegment(std::make_unique<LineSegment2D>(MyPoint(2, 0), MyPoint(2, 0)));
+	//Quarter circle of radius 1 around (2, 1), counter-clockwise from (2, 0) to (3, 1)
+	path.addSegment(std::make_unique<ArcSegment2D>(MyPoint(2, 1), 1, -M_PI / 2, 0));
+	path.addSegment(std::make_unique<LineSegment2D>(MyPoint(3, 1), MyPoint(3, 4)));
+	const double total = 5 + M_PI / 2;
+	EXPECT_NEAR(path.totalLength(), total, 1e-12);
+
+	EXPECT_NEAR(path.pointAtLength(1.5).getX(), 1.5, 1e-12);
+	MyPoint onArc = path.pointAtLength(2 + M_PI / 4);
+	EXPECT_NEAR(onArc.getX(), 2 + sqrt(0.5), 1e-12);
+	EXPECT_NEAR(onArc.getY(), 1 - sqrt(0.5), 1e-12);
+	MyPoint arcTangent = path.tangentAtLength(2 + M_PI / 4);
+	EXPECT_NEAR(arcTangent.getX(), sqrt(0.5), 1e-12);
+	EXPECT_NEAR(arcTangent.getY(), sqrt(0.5), 1e-12);
+	EXPECT_NEAR(path.tangentAtLength(2).getX(), 1, 1e-12);
+	EXPECT_NEAR(path.pointAtLength(total + 10).getY(), 4, 1e-12);
+	EXPECT_NEAR(path.pointAtLength(-1).getX(), 0, 1e-12);
+
+	//Batched results match single queries, and the index follows edits
+	std::vector<double> distances = { 0.0, 1.0, 2.0, 2.5, 3.0, 4.0, total };
+	std::vector<MyPoint> points = path.pointsAtLengths(distances);
+	std::vector<MyPoint> tangents = path.tangentsAtLengths(distances);
+	ASSERT_EQ(points.size(), distances.size());
+	for (size_t i = 0; i < distances.size(); i++) {
+		EXPECT_NEAR(points[i].getX(), path.pointAtLength(distances[i]).getX(), 1e-12);
+		EXPECT_NEAR(points[i].getY(), path.pointAtLength(distances[i]).getY(), 1e-12);
+		EXPECT_NEAR(tangents[i].getY(), path.tangentAtLength(distances[i]).getY(), 1e-12);
+	}
+	path.removeSegment(0);
+	EXPECT_NEAR(path.pointAtLength(M_PI / 2 + 1).getY(), 2, 1e-12);
+	path.move(1, 1);
+	EXPECT_NEAR(path.pointAtLength(M_PI / 2 + 1).getY(), 3, 1e-12);
+
+	EXPECT_THROW(path.pointsAtLengths({ 2.0, 1.0 }), std::invalid_argument);
+	EXPECT_THROW(Contour2D().pointAtLength(0), std::out_of_range);
+}
+
+/**
+ * @test	OrientationAndReverse
+ * @brief	Reversing keeps lines and arcs on the same points and flips orientation.
+ */
+TEST(ContourTest, OrientationAndReverse) {
+
+	//Square with a half disc on top, as in DerivedProperties, plus a dent made of a reversed arc
+	Contour2D shape = makeDentedSquare();
+	const ArcSegment2D& dent = static_cast<const ArcSegment2D&>(*std::next(shape.begin(), 4));
+	EXPECT_FALSE(dent.isCounterClockwise());
+	EXPECT_NEAR(dent.getLength(), M_PI / 2, 1e-12);
+	ASSERT_TRUE(shape.isClosedShape());
+
+	const double area = 4 + M_PI / 2 - M_PI / 8;
+	EXPECT_NEAR(shape.signedArea(), area, 1e-9);
+	EXPECT_EQ(shape.orientation(), Orientation::CounterClockwise);
+	BoundingBox2D box = shape.boundingBox();
+	EXPECT_NEAR(box.getMinX(), 0, 1e-9);
+	EXPECT_NEAR(box.getMaxY(), 3, 1e-9);
+
+	//The dent bulges into the square, away from the x = 0 edge
+	MyPoint dentMiddle = shape.pointAtLength(2 + 2 + M_PI + 0.5 + M_PI / 4);
+	EXPECT_NEAR(dentMiddle.getX(), 0.5, 1e-9);
+	EXPECT_NEAR(dentMiddle.getY(), 1, 1e-9);
+
+	FlatContour2D flat(shape);
+	EXPECT_NEAR(flat.signedArea(), area, 1e-9);
+
+	shape.reverse();
+	EXPECT_TRUE(shape.isClosedShape());
+	EXPECT_NEAR(shape.signedArea(), -area, 1e-9);
+	EXPECT_EQ(shape.orientation(), Orientation::Clockwise);
+	EXPECT_NEAR(shape.totalLength(), 6 + M_PI + M_PI / 2 - 1, 1e-9);
+	Contour2D fresh(shape);
+	fresh.getSegmentAt(0);
+	EXPECT_NEAR(fresh.signedArea(), -area, 1e-9);
+	EXPECT_NEAR(fresh.boundingBox().getMaxY(), 3, 1e-9);
+
+	flat.reverse();
+	EXPECT_TRUE(flat.isClosedShape());
+	EXPECT_EQ(flat.orientation(), Orientation::Clockwise);
+	Contour2D roundTrip = flat.toContour2D();
+	EXPECT_NEAR(roundTrip.signedArea(), -area, 1e-9);
+	roundTrip.move(1, 1);
+	EXPECT_NEAR(roundTrip.signedArea(), -area, 1e-9);
+	EXPECT_TRUE(roundTrip.isClosedShape());
+
+	VertexChainContour2D chain(shape);
+	EXPECT_NEAR(chain.toContour2D().signedArea(), -area, 1e-9);
+
+	ContourSet set;
+	set.addContour(shape);
+	set.addContour(flat);
+	EXPECT_NEAR(set.getSignedAreas()[0], -area, 1e-9);
+	EXPECT_NEAR(set[1].getSignedArea(), -area, 1e-9);
+}
+
+/**
+ * @test	BoundingBoxCulling
+ * @brief	Per-segment and per-contour boxes are exact for arcs and follow edits and moves.
+ */
+TEST(ContourTest, BoundingBoxCulling) {
+
+	//Three quarters of a circle around the origin, counter-clockwise from (1, 0) to (0, -1)
+	ArcSegment2D arc(MyPoint(0, 0), 1, 0, 3 * M_PI / 2);
+	BoundingBox2D arcBox = arc.getBoundingBox();
+	EXPECT_NEAR(arcBox.getMinX(), -1, 1e-12);
+	EXPECT_NEAR(arcBox.getMaxY(), 1, 1e-12);
+	EXPECT_NEAR(arcBox.getMinY(), -1, 1e-12);
+	EXPECT_NEAR(arcBox.getMaxX(), 1, 1e-12);
+	//The short way round only reaches its endpoints
+	ArcSegment2D quarter(MyPoint(0, 0), 1, 3 * M_PI / 2, 2 * M_PI);
+	EXPECT_NEAR(quarter.getBoundingBox().getMinX(), 0, 1e-12);
+	quarter.reverse();
+	EXPECT_NEAR(quarter.getBoundingBox().getMinX(), 0, 1e-12);
+	EXPECT_NEAR(quarter.getBoundingBox().getMaxY(), 0, 1e-12);
+
+	Contour2D contour;
+	contour.addSegment(std::make_unique<ArcSegment2D>(arc));
+	contour.addSegment(std::make_unique<LineSegment2D>(MyPoint(0, -1), MyPoint(4, -1)));
+	auto boxes = contour.segmentBoundingBoxes();
+	ASSERT_EQ(boxes->size(), 2);
+	EXPECT_EQ(contour.findSegmentsIntersecting(BoundingBox2D(2, -2, 3, 0)), std::vector<size_t>{ 1 });
+	EXPECT_TRUE(contour.findSegmentsIntersecting(BoundingBox2D(5, 5, 6, 6)).empty());
+
+	contour.move(10, 0);
+	EXPECT_NEAR((*contour.segmentBoundingBoxes())[0].getMinX(), 9, 1e-9);
+	EXPECT_NEAR((*boxes)[0].getMinX(), -1, 1e-12);
+	contour.insertSegment(std::make_unique<LineSegment2D>(MyPoint(9, 5), MyPoint(9, 6)), 0);
+	EXPECT_EQ(contour.findSegmentsIntersecting(BoundingBox2D(8, 4.5, 9.5, 5.5)), std::vector<size_t>{ 0 });
+	contour.removeSegment(0);
+	EXPECT_NEAR(contour.boundingBox().getMaxY(), 1, 1e-9);
+
+	FlatContour2D flat(contour);
+	EXPECT_NEAR(flat.boundingBox().getMinX(), 9, 1e-9);
+	std::vector<MyPoint> diagonal = { MyPoint(0, 0), MyPoint(1, 1) };
+	std::vector<Contour2D> parts = { contour, Contour2D(), polylineContourFromPoints(diagonal, false) };
+	EXPECT_EQ(findContoursIntersecting(parts, BoundingBox2D(0.5, 0.5, 2, 2)), std::vector<size_t>{ 2 });
+
+	ContourSet set;
+	set.addContour(contour);
+	set.addContour(flat);
+	set.move(1, -10, 0);
+	EXPECT_NEAR(set.getBoundingBoxes()[1].getMinX(), -1, 1e-9);
+	EXPECT_EQ(set.findIntersecting(BoundingBox2D(-2, -2, 0, 0)), std::vector<size_t>{ 1 });
+}
+
+/**
+ * @test	WindingNumberContainment
+ * @brief	Containment of grid points in shapes with minor, major and reversed arcs.
+ */
+TEST(ContourTest, WindingNumberContainment) {
+
+	//Square with a half disc on top and a dent cut into its left side by a clockwise arc
+	Contour2D shape = makeDentedSquare();
+
+	auto insideShape = [](double x, double y) {
+		bool inSquare = x > 0 && x < 2 && y > 0 && y <= 2;
+		bool inTop = y > 2 && (x - 1) * (x - 1) + (y - 2) * (y - 2) < 1;
+		bool inDent = x * x + (y - 1) * (y - 1) < 0.25;
+		return (inSquare || inTop) && !inDent;
+	};
+
+	//Pac-Man: major arc from 45 to 315 degrees, closed through the center
+	Contour2D pacman = makePacman();
+	auto insidePacman = [](double x, double y) {
+		return x * x + y * y < 1 && !(x > 0 && std::abs(y) < x);
+	};
+
+	std::vector<MyPoint> points;
+	for (int i = 0; i < 60; i++) {
+		for (int j = 0; j < 70; j++) {
+			points.push_back(MyPoint(-1.13 + i * 0.0537, -1.07 + j * 0.0611));
+		}
+	}
+
+	std::vector<unsigned char> inShape = containsPoints(shape, points, ParallelExecutor(3));
+	std::vector<int> pacmanWinding = windingNumbers(pacman, points);
+	Contour2D reversedShape(shape);
+	reversedShape.reverse();
+	ContourSet set;
+	set.addContour(pacman);
+	ContourEdges2D flatPacman(set.getArrays(), 0, set.getSegmentCount());
+	size_t insideCount = 0;
+	for (size_t i = 0; i < points.size(); i++) {
+		const double x = points[i].getX();
+		const double y = points[i].getY();
+		ASSERT_EQ(inShape[i] != 0, insideShape(x, y)) << x << " " << y;
+		EXPECT_EQ(containsPoint(shape, points[i]), insideShape(x, y));
+		EXPECT_EQ(windingNumber(reversedShape, points[i]), insideShape(x, y) ? -1 : 0);
+		ASSERT_EQ(pacmanWinding[i], insidePacman(x, y) ? 1 : 0) << x << " " << y;
+		EXPECT_EQ(flatPacman.windingNumber(points[i]), pacmanWinding[i]);
+		insideCount += inShape[i];
+	}
+	EXPECT_GT(insideCount, 100);
+
+	//An open contour is closed by its chord, here the vertical line x = sqrt(0.5)
+	Contour2D open(pacman);
+	open.removeSegment(2);
+	open.removeSegment(1);
+	EXPECT_EQ(windingNumber(open, MyPoint(0.8, 0)), 0);
+	EXPECT_EQ(windingNumber(open, MyPoint(0.5, 0.1)), 1);
+	EXPECT_EQ(windingNumber(open, MyPoint(-0.5, 0)), 1);
+	EXPECT_EQ(ContourEdges2D(open).windingNumber(MyPoint(0.6, 0.2)), 1);
+}
+
+/**
+ * @test	PreparedContourLocation
+ * @brief	The point-location grid agrees with the direct winding number and reports boundary points.
+ */
+TEST(ContourTest, PreparedContourLocation) {
+
+	//Same shapes as WindingNumberContainment, plus a 300-vertex star so the grid has many cells
+	Contour2D shape = makeDentedSquare();
+	Contour2D pacman = makePacman();
+
+	std::vector<MyPoint> starPoints;
+	for (int i = 0; i < 300; i++) {
+		double angle = 2 * M_PI * i / 300;
+		double r = (i % 2 == 0) ? 1.0 : 0.6;
+		starPoints.push_back(MyPoint(r * std::cos(angle), r * std::sin(angle)));
+	}
+	Contour2D star = polylineContourFromPoints(starPoints, true);
+
+	//Symmetric L shape: a chord runs through the middle of a grid cell
+	std::vector<MyPoint> lPoints = { MyPoint(0, 0), MyPoint(2, 0), MyPoint(2, 1), MyPoint(1, 1), MyPoint(1, 2), MyPoint(0, 2) };
+	Contour2D lShape = polylineContourFromPoints(lPoints, true);
+
+	std::vector<MyPoint> points;
+	for (int i = 0; i < 60; i++) {
+		for (int j = 0; j < 70; j++) {
+			points.push_back(MyPoint(-1.13 + i * 0.0537, -1.07 + j * 0.0611));
+		}
+	}
+
+	for (const Contour2D* contour : { &shape, &pacman, &star, &lShape }) {
+		//A tight tolerance, since one grid point lies within 1e-5 of a star edge
+		PreparedContour2D prepared(*contour, 1e-9);
+		std::vector<PointLocation> locations = prepared.locate(points, ParallelExecutor(3));
+		for (size_t i = 0; i < points.size(); i++) {
+			int expected = windingNumber(*contour, points[i]);
+			ASSERT_EQ(prepared.windingNumber(points[i]), expected) << points[i].getX() << " " << points[i].getY();
+			EXPECT_EQ(locations[i], expected != 0 ? PointLocation::Inside : PointLocation::Outside) << points[i].getX() << " " << points[i].getY();
+		}
+	}
+	EXPECT_GT(PreparedContour2D(star).getCellCountX() * PreparedContour2D(star).getCellCountY(), 100);
+
+	//Points on lines, arcs and joints are reported as boundary
+	PreparedContour2D prepared(shape);
+	EXPECT_EQ(prepared.locate(MyPoint(1, 0)), PointLocation::Boundary);
+	EXPECT_EQ(prepared.locate(MyPoint(2, 2)), PointLocation::Boundary);
+	EXPECT_EQ(prepared.locate(MyPoint(1 + std::cos(1.0), 2 + std::sin(1.0))), PointLocation::Boundary);
+	EXPECT_EQ(prepared.locate(MyPoint(0.5, 1)), PointLocation::Boundary);
+	EXPECT_EQ(prepared.locate(MyPoint(0.5, 1.01)), PointLocation::Inside);
+	EXPECT_EQ(prepared.locate(MyPoint(0.3, 1)), PointLocation::Outside);
+	EXPECT_EQ(prepared.locate(MyPoint(1, 3.5)), PointLocation::Outside);
+	EXPECT_TRUE(prepared.contains(MyPoint(1, 2.5)));
+	EXPECT_FALSE(prepared.contains(MyPoint(1, 0)));
+
+	//Clockwise contours wind negatively; empty ones contain nothing
+	Contour2D reversed(shape);
+	reversed.reverse();
+	EXPECT_EQ(PreparedContour2D(reversed).windingNumber(MyPoint(1, 1)), -1);
+	EXPECT_EQ(PreparedContour2D(Contour2D()).locate(MyPoint(0, 0)), PointLocation::Outside);
+}
+
+/**
+ * @test	PreparedContourBreakEven
+ * @brief	Measures how many queries it takes for PreparedContour2D to repay its build cost.
+ */
+TEST(ContourTest, PreparedContourBreakEven) {
+
+	std::vector<MyPoint> points;
+	for (int i = 0; i < 50; i++) {
+		for (int j = 0; j < 40; j++) {
+			points.push_back(MyPoint(-1.1 + i * 0.0443, -1.1 + j * 0.0557));
+		}
+	}
+
+	for (int vertices : { 100, 1000, 10000 }) {
+		std::vector<MyPoint> starPoints;
+		for (int i = 0; i < vertices; i++) {
+			double angle = 2 * M_PI * i / vertices;
+			double r = (i % 2 == 0) ? 1.0 : 0.6;
+			starPoints.push_back(MyPoint(r * std::cos(angle), r * std::sin(angle)));
+		}
+		Contour2D star = polylineContourFromPoints(starPoints, true);
+
+		auto start = std::chrono::steady_clock::now();
+		PreparedContour2D prepared(star);
+		double buildTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		long long preparedSum = 0;
+		start = std::chrono::steady_clock::now();
+		for (const MyPoint& p : points) {
+			preparedSum += prepared.windingNumber(p);
+		}
+		double preparedTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		long long directSum = 0;
+		start = std::chrono::steady_clock::now();
+		for (const MyPoint& p : points) {
+			directSum += windingNumber(star, p);
+		}
+		double directTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		EXPECT_EQ(preparedSum, directSum);
+		double saving = (directTime - preparedTime) / points.size();
+		std::cout << "Segments: " << star.getSegmentCount() << " Build: " << buildTime * 1e6 << " us"
+			<< " Query: " << preparedTime / points.size() * 1e9 << " ns prepared, "
+			<< directTime / points.size() * 1e9 << " ns direct";
+		if (saving > 0) {
+			std::cout << " Break-even: " << static_cast<long long>(std::ceil(buildTime / saving)) << " queries";
+		}
+		std::cout << std::endl;
+	}
+}
+
+/**
+ * @test	ClosestPointQueries
+ * @brief	Closest points from the segment tree match a brute-force search over lines and arcs.
+ */
+TEST(ContourTest, ClosestPointQueries) {
+
+	//Square with a half disc on top and a clockwise dent in its left side
+	Contour2D shape = makeDentedSquare();
+
+	ClosestPoint nearest = closestPoint(shape, MyPoint(1, 1));
+	EXPECT_EQ(nearest.segment, 4);
+	EXPECT_NEAR(nearest.distance, 0.5, 1e-12);
+	EXPECT_NEAR(nearest.point.getX(), 0.5, 1e-12);
+	EXPECT_NEAR(nearest.point.getY(), 1, 1e-12);
+	nearest = closestPoint(shape, MyPoint(1, 4));
+	EXPECT_EQ(nearest.segment, 2);
+	EXPECT_NEAR(nearest.point.getY(), 3, 1e-12);
+	EXPECT_NEAR(distanceTo(shape, MyPoint(3, -1)), std::sqrt(2.0), 1e-12);
+	//Beyond the ends of the sweep, the nearest arc point is an endpoint
+	EXPECT_NEAR(shape.getSegmentAt(2).closestPoint(MyPoint(3, 1)).getX(), 2, 1e-12);
+	EXPECT_NEAR(shape.getSegmentAt(4).closestPoint(MyPoint(-1, 1)).getY(), 1.5, 1e-12);
+
+	std::vector<MyPoint> starPoints;
+	for (int i = 0; i < 500; i++) {
+		double angle = 2 * M_PI * i / 500;
+		double r = (i % 2 == 0) ? 1.0 : 0.7;
+		starPoints.push_back(MyPoint(r * std::cos(angle), r * std::sin(angle)));
+	}
+	Contour2D star = polylineContourFromPoints(starPoints, true);
+
+	std::vector<MyPoint> points;
+	for (int i = 0; i < 40; i++) {
+		for (int j = 0; j < 45; j++) {
+			points.push_back(MyPoint(-1.53 + i * 0.0937, -1.47 + j * 0.0811));
+		}
+	}
+	for (const Contour2D* contour : { &shape, &star }) {
+		SegmentTree2D tree(*contour);
+		EXPECT_EQ(tree.size(), contour->getSegmentCount());
+		std::vector<ClosestPoint> batch = closestPoints(*contour, points, ParallelExecutor(3));
+		for (size_t i = 0; i < points.size(); i++) {
+			//Brute force over all segments
+			double best = std::numeric_limits<double>::infinity();
+			for (const auto& seg : *contour) {
+				best = std::min(best, seg.closestPoint(points[i]).distanceTo_2D(points[i]));
+			}
+			ClosestPoint fromTree = tree.closestPoint(points[i]);
+			ASSERT_NEAR(fromTree.distance, best, 1e-12) << points[i].getX() << " " << points[i].getY();
+			EXPECT_NEAR(batch[i].distance, best, 1e-12);
+			EXPECT_NEAR(closestPoint(*contour, points[i]).distance, best, 1e-12);
+			EXPECT_NEAR(contour->getSegmentAt(fromTree.segment).closestPoint(points[i]).distanceTo_2D(points[i]), best, 1e-12);
+		}
+	}
+	EXPECT_GT(SegmentTree2D(star).getNodeCount(), 100);
+
+	EXPECT_THROW(closestPoint(Contour2D(), MyPoint()), std::out_of_range);
+	EXPECT_THROW(SegmentTree2D(Contour2D()).closestPoint(MyPoint()), std::out_of_range);
+}
+
+/**
+ * @test	SelfIntersections
+ * @brief	The sweep reports crossings and contacts of lines and arcs and leaves shared joints out.
+ */
+TEST(ContourTest, SelfIntersections) {
+
+	//Bow tie: the two diagonals cross at (1, 1)
+	std::vector<MyPoint> bowTiePoints = { MyPoint(0, 0), MyPoint(2, 2), MyPoint(2, 0), MyPoint(0, 2) };
+	Contour2D bowTie = polylineContourFromPoints(bowTiePoints, true);
+	std::vector<IntersectionPoint> hits = findSelfIntersections(bowTie);
+	ASSERT_EQ(hits.size(), 1);
+	EXPECT_EQ(hits[0].first, 0);
+	EXPECT_EQ(hits[0].second, 2);
+	EXPECT_NEAR(hits[0].point.getX(), 1, 1e-12);
+	EXPECT_NEAR(hits[0].point.getY(), 1, 1e-12);
+	EXPECT_FALSE(isSimple(bowTie));
+
+	std::vector<MyPoint> squarePoints = { MyPoint(0, 0), MyPoint(2, 0), MyPoint(2, 2), MyPoint(0, 2) };
+	EXPECT_TRUE(isSimple(polylineContourFromPoints(squarePoints, true)));
+
+	//Upper half circle, then a line back across it, closed by a line tangent to the circle at the start
+	Contour2D crossing;
+	crossing.addSegment(std::make_unique<ArcSegment2D>(MyPoint(0, 0), 1, 0, M_PI));
+	crossing.addSegment(std::make_unique<LineSegment2D>(crossing.getSegmentAt(0).getPointB(), MyPoint(1, 1.5)));
+	crossing.addSegment(std::make_unique<LineSegment2D>(MyPoint(1, 1.5), crossing.getSegmentAt(0).getPointA()));
+	hits = findSelfIntersections(crossing);
+	ASSERT_EQ(hits.size(), 1);
+	EXPECT_EQ(hits[0].first, 0);
+	EXPECT_EQ(hits[0].second, 1);
+	EXPECT_NEAR(hits[0].point.getX(), 0.28, 1e-9);
+	EXPECT_NEAR(hits[0].point.getY(), 0.96, 1e-9);
+
+	//Arc-arc kernel: circles of radius 1 around (0, 0) and (1, 0) meet at (0.5, +-sqrt(3)/2)
+	SegmentHits arcHits = intersectSegments(ArcSegment2D(MyPoint(0, 0), 1, 0, M_PI), ArcSegment2D(MyPoint(1, 0), 1, M_PI / 2, M_PI), 1e-9);
+	ASSERT_EQ(arcHits.count, 1);
+	EXPECT_NEAR(arcHits.points[0].getX(), 0.5, 1e-12);
+	EXPECT_NEAR(arcHits.points[0].getY(), std::sqrt(3.0) / 2, 1e-12);
+	EXPECT_EQ(intersectSegments(ArcSegment2D(MyPoint(0, 0), 1, 0, M_PI), ArcSegment2D(MyPoint(0, 0), 1, M_PI / 2, 3 * M_PI / 2), 1e-9).count, 2);
+
+	//A line doubling back over its predecessor is reported beyond the shared joint
+	std::vector<MyPoint> backPoints = { MyPoint(0, 0), MyPoint(2, 0), MyPoint(1, 0) };
+	Contour2D back = polylineContourFromPoints(backPoints, false);
+	hits = findSelfIntersections(back);
+	ASSERT_EQ(hits.size(), 1);
+	EXPECT_NEAR(hits[0].point.getX(), 1, 1e-12);
+
+	//Shapes from the containment tests are simple
+	EXPECT_TRUE(isSimple(makePacman()));
+	EXPECT_TRUE(isSimple(makeDentedSquare()));
+
+	//Lissajous curve: compare the sweep with all non-adjacent pairs
+	std::vector<MyPoint> curvePoints;
+	for (int i = 0; i < 240; i++) {
+		double t = 2 * M_PI * i / 240;
+		curvePoints.push_back(MyPoint(std::sin(3 * t), std::sin(2 * t)));
+	}
+	Contour2D curve = polylineContourFromPoints(curvePoints, true);
+	size_t expected = 0;
+	size_t n = curve.getSegmentCount();
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = i + 2; j < n; j++) {
+			if (i == 0 && j == n - 1) {
+				continue;
+			}
+			expected += intersectSegments(curve.getSegmentAt(i), curve.getSegmentAt(j), Contour2D::defaultEpsilon).count;
+		}
+	}
+	EXPECT_GT(expected, 0);
+	EXPECT_EQ(findSelfIntersections(curve).size(), expected);
+	EXPECT_FALSE(isSimple(curve));
+
+	//Raster toolpath: every row shares the same X range, yet no two rows meet
+	std::vector<MyPoint> rasterPoints;
+	for (int row = 0; row < 400; row++) {
+		double y = row * 0.01;
+		rasterPoints.push_back(MyPoint(row % 2 ? 10 : 0, y));
+		rasterPoints.push_back(MyPoint(row % 2 ? 0 : 10, y));
+	}
+	Contour2D raster = polylineContourFromPoints(rasterPoints, false);
+	EXPECT_TRUE(isSimple(raster));
+	EXPECT_TRUE(findSelfIntersections(raster).empty());
+
+	//A diagonal back through the rows crosses every one except the last, which it starts from
+	raster.addSegment(std::make_unique<LineSegment2D>(rasterPoints.back(), MyPoint(5, -1)));
+	hits = findSelfIntersections(raster);
+	EXPECT_EQ(hits.size(), 399);
+	for (const IntersectionPoint& hit : hits) {
+		EXPECT_EQ(hit.second, raster.getSegmentCount() - 1);
+	}
+}
+
+/**
+ * @test	ContourIntersections
+ * @brief	Pairwise intersections, outline and overlap tests between contours match brute force.
+ */
+TEST(ContourTest, ContourIntersections) {
+
+	auto makeStar = [](double cx, double cy, int count) {
+		std::vector<MyPoint> points;
+		for (int i = 0; i < count; i++) {
+			double angle = 2 * M_PI * i / count;
+			double r = (i % 2 == 0) ? 1.0 : 0.8;
+			points.push_back(MyPoint(cx + r * std::cos(angle), cy + r * std::sin(angle)));
+		}
+		return polylineContourFromPoints(points, true);
+	};
+
+	//Overlapping stars: compare the tree traversal with all pairs
+	Contour2D first = makeStar(0, 0, 400);
+	Contour2D second = makeStar(0.9, 0.3, 360);
+	std::vector<IntersectionPoint> hits = intersections(first, second);
+	size_t expected = 0;
+	for (const auto& segA : first) {
+		for (const auto& segB : second) {
+			expected += intersectSegments(segA, segB, Contour2D::defaultEpsilon).count;
+		}
+	}
+	EXPECT_GT(expected, 0);
+	EXPECT_EQ(hits.size(), expected);
+	for (const auto& hit : hits) {
+		EXPECT_LT(closestPoint(first, hit.point).distance, 1e-9);
+		EXPECT_LT(second.getSegmentAt(hit.second).closestPoint(hit.point).distanceTo_2D(hit.point), 1e-9);
+	}
+	EXPECT_TRUE(outlinesIntersect(first, second));
+
+	//Circle made of two arcs against squares
+	Contour2D circle;
+	circle.addSegment(std::make_unique<ArcSegment2D>(MyPoint(0, 0), 1, 0, M_PI));
+	circle.addSegment(std::make_unique<ArcSegment2D>(MyPoint(0, 0), 1, M_PI, 2 * M_PI));
+	std::vector<MyPoint> crossingSquare = { MyPoint(0.5, -0.5), MyPoint(1.5, -0.5), MyPoint(1.5, 0.5), MyPoint(0.5, 0.5) };
+	std::vector<MyPoint> innerSquare = { MyPoint(-0.5, -0.5), MyPoint(0.5, -0.5), MyPoint(0.5, 0.5), MyPoint(-0.5, 0.5) };
+	std::vector<MyPoint> touchingSquare = { MyPoint(1, -1), MyPoint(2, -1), MyPoint(2, 1), MyPoint(1, 1) };
+	std::vector<MyPoint> farSquare = { MyPoint(5, 5), MyPoint(6, 5), MyPoint(6, 6), MyPoint(5, 6) };
+	hits = intersections(circle, polylineContourFromPoints(crossingSquare, true));
+	ASSERT_EQ(hits.size(), 2);
+	EXPECT_NEAR(hits[0].point.getX(), std::sqrt(0.75), 1e-12);
+	EXPECT_NEAR(std::abs(hits[0].point.getY()), 0.5, 1e-12);
+	EXPECT_FALSE(outlinesIntersect(circle, polylineContourFromPoints(innerSquare, true)));
+	EXPECT_TRUE(outlinesIntersect(circle, polylineContourFromPoints(touchingSquare, true)));
+	EXPECT_FALSE(outlinesIntersect(circle, polylineContourFromPoints(farSquare, true)));
+
+	//A part placed wholly inside another overlaps it, whichever is passed first
+	EXPECT_TRUE(overlaps(circle, polylineContourFromPoints(innerSquare, true)));
+	EXPECT_TRUE(overlaps(polylineContourFromPoints(innerSquare, true), circle));
+	EXPECT_TRUE(overlaps(circle, polylineContourFromPoints(touchingSquare, true)));
+	EXPECT_FALSE(overlaps(circle, polylineContourFromPoints(farSquare, true)));
+	EXPECT_FALSE(overlaps(circle, Contour2D()));
+	EXPECT_TRUE(intersections(circle, polylineContourFromPoints(farSquare, true)).empty());
+
+	//One part against many placed copies, with every tree built once
+	Contour2D part = makeStar(0, 0, 200);
+	SegmentTree2D partTree(part);
+	size_t overlapping = 0;
+	for (int i = 0; i < 20; i++) {
+		Contour2D placed(part);
+		placed.move(0.35 * i, 0.0);
+		SegmentTree2D placedTree(placed);
+		bool hit = outlinesIntersect(part, partTree, placed, placedTree);
+		EXPECT_EQ(hit, !intersections(part, placed).empty());
+		EXPECT_EQ(overlaps(part, partTree, placed, placedTree), hit);
+		overlapping += hit;
+	}
+	//Copies up to two radii away touch; the unshifted copy coincides completely
+	EXPECT_EQ(overlapping, 6);
+}
+
+/**
+ * @test	BooleanOperations
+ * @brief	Union, intersection, difference and xor of line/arc contours give the expected loops and areas.
+ */
+TEST(ContourTest, BooleanOperations) {
+
+	std::vector<MyPoint> squareA = { MyPoint(0, 0), MyPoint(2, 0), MyPoint(2, 2), MyPoint(0, 2) };
+	std::vector<MyPoint> squareB = { MyPoint(1, 1), MyPoint(3, 1), MyPoint(3, 3), MyPoint(1, 3) };
+	Contour2D a = polylineContourFromPoints(squareA, true);
+	Contour2D b = polylineContourFromPoints(squareB, true);
+	EXPECT_NEAR(totalArea(unionOf(a, b)), 7, 1e-9);
+	EXPECT_NEAR(totalArea(intersectionOf(a, b)), 1, 1e-9);
+	EXPECT_NEAR(totalArea(differenceOf(a, b)), 3, 1e-9);
+	EXPECT_NEAR(totalArea(xorOf(a, b)), 6, 1e-9);
+	ASSERT_EQ(unionOf(a, b).size(), 1);
+	EXPECT_TRUE(unionOf(a, b)[0].isValid());
+
+	//Orientation of the operands does not matter
+	Contour2D reversedB(b);
+	reversedB.reverse();
+	EXPECT_NEAR(totalArea(differenceOf(a, reversedB)), 3, 1e-9);
+
+	//Squares sharing an edge merge into one rectangle
+	std::vector<MyPoint> left = { MyPoint(0, 0), MyPoint(1, 0), MyPoint(1, 1), MyPoint(0, 1) };
+	std::vector<MyPoint> right = { MyPoint(1, 0), MyPoint(2, 0), MyPoint(2, 1), MyPoint(1, 1) };
+	std::vector<Contour2D> merged = unionOf(polylineContourFromPoints(left, true), polylineContourFromPoints(right, true));
+	ASSERT_EQ(merged.size(), 1);
+	EXPECT_NEAR(merged[0].signedArea(), 2, 1e-12);
+
+	//A nested square becomes a clockwise hole
+	std::vector<MyPoint> big = { MyPoint(-1, -1), MyPoint(4, -1), MyPoint(4, 4), MyPoint(-1, 4) };
+	std::vector<Contour2D> withHole = differenceOf(polylineContourFromPoints(big, true), a);
+	ASSERT_EQ(withHole.size(), 2);
+	EXPECT_NEAR(totalArea(withHole), 21, 1e-9);
+	EXPECT_EQ(intersectionOf(a, polylineContourFromPoints(big, true)).size(), 1);
+
+	//Arcs stay arcs: unit circle from two arcs against the square [0, 2]^2
+	Contour2D circle;
+	circle.addSegment(std::make_unique<ArcSegment2D>(MyPoint(0, 0), 1, 0, M_PI));
+	circle.addSegment(std::make_unique<ArcSegment2D>(MyPoint(0, 0), 1, M_PI, 2 * M_PI));
+	std::vector<Contour2D> quarter = intersectionOf(circle, a);
+	ASSERT_EQ(quarter.size(), 1);
+	EXPECT_NEAR(quarter[0].signedArea(), M_PI / 4, 1e-9);
+	EXPECT_EQ(quarter[0].getSegmentCount(), 3);
+	size_t arcs = 0;
+	for (const auto& seg : quarter[0]) {
+		arcs += seg.getKind() == SegmentKind::Arc;
+	}
+	EXPECT_EQ(arcs, 1);
+	EXPECT_NEAR(totalArea(unionOf(circle, a)), M_PI + 4 - M_PI / 4, 1e-9);
+	EXPECT_NEAR(totalArea(differenceOf(circle, a)), 3 * M_PI / 4, 1e-9);
+
+	//Star against a circle: compare with point classification on a grid
+	std::vector<MyPoint> starPoints;
+	for (int i = 0; i < 60; i++) {
+		double angle = 2 * M_PI * i / 60;
+		double r = (i % 2 == 0) ? 1.3 : 0.7;
+		starPoints.push_back(MyPoint(0.4 + r * std::cos(angle), 0.2 + r * std::sin(angle)));
+	}
+	Contour2D star = polylineContourFromPoints(starPoints, true);
+	for (BooleanOperation operation : { BooleanOperation::Union, BooleanOperation::Intersection, BooleanOperation::Difference, BooleanOperation::Xor }) {
+		std::vector<Contour2D> result = booleanOperation(star, circle, operation);
+		for (const auto& loop : result) {
+			EXPECT_TRUE(loop.isValid());
+		}
+		for (int i = 0; i < 40; i++) {
+			for (int j = 0; j < 40; j++) {
+				MyPoint p(-1.2 + i * 0.0731, -1.3 + j * 0.0677);
+				if (distanceTo(star, p) < 1e-6 || distanceTo(circle, p) < 1e-6) {
+					continue;
+				}
+				bool inStar = containsPoint(star, p);
+				bool inCircle = containsPoint(circle, p);
+				bool expected = operation == BooleanOperation::Union ? (inStar || inCircle)
+					: operation == BooleanOperation::Intersection ? (inStar && inCircle)
+					: operation == BooleanOperation::Difference ? (inStar && !inCircle)
+					: (inStar != inCircle);
+				int winding = 0;
+				for (const auto& loop : result) {
+					winding += windingNumber(loop, p);
+				}
+				ASSERT_EQ(winding != 0, expected) << static_cast<int>(operation) << " " << p.getX() << " " << p.getY();
+			}
+		}
+	}
+
+	EXPECT_THROW(unionOf(a, Contour2D()), std::invalid_argument);
+}
+
+/**
+ * @test	OffsetContours
+ * @brief	Inward and outward offsets keep arcs as arcs and match a pointwise distance check.
+ */
+TEST(ContourTest, OffsetContours) {
+
+	std::vector<MyPoint> squarePoints = { MyPoint(0, 0), MyPoint(2, 0), MyPoint(2, 2), MyPoint(0, 2) };
+	Contour2D square = polylineContourFromPoints(squarePoints, true);
+	std::vector<Contour2D> grown = offsetContour(square, 0.5);
+	ASSERT_EQ(grown.size(), 1);
+	EXPECT_EQ(grown[0].getSegmentCount(), 8);
+	EXPECT_NEAR(grown[0].signedArea(), 8 + M_PI / 4, 1e-9);
+	std::vector<Contour2D> shrunk = offsetContour(square, -0.5);
+	ASSERT_EQ(shrunk.size(), 1);
+	EXPECT_EQ(shrunk[0].getSegmentCount(), 4);
+	EXPECT_NEAR(shrunk[0].signedArea(), 1, 1e-9);
+	EXPECT_TRUE(offsetContour(square, -1.2).empty());
+
+	//Distances within epsilon keep the contour, oriented counter-clockwise
+	Contour2D clockwiseSquare(square);
+	clockwiseSquare.reverse();
+	for (double distance : { 0.0, 1e-6, -1e-6, 1e-8, -1e-10 }) {
+		std::vector<Contour2D> same = offsetContour(clockwiseSquare, distance);
+		ASSERT_EQ(same.size(), 1) << distance;
+		EXPECT_EQ(same[0].getSegmentCount(), 4);
+		EXPECT_NEAR(same[0].signedArea(), 4, 1e-9);
+	}
+	EXPECT_NEAR(totalArea(offsetContour(square, 2e-5)), 4 + 8 * 2e-5 + M_PI * 4e-10, 1e-12);
+	EXPECT_NEAR(totalArea(offsetContour(square, -2e-5)), 4 - 8 * 2e-5 + 4 * 4e-10, 1e-12);
+
+	//Arcs offset to concentric arcs, also from a clockwise contour
+	Contour2D circle;
+	circle.addSegment(std::make_unique<ArcSegment2D>(MyPoint(0, 0), 1, 0, M_PI));
+	circle.addSegment(std::make_unique<ArcSegment2D>(MyPoint(0, 0), 1, M_PI, 2 * M_PI));
+	Contour2D clockwiseCircle(circle);
+	clockwiseCircle.reverse();
+	grown = offsetContour(clockwiseCircle, 0.5);
+	ASSERT_EQ(grown.size(), 1);
+	EXPECT_EQ(grown[0].getSegmentCount(), 2);
+	EXPECT_EQ(grown[0].getSegmentAt(0).getKind(), SegmentKind::Arc);
+	EXPECT_NEAR(grown[0].signedArea(), 2.25 * M_PI, 1e-9);
+	EXPECT_NEAR(totalArea(offsetContour(circle, -0.5)), 0.25 * M_PI, 1e-9);
+	EXPECT_TRUE(offsetContour(circle, -1.5).empty());
+
+	//L shape: the inward offset gets a joining arc at the concave corner
+	std::vector<MyPoint> lPoints = { MyPoint(0, 0), MyPoint(2, 0), MyPoint(2, 1), MyPoint(1, 1), MyPoint(1, 2), MyPoint(0, 2) };
+	Contour2D lShape = polylineContourFromPoints(lPoints, true);
+	EXPECT_NEAR(totalArea(offsetContour(lShape, -0.25)), 1.25 + 0.0625 * (1 - M_PI / 4), 1e-9);
+	EXPECT_NEAR(totalArea(offsetContour(lShape, 0.25)), 3 + 8 * 0.25 + 5 * M_PI / 4 * 0.0625 - 0.0625, 1e-9);
+
+	//U shape with a slot of width 1 and a pac-man with a concave arc joint
+	std::vector<MyPoint> uPoints = { MyPoint(0, 0), MyPoint(3, 0), MyPoint(3, 3), MyPoint(2, 3), MyPoint(2, 1), MyPoint(1, 1), MyPoint(1, 3), MyPoint(0, 3) };
+	Contour2D uShape = polylineContourFromPoints(uPoints, true);
+	Contour2D pacman = makePacman();
+
+	//The offset region is every point within the distance of the region, or at least that deep inside it
+	for (const Contour2D* contour : { &square, &circle, &lShape, &uShape, &pacman }) {
+		for (double distance : { 0.3, 0.6, -0.2, -0.4 }) {
+			std::vector<Contour2D> result = offsetContour(*contour, distance);
+			for (const auto& loop : result) {
+				EXPECT_TRUE(loop.isValid());
+				EXPECT_TRUE(isSimple(loop));
+			}
+			BoundingBox2D box = contour->boundingBox().inflated(1);
+			for (int i = 0; i < 30; i++) {
+				for (int j = 0; j < 30; j++) {
+					MyPoint p(box.getMinX() + (i + 0.37) * box.getWidth() / 30, box.getMinY() + (j + 0.61) * box.getHeight() / 30);
+					double gap = distanceTo(*contour, p);
+					if (std::abs(gap - std::abs(distance)) < 1e-6) {
+						continue;
+					}
+					bool inside = containsPoint(*contour, p);
+					bool expected = distance > 0 ? (inside || gap < distance) : (inside && gap > -distance);
+					int winding = 0;
+					for (const auto& loop : result) {
+						winding += windingNumber(loop, p);
+					}
+					ASSERT_EQ(winding != 0, expected) << distance << " " << p.getX() << " " << p.getY();
+				}
+			}
+		}
+	}
+
+	EXPECT_THROW(offsetContour(Contour2D(), 1), std::invalid_argument);
+}
+
+/**
+ * @test	PocketLevels
+ * @brief	Pocket passes match single offsets of the boundary, split and merge around islands, and honour the limits.
+ */
+TEST(ContourTest, PocketLevels) {
+
+	std::vector<MyPoint> squarePoints = { MyPoint(0, 0), MyPoint(10, 0), MyPoint(10, 10), MyPoint(0, 10) };
+	Contour2D square = polylineContourFromPoints(squarePoints, true);
+	std::vector<PocketLevel> levels = PocketGenerator(square, 0.5, 1).generateAll();
+	ASSERT_EQ(levels.size(), 5);
+	for (const auto& level : levels) {
+		ASSERT_EQ(level.loops.size(), 1);
+		EXPECT_NEAR(level.distance, 0.5 + level.index, 1e-12);
+		EXPECT_NEAR(level.loops[0].signedArea(), (10 - 2 * level.distance) * (10 - 2 * level.distance), 1e-9);
+	}
+
+	//Dumbbell: the corridor of width 1 closes after the first pass, leaving two separate areas
+	std::vector<MyPoint> dumbbellPoints = { MyPoint(0, 0), MyPoint(4, 0), MyPoint(4, 1.5), MyPoint(6, 1.5), MyPoint(6, 0), MyPoint(10, 0),
+		MyPoint(10, 4), MyPoint(6, 4), MyPoint(6, 2.5), MyPoint(4, 2.5), MyPoint(4, 4), MyPoint(0, 4) };
+	Contour2D dumbbell = polylineContourFromPoints(dumbbellPoints, true);
+	dumbbell.reverse();
+	PocketGenerator pocket(dumbbell, 0.25, 0.5, 10000, ParallelExecutor(3));
+	std::vector<size_t> loopCounts;
+	size_t passes = pocket.forEachLevel([&](const PocketLevel& level) {
+		loopCounts.push_back(level.loops.size());
+		//Every pass matches a single offset of the boundary by its total distance
+		EXPECT_NEAR(totalArea(level.loops), totalArea(offsetContour(dumbbell, -level.distance)), 1e-9);
+		for (size_t i = 0; i < level.loops.size(); i++) {
+			EXPECT_EQ(level.loops[i].orientation(), Orientation::CounterClockwise);
+			EXPECT_EQ(level.parents[i], level.index <= 1 ? 0 : i);
+		}
+		return true;
+	});
+	EXPECT_EQ(passes, 4);
+	EXPECT_EQ(loopCounts, std::vector<size_t>({ 1, 2, 2, 2 }));
+
+	//The callback can stop early, and the pass limit is respected
+	EXPECT_EQ(pocket.forEachLevel([](const PocketLevel& level) { return level.index < 1; }), 2);
+	EXPECT_EQ(PocketGenerator(square, 0, 1, 3).generateAll().size(), 3);
+
+	EXPECT_THROW(PocketGenerator(square, 0.5, 0), std::invalid_argument);
+	EXPECT_THROW(PocketGenerator(Contour2D(), 0.5, 1), std::invalid_argument);
+
+	//Island in the middle of a 20 x 20 pocket: it grows by each pass until it meets the shrinking boundary
+	std::vector<MyPoint> outerPoints = { MyPoint(0, 0), MyPoint(20, 0), MyPoint(20, 20), MyPoint(0, 20) };
+	std::vector<MyPoint> islandPoints = { MyPoint(8, 8), MyPoint(8, 12), MyPoint(12, 12), MyPoint(12, 8) };
+	Contour2D outer = polylineContourFromPoints(outerPoints, true);
+	Contour2D island = polylineContourFromPoints(islandPoints, true);
+	std::vector<PocketLevel> islandLevels = PocketGenerator(outer, { island }, 0.5, 1, 10000, ParallelExecutor(3)).generateAll();
+	ASSERT_EQ(islandLevels.size(), 5);
+	for (const auto& level : islandLevels) {
+		double d = level.distance;
+		if (level.index < 4) {
+			//One loop around the pocket area and one clockwise loop around the grown island
+			ASSERT_EQ(level.loops.size(), 2);
+			EXPECT_NEAR(totalArea(level.loops), (20 - 2 * d) * (20 - 2 * d) - (16 + 16 * d + M_PI * d * d), 1e-9);
+			size_t hole = level.loops[0].orientation() == Orientation::Clockwise ? 0 : 1;
+			EXPECT_EQ(level.loops[hole].orientation(), Orientation::Clockwise);
+			EXPECT_NEAR(-level.loops[hole].signedArea(), 16 + 16 * d + M_PI * d * d, 1e-9);
+			EXPECT_EQ(level.parents[hole], level.index == 0 ? 1 : hole);
+		}
+		else {
+			//The island has met the boundary, leaving only the four corners
+			ASSERT_EQ(level.loops.size(), 4);
+			for (const auto& loop : level.loops) {
+				EXPECT_TRUE(loop.isValid());
+				EXPECT_EQ(loop.orientation(), Orientation::CounterClockwise);
+				EXPECT_TRUE(BoundingBox2D(MyPoint(d, d), MyPoint(20 - d, 20 - d)).inflated(1e-9).contains(loop.boundingBox()));
+				EXPECT_GT(distanceTo(island, loop.getSegmentAt(0).getPointA()), d - 1e-9);
+			}
+		}
+	}
+
+	//Two islands 2 apart: their offsets merge in the second pass, which only intersects pairs the first pass found close
+	std::vector<MyPoint> leftPoints = { MyPoint(5, 8), MyPoint(9, 8), MyPoint(9, 12), MyPoint(5, 12) };
+	std::vector<MyPoint> rightPoints = { MyPoint(11, 8), MyPoint(15, 8), MyPoint(15, 12), MyPoint(11, 12) };
+	Contour2D left = polylineContourFromPoints(leftPoints, true);
+	Contour2D right = polylineContourFromPoints(rightPoints, true);
+	std::vector<size_t> twinCounts;
+	PocketGenerator(outer, { left, right }, 0.25, 1, 10000, ParallelExecutor(3)).forEachLevel([&](const PocketLevel& level) {
+		double d = level.distance;
+		twinCounts.push_back(level.loops.size());
+		if (level.index < 3) {
+			std::vector<Contour2D> grown = booleanOperation(offsetContour(left, d)[0], offsetContour(right, d)[0], BooleanOperation::Union);
+			EXPECT_NEAR(totalArea(level.loops), (20 - 2 * d) * (20 - 2 * d) - totalArea(grown), 1e-9);
+		}
+		for (const auto& loop : level.loops) {
+			EXPECT_TRUE(loop.isValid());
+			EXPECT_GT(distanceTo(left, loop.getSegmentAt(0).getPointA()), d - 1e-9);
+			EXPECT_GT(distanceTo(right, loop.getSegmentAt(0).getPointA()), d - 1e-9);
+		}
+		return true;
+	});
+	EXPECT_EQ(twinCounts, std::vector<size_t>({ 3, 2, 2, 2 }));
+
+	//Islands must lie inside the boundary and apart from each other
+	std::vector<MyPoint> crossingPoints = { MyPoint(18, 8), MyPoint(22, 8), MyPoint(22, 12), MyPoint(18, 12) };
+	std::vector<MyPoint> nestedPoints = { MyPoint(9, 9), MyPoint(11, 9), MyPoint(11, 11), MyPoint(9, 11) };
+	EXPECT_THROW(PocketGenerator(outer, { polylineContourFromPoints(crossingPoints, true) }, 0.5, 1), std::invalid_argument);
+	EXPECT_THROW(PocketGenerator(square, { island }, 0.5, 1), std::invalid_argument);
+	EXPECT_THROW(PocketGenerator(outer, { island, polylineContourFromPoints(nestedPoints, true) }, 0.5, 1), std::invalid_argument);
+}
+
+/**
+ * @test	Tessellation
+ * @brief	Flattened arcs stay within the chord tolerance and the polyline keeps the contour's shape.
+ */
+TEST(ContourTest, Tessellation) {
+
+	EXPECT_EQ(arcChordCount(1, M_PI / 2, 1), 1);
+	EXPECT_EQ(arcChordCount(1, 2 * M_PI, 1), 2);
+	EXPECT_EQ(arcChordCount(1, M_PI / 2, 1 - std::cos(M_PI / 8)), 2);
+
+	//Pac-man traversed both ways, with enough chords to cross several recurrence restarts
+	Contour2D pacman;
+	pacman.addSegment(std::make_unique<ArcSegment2D>(MyPoint(0, 0), 100, M_PI / 4, 7 * M_PI / 4));
+	pacman.addSegment(std::make_unique<LineSegment2D>(pacman.getSegmentAt(0).getPointB(), MyPoint(0, 0)));
+	pacman.addSegment(std::make_unique<LineSegment2D>(MyPoint(0, 0), pacman.getSegmentAt(0).getPointA()));
+	Contour2D reversed(pacman);
+	reversed.reverse();
+	const double tolerance = 1e-3;
+	const size_t chords = arcChordCount(100, 1.5 * M_PI, tolerance);
+	EXPECT_GT(chords, 200);
+
+	for (const Contour2D* contour : { &pacman, &reversed }) {
+		std::vector<MyPoint> points = tessellate(*contour, tolerance);
+		ASSERT_EQ(points.size(), chords + 3);
+		EXPECT_EQ(points.front().getX(), points.back().getX());
+		EXPECT_EQ(points.front().getY(), points.back().getY());
+		double worst = 0;
+		for (size_t i = 0; i < points.size(); i++) {
+			const double r = std::hypot(points[i].getX(), points[i].getY());
+			if (r > 1) {
+				EXPECT_NEAR(r, 100, 1e-9);
+			}
+			if (i > 0 && r > 1 && std::hypot(points[i - 1].getX(), points[i - 1].getY()) > 1) {
+				const double mx = 0.5 * (points[i].getX() + points[i - 1].getX());
+				const double my = 0.5 * (points[i].getY() + points[i - 1].getY());
+				worst = std::max(worst, 100 - std::hypot(mx, my));
+			}
+		}
+		EXPECT_LE(worst, tolerance);
+		EXPECT_GT(worst, 0.5 * tolerance);
+
+		FlatContour2D flat = tessellateToFlatContour(*contour, tolerance);
+		EXPECT_EQ(flat.getSegmentCount(), points.size() - 1);
+		EXPECT_TRUE(flat.isClosedShape());
+		Contour2D polyline = flat.toContour2D();
+		//Each chord cuts off less than its length times the tolerance
+		EXPECT_NEAR(polyline.signedArea(), contour->signedArea(), 150 * M_PI * tolerance);
+	}
+
+	//Caller buffers must hold tessellatedPointCount() points
+	std::vector<double> xs(chords + 2), ys(chords + 2);
+	EXPECT_EQ(tessellatedPointCount(pacman, tolerance), chords + 3);
+	EXPECT_THROW(tessellate(pacman, tolerance, xs.data(), ys.data(), xs.size()), std::length_error);
+	EXPECT_THROW(tessellate(pacman, 0, xs.data(), ys.data(), xs.size()), std::invalid_argument);
+	EXPECT_EQ(tessellatedPointCount(Contour2D(), tolerance), 0);
+}
+
+/**
+ * @test	PolylineSimplification
+ * @brief	Simplified polylines stay within tolerance, keep closure and do not depend on the thread count.
+ */
+TEST(ContourTest, PolylineSimplification) {
+
+	auto segmentDistance = [](const MyPoint& p, const MyPoint& a, const MyPoint& b) {
+		const double dx = b.getX() - a.getX(), dy = b.getY() - a.getY();
+		double t = ((p.getX() - a.getX()) * dx + (p.getY() - a.getY()) * dy) / (dx * dx + dy * dy);
+		t = std::max(0.0, std::min(1.0, t));
+		return std::hypot(p.getX() - a.getX() - t * dx, p.getY() - a.getY() - t * dy);
+	};
+	//Largest distance of an input point to the kept polyline, which is a subsequence of the input
+	auto deviation = [&](const std::vector<MyPoint>& input, const std::vector<MyPoint>& kept) {
+		std::vector<MyPoint> ring(kept);
+		ring.push_back(kept.front());
+		size_t k = 0;
+		double worst = 0;
+		for (const auto& p : input) {
+			if (p.getX() == ring[k + 1].getX() && p.getY() == ring[k + 1].getY()) {
+				k++;
+			}
+			worst = std::max(worst, segmentDistance(p, ring[k], ring[k + 1]));
+		}
+		return worst;
+	};
+
+	//Noisy circle, large enough for the parallel search and for several Visvalingam-Whyatt blocks
+	std::vector<MyPoint> noisy;
+	const size_t count = 200000;
+	for (size_t i = 0; i < count; i++) {
+		const double angle = 2 * M_PI * i / count;
+		const double r = 10 + 1e-4 * std::sin(7.0 * i);
+		noisy.push_back(MyPoint(r * std::cos(angle), r * std::sin(angle)));
+	}
+	const double tolerance = 1e-3;
+	std::vector<MyPoint> serial = simplifyPolyline(noisy, tolerance, true, SimplificationMethod::DouglasPeucker, ParallelExecutor(1));
+	std::vector<MyPoint> parallel = simplifyPolyline(noisy, tolerance, true, SimplificationMethod::DouglasPeucker, ParallelExecutor(4));
+	ASSERT_EQ(serial.size(), parallel.size());
+	for (size_t i = 0; i < serial.size(); i++) {
+		EXPECT_EQ(serial[i].getX(), parallel[i].getX());
+		EXPECT_EQ(serial[i].getY(), parallel[i].getY());
+	}
+	EXPECT_LT(serial.size(), count / 100);
+	EXPECT_EQ(serial.front().getX(), noisy.front().getX());
+	EXPECT_LE(deviation(noisy, serial), tolerance);
+
+	std::vector<MyPoint> vw = simplifyPolyline(noisy, tolerance, true, SimplificationMethod::VisvalingamWhyatt, ParallelExecutor(4));
+	EXPECT_LT(vw.size(), count / 50);
+	EXPECT_EQ(vw.front().getX(), noisy.front().getX());
+	EXPECT_LE(deviation(noisy, vw), 3 * tolerance);
+
+	//A closed sliver keeps a triangle; an open run collapses to its ends
+	std::vector<MyPoint> sliver = { MyPoint(0, 0), MyPoint(1, 1e-4), MyPoint(2, 0), MyPoint(1, -1e-4) };
+	std::vector<MyPoint> run = { MyPoint(0, 0), MyPoint(1, 1e-4), MyPoint(2, 0), MyPoint(3, -1e-4) };
+	for (SimplificationMethod method : { SimplificationMethod::DouglasPeucker, SimplificationMethod::VisvalingamWhyatt }) {
+		EXPECT_EQ(simplifyPolyline(sliver, 0.1, true, method).size(), 3);
+		EXPECT_EQ(simplifyPolyline(run, 0.1, false, method).size(), 2);
+	}
+
+	//Line runs are simplified between arcs, which are kept as they are
+	std::vector<MyPoint> zigzag;
+	for (int i = 0; i <= 100; i++) {
+		zigzag.push_back(MyPoint(0.04 * i, (i % 2) * 1e-5));
+	}
+	Contour2D slot = polylineContourFromPoints(zigzag, false);
+	slot.addSegment(std::make_unique<ArcSegment2D>(MyPoint(4, 1), 1, -M_PI / 2, M_PI / 2));
+	slot.addSegment(std::make_unique<LineSegment2D>(MyPoint(4, 2), MyPoint(0, 2)));
+	slot.addSegment(std::make_unique<ArcSegment2D>(MyPoint(0, 1), 1, M_PI / 2, 3 * M_PI / 2));
+	std::vector<Contour2D> contours = { slot, polylineContourFromPoints(noisy, true) };
+	std::vector<Contour2D> simplified = simplifyContours(contours, tolerance, SimplificationMethod::DouglasPeucker, ParallelExecutor(2));
+	ASSERT_EQ(simplified.size(), 2);
+	EXPECT_EQ(simplified[0].getSegmentCount(), 4);
+	EXPECT_EQ(simplified[0].getSegmentAt(1).getKind(), SegmentKind::Arc);
+	EXPECT_TRUE(simplified[0].isClosedShape());
+	EXPECT_NEAR(simplified[0].signedArea(), slot.signedArea(), 1e-3);
+	EXPECT_EQ(simplified[1].getSegmentCount(), serial.size());
+	EXPECT_TRUE(simplified[1].isClosedShape());
+
+	EXPECT_THROW(simplifyPolyline(sliver, -1, true), std::invalid_argument);
+}
+
+/**
+ * @test	ArcFitting
+ * @brief	Dense points compress into few tangent-continuous lines and arcs that stay within tolerance.
+ */
+TEST(ContourTest, ArcFitting) {
+
+	//Unit tangent at the start or end of a segment
+	auto tangent = [](const Segment2D& seg, bool atEnd) {
+		const MyPoint& p = atEnd ? seg.getPointB() : seg.getPointA();
+		if (seg.getKind() == SegmentKind::Line) {
+			const double length = seg.getPointA().distanceTo_2D(seg.getPointB());
+			return MyPoint((seg.getPointB().getX() - seg.getPointA().getX()) / length, (seg.getPointB().getY() - seg.getPointA().getY()) / length);
+		}
+		const ArcSegment2D& arc = static_cast<const ArcSegment2D&>(seg);
+		const double ux = (p.getX() - arc.getCenter().getX()) / arc.getRadius();
+		const double uy = (p.getY() - arc.getCenter().getY()) / arc.getRadius();
+		return arc.isCounterClockwise() ? MyPoint(-uy, ux) : MyPoint(uy, -ux);
+	};
+	auto checkFit = [&](const std::vector<MyPoint>& points, const Contour2D& fitted, double tolerance, bool closed) {
+		ASSERT_GT(fitted.getSegmentCount(), 0);
+		EXPECT_TRUE(fitted.isValid());
+		for (const auto& p : points) {
+			EXPECT_LE(distanceTo(fitted, p), tolerance + 1e-9);
+		}
+		for (size_t i = 0; i + 1 < fitted.getSegmentCount(); i++) {
+			const MyPoint t1 = tangent(fitted.getSegmentAt(i), true);
+			const MyPoint t2 = tangent(fitted.getSegmentAt(i + 1), false);
+			EXPECT_GT(t1.getX() * t2.getX() + t1.getY() * t2.getY(), 1 - 1e-9);
+		}
+		const MyPoint& end = fitted.getSegmentAt(fitted.getSegmentCount() - 1).getPointB();
+		const MyPoint& expected = closed ? points.front() : points.back();
+		EXPECT_EQ(fitted.getSegmentAt(0).getPointA().getX(), points.front().getX());
+		EXPECT_EQ(end.getX(), expected.getX());
+		EXPECT_EQ(end.getY(), expected.getY());
+	};
+	const double tolerance = 1e-3;
+
+	//Slot: two lines joined by half circles, with noise well below the tolerance
+	std::vector<MyPoint> slot;
+	for (int i = 0; i < 400; i++) {
+		slot.push_back(MyPoint(0.01 * i, 0));
+	}
+	for (int i = 0; i < 400; i++) {
+		slot.push_back(MyPoint(4 + std::sin(M_PI * i / 400), 1 - std::cos(M_PI * i / 400)));
+	}
+	for (int i = 0; i < 400; i++) {
+		slot.push_back(MyPoint(4 - 0.01 * i, 2));
+	}
+	for (int i = 0; i < 400; i++) {
+		slot.push_back(MyPoint(-std::sin(M_PI * i / 400), 1 + std::cos(M_PI * i / 400)));
+	}
+	for (size_t i = 0; i < slot.size(); i++) {
+		slot[i] = MyPoint(slot[i].getX() + 1e-5 * std::sin(7.0 * i), slot[i].getY() + 1e-5 * std::cos(5.0 * i));
+	}
+	Contour2D fittedSlot = fitArcs(slot, tolerance, true);
+	checkFit(slot, fittedSlot, tolerance, true);
+	EXPECT_LE(fittedSlot.getSegmentCount(), 16);
+	EXPECT_TRUE(fittedSlot.isClosedShape());
+	EXPECT_NEAR(fittedSlot.signedArea(), 8 + M_PI, 0.02);
+
+	//Open sine wave: only arcs and lines, at least ten times fewer segments
+	std::vector<MyPoint> wave;
+	for (int i = 0; i <= 4000; i++) {
+		const double x = 4 * M_PI * i / 4000;
+		wave.push_back(MyPoint(x, 0.5 * std::sin(x)));
+	}
+	Contour2D fittedWave = fitArcs(wave, tolerance);
+	checkFit(wave, fittedWave, tolerance, false);
+	EXPECT_LE(fittedWave.getSegmentCount(), wave.size() / 10);
+
+	//Sharp corners become corners; straight sides become single lines
+	std::vector<MyPoint> square;
+	for (int side = 0; side < 4; side++) {
+		for (int i = 0; i < 100; i++) {
+			const double t = 0.01 * i;
+			const MyPoint corners[] = { MyPoint(t, 0), MyPoint(1, t), MyPoint(1 - t, 1), MyPoint(0, 1 - t) };
+			square.push_back(corners[side]);
+		}
+	}
+	Contour2D fittedSquare = fitArcs(square, tolerance, true);
+	EXPECT_EQ(fittedSquare.getSegmentCount(), 4);
+	EXPECT_TRUE(fittedSquare.isClosedShape());
+	EXPECT_NEAR(fittedSquare.signedArea(), 1, 1e-9);
+
+	EXPECT_EQ(fitArcs(std::vector<MyPoint>(1, MyPoint(1, 1)), tolerance).getSegmentCount(), 0);
+	EXPECT_THROW(fitArcs(wave, 0), std::invalid_argument);
+}